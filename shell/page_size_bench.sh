@@ -0,0 +1,14 @@
+#!/bin/bash
+# 分别以4/8/16/32KB页面大小编译并运行page_size_bench，对比同一负载下的性能
+# 用法：在仓库根目录执行 bash shell/page_size_bench.sh [额外的cmake参数]
+set -e
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_ROOT=${BUILD_ROOT:-/tmp/rmdb_page_size_bench}
+for page_size in 4096 8192 16384 32768; do
+    build_dir="$BUILD_ROOT/page_${page_size}"
+    cmake -S "$ROOT" -B "$build_dir" -DRMDB_PAGE_SIZE=${page_size} "$@" > /dev/null 2>&1
+    cmake --build "$build_dir" --target page_size_bench -j"$(nproc)" > /dev/null 2>&1
+    # 只在第一轮输出表头
+    lines=$([ "$page_size" = 4096 ] && echo 2 || echo 1)
+    (cd "$build_dir" && ./bin/page_size_bench | grep -A1 "recs/page" | tail -n "$lines")
+done
@@ -33,14 +33,41 @@ static constexpr int INVALID_TXN_ID = -1;     // invalid transaction id
 static constexpr int INVALID_TIMESTAMP = -1;  // invalid transaction timestamp
 static constexpr int INVALID_LSN = -1;        // invalid log sequence number
 static constexpr int HEADER_PAGE_ID = 0;      // the header page id
-static constexpr int PAGE_SIZE = 4096;        // size of a data page in byte  4KB
-// static constexpr int BUFFER_POOL_SIZE = 131072;  // size of buffer pool 256MB
-static constexpr int BUFFER_POOL_SIZE = 1048576;  // size of buffer pool 1GB
-// static constexpr int BUFFER_POOL_SIZE = 32;  // size of buffer pool 512MB
 
-static constexpr int JOIN_BUFFER_SIZE = 32768;  // size of join buffer 4*32MB
-// static constexpr int BUFFER_POOL_SIZE = 262144;                                // size of buffer pool 1GB
+// 页面大小在编译期确定，由CMake选项RMDB_PAGE_SIZE指定，默认4KB。记录、索引和日志的布局都由PAGE_SIZE推导，
+// 修改页面大小后已有的数据库文件不再兼容
+#ifndef RMDB_PAGE_SIZE
+#define RMDB_PAGE_SIZE 4096
+#endif
+static constexpr int PAGE_SIZE = RMDB_PAGE_SIZE;  // size of a data page in byte
+static_assert(PAGE_SIZE >= 4096 && PAGE_SIZE <= 32768 && (PAGE_SIZE & (PAGE_SIZE - 1)) == 0,
+              "PAGE_SIZE must be a power of two between 4KB and 32KB");
+
+// 缓冲池和join buffer按字节数配置，帧数随页面大小变化，保证不同页面大小下内存占用相同
+static constexpr size_t BUFFER_POOL_BYTES = 4ul << 30;      // size of buffer pool in byte 4GB
+static constexpr int BUFFER_POOL_SIZE = BUFFER_POOL_BYTES / PAGE_SIZE;  // 4KB页面时为1048576帧
+static constexpr size_t JOIN_BUFFER_BYTES = 128ul << 20;    // size of join buffer in byte 128MB
+static constexpr int JOIN_BUFFER_SIZE = JOIN_BUFFER_BYTES / PAGE_SIZE;  // 4KB页面时为32768页
 static constexpr int LOG_BUFFER_SIZE = (1024 * PAGE_SIZE);  // size of a log buffer in byte
+static constexpr int BUFFER_POOL_SHARDS = 16;               // 缓冲池的分区个数，每个分区有独立的latch
+static constexpr bool BUFFER_POOL_HUGE_PAGES = true;         // 帧数据尽量使用2MB大页，不可用时退化为普通页面
+static const std::string BUFFER_POOL_NUMA_POLICY = "INTERLEAVE";  // 多路服务器上帧内存的分配策略，可选NONE、INTERLEAVE、SHARD_LOCAL
+static constexpr int MIN_SHARD_FRAMES = 1024;               // 每个分区至少包含的帧数，帧数较少的缓冲池不分区
+static constexpr int SHARD_RUN_PAGES = 16;                  // 页面号连续的SHARD_RUN_PAGES个页面属于同一个分区
+static constexpr int IO_QUEUE_DEPTH = 64;                   // 异步I/O队列深度，即一次最多在途的页面读写个数
+static constexpr int SCAN_PREFETCH_PAGES = 32;              // 顺序扫描时每批预取的页面个数
+static constexpr int READAHEAD_MIN_PAGES = 16;              // 顺序预读的初始窗口，之后逐次翻倍
+static constexpr int READAHEAD_MAX_PAGES = 256;             // 顺序预读的最大窗口
+static constexpr int SCAN_RING_PAGES = 64;                  // 大范围顺序扫描在每个分区中循环使用的帧数，不小于预取批次
+static constexpr int BULK_WRITE_RING_PAGES = 256;           // 批量导入在每个分区中循环使用的帧数，帧被复用前要写回
+static constexpr int BULK_INSERT_BATCH_ROWS = 4096;         // 批量导入、恢复重做时每次批量追加到表中的记录条数
+static constexpr int SCAN_RING_MIN_FRACTION = 4;            // 表的页面数超过缓冲池帧数的1/4时扫描才使用环形帧
+static constexpr int MAX_READ_RUN_PAGES = 64;               // 一次向量读最多包含的连续页面个数，即256KB
+static constexpr int MAX_WRITE_RUN_PAGES = 64;              // 刷脏页时一次向量写最多包含的连续页面个数
+static constexpr int BG_WRITER_INTERVAL_MS = 100;           // 后台写线程两轮清理之间的间隔
+static constexpr int BG_WRITER_SCAN_DEPTH = 1024;           // 后台写线程每轮检查replacer中最先被淘汰的帧数
+static constexpr int BG_WRITER_MAX_PAGES = 256;             // 后台写线程每轮最多写回的页面个数，0表示关闭后台写线程
+static constexpr int FILE_EXTENT_SIZE = (1 << 20);          // 表/索引文件每次用fallocate扩展的大小，默认1MB，0表示不预分配
 static constexpr int BUCKET_SIZE = 50;                      // size of extendible hash bucket
 static constexpr bool use_naive_blockjoin = true;
 
@@ -55,7 +82,22 @@ using timestamp_t = int32_t;  // timestamp type, used for transaction concurrenc
 // log file
 static const std::string LOG_FILE_NAME = "db.log";
 
-// replacer
+// replacer，可选LRU、LRU-K、2Q、CLOCK
 static const std::string REPLACER_TYPE = "LRU";
+static constexpr int LRU_K = 2;                 // LRU-K使用倒数第几次访问决定淘汰顺序
+static constexpr double TWO_Q_A1_RATIO = 0.25;  // 2Q中只被访问过一次的页面最多占用的帧比例
+static constexpr int VICTIM_SCAN_BATCH = 8;     // 寻找可淘汰帧时每次从replacer中取出的候选帧数
 
 static const std::string DB_META_NAME = "db.meta";
+
+// 缓冲池的热页面列表，关闭数据库时和每隔HOT_PAGE_SAVE_INTERVAL_S秒保存一次，启动时按列表把页面预读回缓冲池
+static const std::string HOT_PAGE_FILE_NAME = "db.hot";
+static constexpr int HOT_PAGE_SAVE_INTERVAL_S = 300;
+static constexpr int WARM_RESTART_MAX_GAP = 8;  // 预读热页面时间隔不超过该值的页面合并为一次顺序读，中间的页面一并读入
+
+// 空闲页面表文件名为表/索引文件名加此后缀
+static const std::string FREE_PAGE_FILE_SUFFIX = ".free";
+
+// 压缩表的页面映射文件名为表文件名加此后缀，该文件存在即表示表文件按页压缩存储
+static const std::string COMPRESSED_MAP_SUFFIX = ".cmap";
+static constexpr int COMPRESS_UNIT_SIZE = 512;  // 压缩后的页面在文件中以512字节为单位分配空间
@@ -59,6 +59,11 @@ class FileNotFoundError : public RMDBError {
     FileNotFoundError(const std::string &filename) : RMDBError("File not found: " + filename) {}
 };
 
+class FileFormatError : public RMDBError {
+   public:
+    FileFormatError(const std::string &filename) : RMDBError("Unsupported file format: " + filename) {}
+};
+
 // RM errors
 class RecordNotFoundError : public RMDBError {
    public:
@@ -56,7 +56,7 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context) {
     if (auto x = std::dynamic_pointer_cast<DDLPlan>(plan)) {
         switch (x->tag) {
             case T_CreateTable: {
-                sm_manager_->create_table(x->tab_name_, x->cols_, context);
+                sm_manager_->create_table(x->tab_name_, x->cols_, context, x->compressed_);
                 break;
             }
             case T_DropTable: {
@@ -132,7 +132,8 @@ void QlManager::run_load_data(std::shared_ptr<Plan> plan, Context *context) {
         TabMeta &tab_ = sm_manager_->db_.get_table(x->tab_name_);
         RmFileHandle *fh_ = sm_manager_->fhs_.at(x->tab_name_).get();
         Context *context_ = context;
-        Rid rid_;
+        // 新页面在环形帧中循环使用，导入大文件时不冲掉缓冲池中的其他页面
+        auto strategy = fh_->create_bulk_write_strategy();
         // 不知道需不需要加锁也不知道要不要加锁，先注释掉得了
         //  context_->lock_mgr_->lock_IX_on_table(context_->txn_, fh_->GetFd());
 
@@ -140,6 +141,40 @@ void QlManager::run_load_data(std::shared_ptr<Plan> plan, Context *context) {
         std::vector<int> len_list;
         std::vector<int> offset_list;
 
+        // 解析出的记录先放在batch中，攒满BULK_INSERT_BATCH_ROWS条后一次追加到表中
+        int record_size = fh_->get_file_hdr().record_size;
+        std::vector<char> batch(static_cast<size_t>(BULK_INSERT_BATCH_ROWS) * record_size);
+        int batch_rows = 0;
+        auto flush_batch = [&]() {
+            auto rids = fh_->insert_records(batch.data(), batch_rows, context_, strategy.get());
+            // 索引，从insert复制过来的
+            for (int row = 0; row < batch_rows; row++) {
+                const char *rec = batch.data() + static_cast<size_t>(row) * record_size;
+                for (size_t i = 0; i < tab_.indexes.size(); ++i) {
+                    auto &index = tab_.indexes[i];
+                    auto ih =
+                        sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(x->tab_name_, index.cols))
+                            .get();
+                    char *key = new char[index.col_total_len];
+                    int offset = 0;
+                    for (int j = 0; j < index.col_num; j++) {
+                        memcpy(key + offset, rec + index.cols[j].offset, index.cols[j].len);
+                        offset += index.cols[j].len;
+                    }
+                    bool is_insert = ih->insert_entry(key, rids[row], context_->txn_);
+                    delete[] key;
+                    if (!is_insert) {
+                        // 本批中这条及之后的记录还没有插入索引，从表中删除
+                        for (int k = row; k < batch_rows; k++) {
+                            fh_->delete_record(rids[k], context_);
+                        }
+                        throw IndexEntryRepeatError();
+                    }
+                }
+            }
+            batch_rows = 0;
+        };
+
         // 打开csv文件
         std::ifstream inFile(x->file_name_);
 
@@ -176,7 +211,7 @@ void QlManager::run_load_data(std::shared_ptr<Plan> plan, Context *context) {
                 }
                 continue;
             } else {
-                RmRecord rec(fh_->get_file_hdr().record_size);
+                char *rec = batch.data() + static_cast<size_t>(batch_rows) * record_size;
                 for (size_t i = 0; i < tab_.cols.size(); i++) {
                     Value value;
                     if (type_list[i] == TYPE_INT) {
@@ -200,31 +235,14 @@ void QlManager::run_load_data(std::shared_ptr<Plan> plan, Context *context) {
                         value.set_str(lineArray[i]);
                     }
                     value.init_raw(len_list[i]);
-                    memcpy(rec.data + offset_list[i], value.raw->data, len_list[i]);
+                    memcpy(rec + offset_list[i], value.raw->data, len_list[i]);
                 }
-                rid_ = fh_->insert_record(rec.data, context_);
-
-                // 索引，从insert复制过来的
-                for (size_t i = 0; i < tab_.indexes.size(); ++i) {
-                    auto &index = tab_.indexes[i];
-                    auto ih =
-                        sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(x->tab_name_, index.cols))
-                            .get();
-                    char *key = new char[index.col_total_len];
-                    int offset = 0;
-                    for (int j = 0; j < index.col_num; j++) {
-                        memcpy(key + offset, rec.data + index.cols[j].offset, index.cols[j].len);
-                        offset += index.cols[j].len;
-                    }
-                    bool is_insert = ih->insert_entry(key, rid_, context_->txn_);
-                    if (!is_insert) {
-                        fh_->delete_record(rid_, context_);
-                        throw IndexEntryRepeatError();
-                    }
-                    delete[] key;
+                if (++batch_rows == BULK_INSERT_BATCH_ROWS) {
+                    flush_batch();
                 }
             }
         }
+        flush_batch();
     }
 }
 
@@ -29,10 +29,11 @@ class BlockBufferManager {
     int size_;             // buffer 可能占不满
     bool is_end = false;   // 该表是否到达结尾
     bool is_full = false;  // pages是否是满的
+    std::unique_ptr<BufferAccessStrategy> strategy_;  // 表放不进缓冲池时在环形帧中扫描，内表每轮都会重新扫描
 
    public:
     BlockBufferManager(const RmFileHandle *file_handle, Page *pages, int size)
-        : file_handle_(file_handle), pages_(pages), max_size_(size) {
+        : file_handle_(file_handle), pages_(pages), max_size_(size), strategy_(file_handle->create_scan_strategy(true)) {
         // 初始化file_handle和rid（指向第一个存放了记录的位置）
         // 同时把页记到pages_里
         rid_.page_no = RM_FIRST_RECORD_PAGE;
@@ -43,7 +44,10 @@ class BlockBufferManager {
      * @brief  重置buffer里的pages
      */
     void reset() {
-        memset(pages_, 0, max_size_ * sizeof(Page));
+        // Page只保存页面数据的地址，不能整体清零，只清空页面数据
+        for (int i = 0; i < max_size_; i++) {
+            memset(pages_[i].get_data(), 0, PAGE_SIZE);
+        }
         is_full = false;
         if (is_end) {
             is_end = false;
@@ -57,14 +61,22 @@ class BlockBufferManager {
         // 找到文件中下一个存放了记录的非空闲位置，用rid_来指向这个位置
         size_ = 0;
         auto max_n = file_handle_->file_hdr_.num_records_per_page;
+        int prefetched_page_no = rid_.page_no;
         // join buffer没满，且没扫完表最后一个页
         while (size_ < max_size_ && rid_.page_no < file_handle_->file_hdr_.num_pages) {
-            auto page_handle = file_handle_->fetch_page_handle(rid_.page_no);
+            if (rid_.page_no >= prefetched_page_no) {
+                // 按批预取，避免join buffer较大时一次占用过多缓冲池帧
+                int n = std::min(max_size_ - size_, SCAN_PREFETCH_PAGES);
+                file_handle_->prefetch_pages(rid_.page_no, n, strategy_.get());
+                prefetched_page_no = rid_.page_no + n;
+            }
+            auto page_handle = file_handle_->fetch_page_handle(rid_.page_no, strategy_.get());
             rid_.slot_no = Bitmap::next_bit(true, page_handle.bitmap, max_n, rid_.slot_no);
             // 页里有数据
             if (rid_.slot_no < max_n) {
                 // TODO page存到pages里
-                memcpy(pages_ + size_, page_handle.page, sizeof(Page));
+                memcpy(pages_[size_].get_data(), page_handle.page->get_data(), PAGE_SIZE);
+                pages_[size_].set_page_id(page_handle.page->get_page_id());
                 size_++;
                 // DONE
             }
@@ -165,8 +177,8 @@ class BlockScanner {
     std::unique_ptr<RmRecord> getTuple() {
         auto page = pages_ + position_;
         auto page_handle = RmPageHandle(&file_hdr_, page);
-        auto record_size = page_handle.file_hdr->record_size;
-        auto record = std::make_unique<RmRecord>(record_size, page_handle.get_slot(slot_no_));
+        auto record = std::make_unique<RmRecord>(page_handle.file_hdr->record_size);
+        scanner_->GetFileHandle()->read_record(page_handle, slot_no_, record->data);
         return record;
     }
 
@@ -35,6 +35,7 @@ class IndexScanExecutor : public AbstractExecutor {
 
     Rid rid_;
     std::unique_ptr<IxScan> scan_;
+    RmRecordView rec_view_;  // rid_对应的记录，谓词求值和Next()都直接读取页面中的数据
 
     SmManager *sm_manager_;
 
@@ -150,8 +151,9 @@ class IndexScanExecutor : public AbstractExecutor {
         if (!is_end()) {
             rid_ = scan_->rid();
             try {
-                auto rec = fh_->get_record(rid_, context_);
-                if (!eval_conds(cols_, fed_conds_, rec.get())) {
+                rec_view_ = fh_->get_record_view(rid_, context_);
+                if (!eval_conds(cols_, fed_conds_, rec_view_.data())) {
+                    rec_view_.release();
                     scan_->set_end();
                 }
             } catch (RecordNotFoundError &e) {
@@ -164,6 +166,7 @@ class IndexScanExecutor : public AbstractExecutor {
 
     void nextTuple() override {
         check_runtime_conds();
+        rec_view_.release();
         scan_->next();
         if (is_end()) {
             return;
@@ -171,8 +174,9 @@ class IndexScanExecutor : public AbstractExecutor {
         rid_ = scan_->rid();
 
         try {
-            auto rec = fh_->get_record(rid_, context_);
-            if (!eval_conds(cols_, fed_conds_, rec.get())) {
+            rec_view_ = fh_->get_record_view(rid_, context_);
+            if (!eval_conds(cols_, fed_conds_, rec_view_.data())) {
+                rec_view_.release();
                 scan_->set_end();
             }
         } catch (RecordNotFoundError &e) {
@@ -188,6 +192,9 @@ class IndexScanExecutor : public AbstractExecutor {
 
     std::unique_ptr<RmRecord> Next() override {
         assert(!is_end());
+        if (rec_view_.valid()) {
+            return rec_view_.to_record();
+        }
         return fh_->get_record(rid_, context_);
     }
 
@@ -213,10 +220,10 @@ class IndexScanExecutor : public AbstractExecutor {
         }
     }
 
-    bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const RmRecord *rec) {
+    bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const char *rec) {
         auto lhs_col = get_col(rec_cols, cond.lhs_col);
-        char *lhs = rec->data + lhs_col->offset;
-        char *rhs;
+        const char *lhs = rec + lhs_col->offset;
+        const char *rhs;
         ColType rhs_type;
         if (cond.is_rhs_val) {
             rhs_type = cond.rhs_val.type;
@@ -225,7 +232,7 @@ class IndexScanExecutor : public AbstractExecutor {
             // rhs is a column
             auto rhs_col = get_col(rec_cols, cond.rhs_col);
             rhs_type = rhs_col->type;
-            rhs = rec->data + rhs_col->offset;
+            rhs = rec + rhs_col->offset;
         }
         assert(rhs_type == lhs_col->type);  // TODO convert to common type
         int cmp = ix_compare(lhs, rhs, rhs_type, lhs_col->len);
@@ -246,7 +253,7 @@ class IndexScanExecutor : public AbstractExecutor {
         }
     }
 
-    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const RmRecord *rec) {
+    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const char *rec) {
         return std::all_of(conds.begin(), conds.end(),
                            [&](const Condition &cond) { return eval_cond(rec_cols, cond, rec); });
     }
@@ -28,7 +28,8 @@ class SeqScanExecutor : public AbstractExecutor {
     std::vector<Condition> fed_conds_;  // 同conds_，两个字段相同
 
     Rid rid_;
-    std::unique_ptr<RecScan> scan_;  // table_iterator
+    std::unique_ptr<RmBatchScan> scan_;  // table_iterator，每次固定一个页面
+    size_t pos_ = 0;                     // rid_在scan_当前页面的记录中的下标
 
     SmManager *sm_manager_;
 
@@ -78,47 +79,17 @@ class SeqScanExecutor : public AbstractExecutor {
 
         check_runtime_conds();
 
-        scan_ = std::make_unique<RmScan>(fh_);
-
+        scan_ = std::make_unique<RmBatchScan>(fh_);
+        pos_ = 0;
         // 得到第一个满足fed_conds_条件的record,并把其rid赋给算子成员rid_
-        while (!scan_->is_end()) {
-            rid_ = scan_->rid();
-            try {
-                auto rec = fh_->get_record(rid_, context_);  // TableHeap->GetTuple() 当前扫描到的记录
-                // lab3 task2 todo
-                // 利用eval_conds判断是否当前记录(rec.get())满足谓词条件
-                if (eval_conds(cols_, fed_conds_, rec.get())) {
-                    // 满足则中止循环
-                    break;
-                }
-                // lab3 task2 todo end
-            } catch (RecordNotFoundError &e) {
-                std::cerr << e.what() << std::endl;
-            }
-
-            scan_->next();  // 找下一个有record的位置
-        }
+        find_next_tuple();
     }
 
     void nextTuple() override {
         check_runtime_conds();
         assert(!is_end());
-        for (scan_->next(); !scan_->is_end(); scan_->next()) {  // 用TableIterator遍历TableHeap中的所有Tuple
-            // lab3 task2 todo
-            // 获取当前记录(参考beginTuple())赋给算子成员rid_
-            rid_ = scan_->rid();
-            try {
-                auto rec = fh_->get_record(rid_, context_);
-                // 利用eval_conds判断是否当前记录(rec.get())满足谓词条件
-                if (eval_conds(cols_, fed_conds_, rec.get())) {
-                    // 满足则中止循环
-                    break;
-                }
-            } catch (RecordNotFoundError &e) {
-                std::cerr << e.what() << std::endl;
-            }
-            // lab3 task2 todo End
-        }
+        pos_++;
+        find_next_tuple();
     }
 
     bool is_end() const override { return scan_->is_end(); }
@@ -129,8 +100,9 @@ class SeqScanExecutor : public AbstractExecutor {
 
     std::unique_ptr<RmRecord> Next() override {
         // lab3 task2 todo
-        // 利用fh_得到记录record
-        return fh_->get_record(rid_, context_);
+        // 记录要交给上层算子，从固定的页面中复制一份
+        assert(!is_end());
+        return scan_->get_record(pos_);
         // lab3 task2 todo end
     }
 
@@ -158,6 +130,21 @@ class SeqScanExecutor : public AbstractExecutor {
 
     Rid &rid() override { return rid_; }
 
+    /**
+     * @brief 从当前页面的第pos_条记录开始，找到第一个满足谓词条件的记录，当前页面找完后换到下一个页面。
+     * 记录直接在固定的页面中求值；构造时已经加了表级S锁，写操作需要的IX锁与之冲突，不再对每条记录加S锁
+     */
+    void find_next_tuple() {
+        for (; !scan_->is_end(); scan_->next_page(), pos_ = 0) {
+            for (; pos_ < scan_->size(); pos_++) {
+                if (eval_conds(cols_, fed_conds_, scan_->record(pos_))) {
+                    rid_ = scan_->rid(pos_);
+                    return;
+                }
+            }
+        }
+    }
+
     void check_runtime_conds() {
         for (auto &cond : fed_conds_) {
             assert(cond.lhs_col.tab_name == tab_name_);
@@ -170,10 +157,10 @@ class SeqScanExecutor : public AbstractExecutor {
      * @brief 判断是否满足谓词条件
      *
      */
-    bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const RmRecord *rec) {
+    bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const char *rec) {
         auto lhs_col = get_col(rec_cols, cond.lhs_col);
-        char *lhs = rec->data + lhs_col->offset;
-        char *rhs;
+        const char *lhs = rec + lhs_col->offset;
+        const char *rhs;
         ColType rhs_type;
         if (cond.is_rhs_val) {
             rhs_type = cond.rhs_val.type;
@@ -182,7 +169,7 @@ class SeqScanExecutor : public AbstractExecutor {
             // rhs is a column
             auto rhs_col = get_col(rec_cols, cond.rhs_col);
             rhs_type = rhs_col->type;
-            rhs = rec->data + rhs_col->offset;
+            rhs = rec + rhs_col->offset;
         }
         assert(rhs_type == lhs_col->type);  // TODO convert to common type
         int cmp = ix_compare(lhs, rhs, rhs_type, lhs_col->len);
@@ -203,7 +190,7 @@ class SeqScanExecutor : public AbstractExecutor {
         }
     }
 
-    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const RmRecord *rec) {
+    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const char *rec) {
         return std::all_of(conds.begin(), conds.end(),
                            [&](const Condition &cond) { return eval_cond(rec_cols, cond, rec); });
     }
@@ -37,8 +37,9 @@ class IxFileHdr {
     page_id_t first_leaf_;  // 首叶节点对应的页号，在上层IxManager的open函数进行初始化，初始化为root page_no
     page_id_t last_leaf_;  // 尾叶节点对应的页号
     int total_len_;        // 记录结构体的整体长度
+    int num_allocated_pages_;  // 文件中已经用fallocate预分配的页面个数
 
-    IxFileHdr() { total_len_ = col_num_ = 0; }
+    IxFileHdr() { total_len_ = col_num_ = num_allocated_pages_ = 0; }
 
     IxFileHdr(page_id_t first_free_page_no, int num_pages, page_id_t root_page, int col_num, int col_total_len,
               int btree_order, int keys_size, page_id_t first_leaf, page_id_t last_leaf)
@@ -50,13 +51,14 @@ class IxFileHdr {
           btree_order_(btree_order),
           keys_size_(keys_size),
           first_leaf_(first_leaf),
-          last_leaf_(last_leaf) {
+          last_leaf_(last_leaf),
+          num_allocated_pages_(num_pages) {
         total_len_ = 0;
     }
 
     void update_total_len() {
         total_len_ = 0;
-        total_len_ += sizeof(page_id_t) * 4 + sizeof(int) * 6;
+        total_len_ += sizeof(page_id_t) * 4 + sizeof(int) * 7;
         total_len_ += sizeof(ColType) * col_num_ + sizeof(int) * col_num_;
     }
 
@@ -90,12 +92,15 @@ class IxFileHdr {
         offset += sizeof(page_id_t);
         memcpy(dest + offset, &last_leaf_, sizeof(page_id_t));
         offset += sizeof(page_id_t);
+        memcpy(dest + offset, &num_allocated_pages_, sizeof(int));
+        offset += sizeof(int);
         assert(offset == total_len_);
     }
 
     void deserialize(char *src) {
         int offset = 0;
         total_len_ = *reinterpret_cast<const int *>(src + offset);
+        int stored_len = total_len_;
         offset += sizeof(int);
         first_free_page_no_ = *reinterpret_cast<const page_id_t *>(src + offset);
         offset += sizeof(int);
@@ -128,7 +133,15 @@ class IxFileHdr {
         offset += sizeof(page_id_t);
         last_leaf_ = *reinterpret_cast<const page_id_t *>(src + offset);
         offset += sizeof(page_id_t);
-        assert(offset == total_len_);
+        if (offset < stored_len) {
+            num_allocated_pages_ = *reinterpret_cast<const int *>(src + offset);
+            offset += sizeof(int);
+        } else {
+            // 旧版本的文件头没有num_allocated_pages_，置为0由调用者按文件大小设置，关闭时按新格式写回
+            num_allocated_pages_ = 0;
+            update_total_len();
+        }
+        assert(offset == stored_len);
     }
 };
 
@@ -263,6 +263,10 @@ IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffe
     disk_manager_->read_page(fd, IX_FILE_HDR_PAGE, buf, PAGE_SIZE);
     file_hdr_ = new IxFileHdr();
     file_hdr_->deserialize(buf);
+    if (file_hdr_->num_allocated_pages_ == 0) {
+        // 旧版本的索引文件，文件中已有的页面都已分配
+        file_hdr_->num_allocated_pages_ = disk_manager_->get_file_size(disk_manager_->get_file_name(fd)) / PAGE_SIZE;
+    }
 
     delete[] buf;
     // // disk_manager管理的fd对应的文件中，设置从file_hdr_->num_pages开始分配page_no
@@ -510,6 +514,7 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
         coalesce_or_redistribute(leaf);
     }
     bpm_->unpin_page(leaf->get_page_id(), is_removed);
+    free_released_pages();
     return is_removed;
     // 4. todo:
     // 如果需要并发，并且需要删除叶子结点，则需要在事务的delete_page_set中添加删除结点的对应页面；记得处理并发的上锁
@@ -558,8 +563,10 @@ bool IxIndexHandle::coalesce_or_redistribute(IxNodeHandle *node, Transaction *tr
     }
     // 5. 如果不满足上述条件，则需要合并两个结点，将右边的结点合并到左边的结点（调用Coalesce函数）
 
+    // coalesce可能交换brother和node，这里记下兄弟结点，保证unpin的是本函数fetch的结点
+    IxNodeHandle *sibling = brother;
     coalesce(&brother, &node, &parent, node_idx, transaction);
-    bpm_->unpin_page(brother->get_page_id(), true);
+    bpm_->unpin_page(sibling->get_page_id(), true);
     bpm_->unpin_page(parent->get_page_id(), true);
 
     return false;
@@ -576,7 +583,7 @@ bool IxIndexHandle::adjust_root(IxNodeHandle *old_root_node) {
     // Todo:
     // 2. 如果old_root_node是叶结点，且大小为0，则直接更新root page
     if (old_root_node->is_leaf_page() && old_root_node->get_size() == 0) {
-        release_node_handle(*old_root_node);
+        // 空的叶子根结点仍然作为根结点使用，不能释放
         // file_hdr_->root_page_ = INVALID_PAGE_ID;
         return true;
     }
@@ -809,11 +816,14 @@ IxNodeHandle *IxIndexHandle::fetch_node(int page_no) const {
  */
 IxNodeHandle *IxIndexHandle::create_node() {
     IxNodeHandle *node;
-    file_hdr_->num_pages_++;
 
     PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
-    // 从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
+    // 优先复用被释放的页面，否则从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
     Page *page = bpm_->new_page(&new_page_id);
+    // num_pages_是文件中已分配页面号的上界，复用页面时不变
+    file_hdr_->num_pages_ = std::max(file_hdr_->num_pages_, new_page_id.page_no + 1);
+    file_hdr_->num_allocated_pages_ =
+        disk_manager_->preallocate_pages(fd_, new_page_id.page_no, file_hdr_->num_allocated_pages_);
     node = new IxNodeHandle(file_hdr_, page);
     return node;
 }
@@ -859,11 +869,25 @@ void IxIndexHandle::erase_leaf(IxNodeHandle *leaf) {
 }
 
 /**
- * @brief 删除node时，更新file_hdr_.num_pages
+ * @brief 删除node时，记录node所在的页面，在删除操作结束后由free_released_pages归还给DiskManager
+ * @note 此时node仍被调用者pin住，不能直接从缓冲池中删除
  *
  * @param node
  */
-void IxIndexHandle::release_node_handle(IxNodeHandle &node) { file_hdr_->num_pages_--; }
+void IxIndexHandle::release_node_handle(IxNodeHandle &node) { released_pages_.push_back(node.get_page_no()); }
+
+/**
+ * @brief 把本次删除操作中被释放的结点页面从缓冲池中删除，并归还给DiskManager以便create_node复用
+ * @note 仍被pin住的页面（pin计数没有归零）不会被复用，只会造成空间泄露
+ */
+void IxIndexHandle::free_released_pages() {
+    for (auto page_no : released_pages_) {
+        if (bpm_->delete_page(PageId{.fd = fd_, .page_no = page_no})) {
+            disk_manager_->deallocate_page(fd_, page_no);
+        }
+    }
+    released_pages_.clear();
+}
 
 /**
  * @brief 将node的第child_idx个孩子结点的父节点置为node
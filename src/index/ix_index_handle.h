@@ -203,6 +203,7 @@ class IxIndexHandle {
     int fd_;               // 存储B+树的文件
     IxFileHdr *file_hdr_;  // 存了root_page，但其初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
     std::mutex root_latch_;
+    std::vector<page_id_t> released_pages_;  // 本次删除操作中被释放的结点，等所有结点unpin之后再归还给DiskManager
 
    public:
     IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
@@ -266,6 +267,8 @@ class IxIndexHandle {
 
     void release_node_handle(IxNodeHandle &node);
 
+    void free_released_pages();
+
     void maintain_child(IxNodeHandle *node, int child_idx);
 
     // for index test
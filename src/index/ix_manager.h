@@ -133,6 +133,7 @@ class IxManager {
 
     void destroy_index(const std::string &filename, const std::vector<ColMeta> &index_cols, int fd) {
         std::string ix_name = get_index_name(filename, index_cols);
+        bpm_->cancel_readahead(fd);
         bpm_->delete_all_pages(fd);
         disk_manager_->close_file(fd);
         disk_manager_->destroy_file(ix_name);
@@ -161,6 +162,7 @@ class IxManager {
         ih->file_hdr_->serialize(data);
         disk_manager_->write_page(ih->fd_, IX_FILE_HDR_PAGE, data, ih->file_hdr_->total_len_);
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
+        bpm_->cancel_readahead(ih->fd_);
         bpm_->flush_all_pages(ih->fd_);
         disk_manager_->close_file(ih->fd_);
     }
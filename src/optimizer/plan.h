@@ -173,6 +173,7 @@ class DDLPlan : public Plan {
     std::string tab_name_;
     std::vector<std::string> tab_col_names_;
     std::vector<ColDef> cols_;
+    bool compressed_ = false;  // create table时表的页面是否压缩存储
 };
 
 // help; show tables; desc tables; begin; abort; commit; rollback语句对应的plan
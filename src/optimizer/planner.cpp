@@ -387,13 +387,16 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
             if (auto sv_col_def = std::dynamic_pointer_cast<ast::ColDef>(field)) {
                 ColDef col_def = {.name = sv_col_def->col_name,
                                   .type = interp_sv_type(sv_col_def->type_len->type),
-                                  .len = sv_col_def->type_len->len};
+                                  .len = sv_col_def->type_len->len,
+                                  .varlen = sv_col_def->type_len->type == ast::SV_TYPE_VARCHAR};
                 col_defs.push_back(col_def);
             } else {
                 throw InternalError("Unexpected field type");
             }
         }
-        plannerRoot = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, std::vector<std::string>(), col_defs);
+        auto ddl_plan = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, std::vector<std::string>(), col_defs);
+        ddl_plan->compressed_ = x->compressed;
+        plannerRoot = ddl_plan;
     } else if (auto x = std::dynamic_pointer_cast<ast::DropTable>(query->parse)) {
         // drop table;
         plannerRoot =
@@ -16,7 +16,7 @@ See the Mulan PSL v2 for more details. */
 enum JoinType { INNER_JOIN, LEFT_JOIN, RIGHT_JOIN, FULL_JOIN };
 namespace ast {
 
-enum SvType { SV_TYPE_INT, SV_TYPE_BIGINT, SV_TYPE_FLOAT, SV_TYPE_STRING, SV_TYPE_DATETIME };
+enum SvType { SV_TYPE_INT, SV_TYPE_BIGINT, SV_TYPE_FLOAT, SV_TYPE_STRING, SV_TYPE_DATETIME, SV_TYPE_VARCHAR };
 
 enum SvCompOp { SV_OP_EQ, SV_OP_NE, SV_OP_LT, SV_OP_GT, SV_OP_LE, SV_OP_GE };
 
@@ -75,9 +75,10 @@ struct ColDef : public Field {
 struct CreateTable : public TreeNode {
     std::string tab_name;
     std::vector<std::shared_ptr<Field>> fields;
+    bool compressed;  // 表的页面是否压缩存储
 
-    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_)
-        : tab_name(std::move(tab_name_)), fields(std::move(fields_)) {}
+    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_, bool compressed_ = false)
+        : tab_name(std::move(tab_name_)), fields(std::move(fields_)), compressed(compressed_) {}
 };
 
 struct DropTable : public TreeNode {
@@ -42,6 +42,7 @@ class TreePrinter {
             {SV_TYPE_INT, "INT"},
             {SV_TYPE_FLOAT, "FLOAT"},
             {SV_TYPE_STRING, "STRING"},
+            {SV_TYPE_VARCHAR, "VARCHAR"},
         };
         return m.at(type);
     }
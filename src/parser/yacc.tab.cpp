@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,14 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -66,10 +67,11 @@
 
 
 /* First part of user prologue.  */
-#line 1 "yacc.y"
+#line 1 "/root/repo/src/parser/yacc.y"
 
 #include "ast.h"
 #include "yacc.tab.h"
+#include <strings.h>
 #include <iostream>
 #include <memory>
 
@@ -81,7 +83,7 @@ void yyerror(YYLTYPE *locp, const char* s) {
 
 using namespace ast;
 
-#line 85 "yacc.tab.cpp"
+#line 87 "/root/repo/src/parser/yacc.tab.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -104,106 +106,112 @@ using namespace ast;
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_YACC_TAB_HPP_INCLUDED
-# define YY_YY_YACC_TAB_HPP_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    SHOW = 258,
-    TABLES = 259,
-    CREATE = 260,
-    TABLE = 261,
-    DROP = 262,
-    DESC = 263,
-    INSERT = 264,
-    INTO = 265,
-    VALUES = 266,
-    DELETE = 267,
-    FROM = 268,
-    ASC = 269,
-    COUNT = 270,
-    MAX = 271,
-    MIN = 272,
-    SUM = 273,
-    ORDER = 274,
-    BY = 275,
-    LIMIT = 276,
-    AS = 277,
-    LOAD = 278,
-    WHERE = 279,
-    UPDATE = 280,
-    SET = 281,
-    SELECT = 282,
-    INT = 283,
-    BIGINT = 284,
-    CHAR = 285,
-    FLOAT = 286,
-    DATETIME = 287,
-    INDEX = 288,
-    AND = 289,
-    JOIN = 290,
-    EXIT = 291,
-    HELP = 292,
-    TXN_BEGIN = 293,
-    TXN_COMMIT = 294,
-    TXN_ABORT = 295,
-    TXN_ROLLBACK = 296,
-    ORDER_BY = 297,
-    LEQ = 298,
-    NEQ = 299,
-    GEQ = 300,
-    T_EOF = 301,
-    IDENTIFIER = 302,
-    VALUE_STRING = 303,
-    PATH = 304,
-    VALUE_INT = 305,
-    VALUE_FLOAT = 306
-  };
-#endif
-
-/* Value type.  */
-
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
+#include "yacc.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SHOW = 3,                       /* SHOW  */
+  YYSYMBOL_TABLES = 4,                     /* TABLES  */
+  YYSYMBOL_CREATE = 5,                     /* CREATE  */
+  YYSYMBOL_TABLE = 6,                      /* TABLE  */
+  YYSYMBOL_DROP = 7,                       /* DROP  */
+  YYSYMBOL_DESC = 8,                       /* DESC  */
+  YYSYMBOL_INSERT = 9,                     /* INSERT  */
+  YYSYMBOL_INTO = 10,                      /* INTO  */
+  YYSYMBOL_VALUES = 11,                    /* VALUES  */
+  YYSYMBOL_DELETE = 12,                    /* DELETE  */
+  YYSYMBOL_FROM = 13,                      /* FROM  */
+  YYSYMBOL_ASC = 14,                       /* ASC  */
+  YYSYMBOL_COUNT = 15,                     /* COUNT  */
+  YYSYMBOL_MAX = 16,                       /* MAX  */
+  YYSYMBOL_MIN = 17,                       /* MIN  */
+  YYSYMBOL_SUM = 18,                       /* SUM  */
+  YYSYMBOL_ORDER = 19,                     /* ORDER  */
+  YYSYMBOL_BY = 20,                        /* BY  */
+  YYSYMBOL_LIMIT = 21,                     /* LIMIT  */
+  YYSYMBOL_AS = 22,                        /* AS  */
+  YYSYMBOL_LOAD = 23,                      /* LOAD  */
+  YYSYMBOL_WHERE = 24,                     /* WHERE  */
+  YYSYMBOL_UPDATE = 25,                    /* UPDATE  */
+  YYSYMBOL_SET = 26,                       /* SET  */
+  YYSYMBOL_SELECT = 27,                    /* SELECT  */
+  YYSYMBOL_INT = 28,                       /* INT  */
+  YYSYMBOL_BIGINT = 29,                    /* BIGINT  */
+  YYSYMBOL_CHAR = 30,                      /* CHAR  */
+  YYSYMBOL_FLOAT = 31,                     /* FLOAT  */
+  YYSYMBOL_DATETIME = 32,                  /* DATETIME  */
+  YYSYMBOL_INDEX = 33,                     /* INDEX  */
+  YYSYMBOL_AND = 34,                       /* AND  */
+  YYSYMBOL_JOIN = 35,                      /* JOIN  */
+  YYSYMBOL_EXIT = 36,                      /* EXIT  */
+  YYSYMBOL_HELP = 37,                      /* HELP  */
+  YYSYMBOL_TXN_BEGIN = 38,                 /* TXN_BEGIN  */
+  YYSYMBOL_TXN_COMMIT = 39,                /* TXN_COMMIT  */
+  YYSYMBOL_TXN_ABORT = 40,                 /* TXN_ABORT  */
+  YYSYMBOL_TXN_ROLLBACK = 41,              /* TXN_ROLLBACK  */
+  YYSYMBOL_ORDER_BY = 42,                  /* ORDER_BY  */
+  YYSYMBOL_LEQ = 43,                       /* LEQ  */
+  YYSYMBOL_NEQ = 44,                       /* NEQ  */
+  YYSYMBOL_GEQ = 45,                       /* GEQ  */
+  YYSYMBOL_T_EOF = 46,                     /* T_EOF  */
+  YYSYMBOL_IDENTIFIER = 47,                /* IDENTIFIER  */
+  YYSYMBOL_VALUE_STRING = 48,              /* VALUE_STRING  */
+  YYSYMBOL_PATH = 49,                      /* PATH  */
+  YYSYMBOL_VALUE_INT = 50,                 /* VALUE_INT  */
+  YYSYMBOL_VALUE_FLOAT = 51,               /* VALUE_FLOAT  */
+  YYSYMBOL_52_ = 52,                       /* ';'  */
+  YYSYMBOL_53_ = 53,                       /* '('  */
+  YYSYMBOL_54_ = 54,                       /* ')'  */
+  YYSYMBOL_55_ = 55,                       /* ','  */
+  YYSYMBOL_56_ = 56,                       /* '.'  */
+  YYSYMBOL_57_ = 57,                       /* '='  */
+  YYSYMBOL_58_ = 58,                       /* '<'  */
+  YYSYMBOL_59_ = 59,                       /* '>'  */
+  YYSYMBOL_60_ = 60,                       /* '*'  */
+  YYSYMBOL_YYACCEPT = 61,                  /* $accept  */
+  YYSYMBOL_start = 62,                     /* start  */
+  YYSYMBOL_stmt = 63,                      /* stmt  */
+  YYSYMBOL_txnStmt = 64,                   /* txnStmt  */
+  YYSYMBOL_dbStmt = 65,                    /* dbStmt  */
+  YYSYMBOL_ddl = 66,                       /* ddl  */
+  YYSYMBOL_dml = 67,                       /* dml  */
+  YYSYMBOL_countType = 68,                 /* countType  */
+  YYSYMBOL_aggType = 69,                   /* aggType  */
+  YYSYMBOL_singleSelector = 70,            /* singleSelector  */
+  YYSYMBOL_fieldList = 71,                 /* fieldList  */
+  YYSYMBOL_colNameList = 72,               /* colNameList  */
+  YYSYMBOL_field = 73,                     /* field  */
+  YYSYMBOL_type = 74,                      /* type  */
+  YYSYMBOL_valueList = 75,                 /* valueList  */
+  YYSYMBOL_value = 76,                     /* value  */
+  YYSYMBOL_condition = 77,                 /* condition  */
+  YYSYMBOL_optWhereClause = 78,            /* optWhereClause  */
+  YYSYMBOL_whereClause = 79,               /* whereClause  */
+  YYSYMBOL_col = 80,                       /* col  */
+  YYSYMBOL_colList = 81,                   /* colList  */
+  YYSYMBOL_op = 82,                        /* op  */
+  YYSYMBOL_expr = 83,                      /* expr  */
+  YYSYMBOL_setClauses = 84,                /* setClauses  */
+  YYSYMBOL_setClause = 85,                 /* setClause  */
+  YYSYMBOL_selector = 86,                  /* selector  */
+  YYSYMBOL_tableList = 87,                 /* tableList  */
+  YYSYMBOL_opt_order_clause = 88,          /* opt_order_clause  */
+  YYSYMBOL_order_clause = 89,              /* order_clause  */
+  YYSYMBOL_opt_asc_desc = 90,              /* opt_asc_desc  */
+  YYSYMBOL_optLimitClause = 91,            /* optLimitClause  */
+  YYSYMBOL_tbName = 92,                    /* tbName  */
+  YYSYMBOL_colName = 93,                   /* colName  */
+  YYSYMBOL_asName = 94,                    /* asName  */
+  YYSYMBOL_fileName = 95                   /* fileName  */
 };
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
 
-int yyparse (void);
-
-#endif /* !YY_YY_YACC_TAB_HPP_INCLUDED  */
-
-
 
 #ifdef short
 # undef short
@@ -242,6 +250,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -301,6 +321,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_uint8 yy_state_t;
 
@@ -319,6 +340,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -337,17 +359,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -376,7 +404,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -441,8 +469,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -510,25 +537,27 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  49
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   152
+#define YYLAST   157
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  61
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  35
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  85
+#define YYNRULES  87
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  171
+#define YYNSTATES  176
 
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   306
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -568,181 +597,179 @@ static const yytype_int8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    58,    58,    63,    68,    73,    81,    82,    83,    84,
-      88,    92,    96,   100,   107,   111,   118,   122,   126,   130,
-     134,   141,   145,   149,   153,   157,   161,   165,   172,   178,
-     182,   186,   192,   199,   203,   210,   214,   221,   228,   232,
-     236,   240,   244,   252,   256,   263,   267,   271,   278,   285,
-     286,   293,   297,   304,   308,   315,   319,   326,   330,   334,
-     338,   342,   346,   353,   357,   364,   368,   375,   382,   386,
-     390,   394,   398,   405,   409,   413,   418,   425,   426,   427,
-     430,   435,   439,   441,   443,   445
+       0,    59,    59,    64,    69,    74,    82,    83,    84,    85,
+      89,    93,    97,   101,   108,   112,   119,   123,   132,   136,
+     140,   144,   151,   155,   159,   163,   167,   171,   175,   182,
+     188,   192,   196,   202,   209,   213,   220,   224,   231,   238,
+     242,   246,   250,   259,   263,   271,   275,   282,   286,   290,
+     297,   304,   305,   312,   316,   323,   327,   334,   338,   345,
+     349,   353,   357,   361,   365,   372,   376,   383,   387,   394,
+     401,   405,   409,   413,   417,   424,   428,   432,   437,   444,
+     445,   446,   449,   454,   458,   460,   462,   464
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "SHOW", "TABLES", "CREATE", "TABLE",
-  "DROP", "DESC", "INSERT", "INTO", "VALUES", "DELETE", "FROM", "ASC",
-  "COUNT", "MAX", "MIN", "SUM", "ORDER", "BY", "LIMIT", "AS", "LOAD",
-  "WHERE", "UPDATE", "SET", "SELECT", "INT", "BIGINT", "CHAR", "FLOAT",
-  "DATETIME", "INDEX", "AND", "JOIN", "EXIT", "HELP", "TXN_BEGIN",
-  "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "ORDER_BY", "LEQ", "NEQ",
-  "GEQ", "T_EOF", "IDENTIFIER", "VALUE_STRING", "PATH", "VALUE_INT",
-  "VALUE_FLOAT", "';'", "'('", "')'", "','", "'.'", "'='", "'<'", "'>'",
-  "'*'", "$accept", "start", "stmt", "txnStmt", "dbStmt", "ddl", "dml",
-  "countType", "aggType", "singleSelector", "fieldList", "colNameList",
-  "field", "type", "valueList", "value", "condition", "optWhereClause",
-  "whereClause", "col", "colList", "op", "expr", "setClauses", "setClause",
-  "selector", "tableList", "opt_order_clause", "order_clause",
-  "opt_asc_desc", "optLimitClause", "tbName", "colName", "asName",
-  "fileName", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "SHOW", "TABLES",
+  "CREATE", "TABLE", "DROP", "DESC", "INSERT", "INTO", "VALUES", "DELETE",
+  "FROM", "ASC", "COUNT", "MAX", "MIN", "SUM", "ORDER", "BY", "LIMIT",
+  "AS", "LOAD", "WHERE", "UPDATE", "SET", "SELECT", "INT", "BIGINT",
+  "CHAR", "FLOAT", "DATETIME", "INDEX", "AND", "JOIN", "EXIT", "HELP",
+  "TXN_BEGIN", "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "ORDER_BY",
+  "LEQ", "NEQ", "GEQ", "T_EOF", "IDENTIFIER", "VALUE_STRING", "PATH",
+  "VALUE_INT", "VALUE_FLOAT", "';'", "'('", "')'", "','", "'.'", "'='",
+  "'<'", "'>'", "'*'", "$accept", "start", "stmt", "txnStmt", "dbStmt",
+  "ddl", "dml", "countType", "aggType", "singleSelector", "fieldList",
+  "colNameList", "field", "type", "valueList", "value", "condition",
+  "optWhereClause", "whereClause", "col", "colList", "op", "expr",
+  "setClauses", "setClause", "selector", "tableList", "opt_order_clause",
+  "order_clause", "opt_asc_desc", "optLimitClause", "tbName", "colName",
+  "asName", "fileName", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,    59,    40,    41,    44,    46,    61,    60,    62,
-      42
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF (-90)
+#define YYPACT_NINF (-91)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-83)
+#define YYTABLE_NINF (-85)
 
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
-static const yytype_int8 yypact[] =
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
 {
-      30,    15,    12,    40,   -41,     1,     7,    -8,   -41,    14,
-     -90,   -90,   -90,   -90,   -90,   -90,   -90,    44,    -1,   -90,
-     -90,   -90,   -90,   -90,    51,   -41,   -41,   -41,   -41,   -90,
-     -90,   -41,   -41,   -90,    62,    49,   -90,   -90,   -90,   -90,
-      29,   -90,    37,    41,   -90,    32,    86,    64,   -90,   -90,
-     -90,   -41,    68,    69,   -90,    70,    93,    85,   -41,    77,
-       3,    78,    78,   -41,    77,   -90,    77,    77,    77,    73,
-      78,   -90,   -90,   -90,   -15,   -90,    71,    75,    76,   -90,
-     -90,   -21,   -90,   -90,   -29,   -90,    52,    53,   -90,    56,
-      55,   -90,    97,    34,    77,   -90,    55,   105,   110,   -41,
-     -41,   114,   -90,    77,   -90,   -90,    81,   -90,   -90,   -90,
-     -90,    77,   -90,   -90,   -90,   -90,    58,   -90,    78,   -90,
-     -90,   -90,   -90,   -90,   -90,    50,   -90,   -90,    88,    88,
-     -90,   -90,   116,   117,   -90,    87,   -90,   -90,    55,   -90,
-     -90,   -90,   -90,   -90,   126,   127,    78,    91,   -90,    89,
-     -90,   -41,   -41,    48,    90,   -90,   -90,   -21,   -21,   -90,
-     -90,   -90,    78,   114,   114,    48,   117,   117,   -90,   -90,
-     -90
+      41,     6,     8,    23,   -46,    10,    13,   -12,   -46,    15,
+     -91,   -91,   -91,   -91,   -91,   -91,   -91,    45,    17,   -91,
+     -91,   -91,   -91,   -91,    50,   -46,   -46,   -46,   -46,   -91,
+     -91,   -46,   -46,   -91,    55,    60,   -91,   -91,   -91,   -91,
+      20,   -91,    35,    49,   -91,    62,   105,    63,   -91,   -91,
+     -91,   -46,    67,    68,   -91,    69,   112,   100,   -46,    78,
+      -5,    79,    79,   -46,    78,   -91,    78,    78,    78,    74,
+      79,   -91,   -91,   -91,   -15,   -91,    71,    75,    76,   -91,
+     -91,   -17,   -91,   -91,   -20,   -91,    42,     3,   -91,    37,
+      59,   -91,    97,    40,    78,   -91,    59,   110,   111,   -46,
+     -46,   115,    88,    78,   -91,   -91,    83,   -91,   -91,    84,
+     -91,   -91,    78,   -91,   -91,   -91,   -91,    51,   -91,    79,
+     -91,   -91,   -91,   -91,   -91,   -91,    53,   -91,   -91,    91,
+      91,   -91,   -91,   119,   120,   -91,   -91,    90,    92,   -91,
+     -91,    59,   -91,   -91,   -91,   -91,   -91,   130,   131,    79,
+      95,   -91,    93,    94,   -91,   -46,   -46,    11,    98,   -91,
+     -91,   -91,   -17,   -17,   -91,   -91,   -91,    79,   115,   115,
+      11,   120,   120,   -91,   -91,   -91
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        4,     3,    10,    11,    12,    13,     5,     0,     0,     9,
-       6,     7,     8,    14,     0,     0,     0,     0,     0,    82,
-      18,     0,     0,    85,     0,     0,    28,    29,    30,    31,
-      83,    68,     0,     0,    55,    69,     0,     0,    54,     1,
-       2,     0,     0,     0,    17,     0,     0,    49,     0,     0,
+       6,     7,     8,    14,     0,     0,     0,     0,     0,    84,
+      19,     0,     0,    87,     0,     0,    29,    30,    31,    32,
+      85,    70,     0,     0,    57,    71,     0,     0,    56,     1,
+       2,     0,     0,     0,    18,     0,     0,    51,     0,     0,
        0,     0,     0,     0,     0,    15,     0,     0,     0,     0,
-       0,    22,    27,    83,    49,    65,     0,     0,     0,    32,
-      56,    49,    70,    53,     0,    33,     0,     0,    35,     0,
-       0,    51,    50,     0,     0,    23,     0,     0,     0,     0,
-       0,    74,    16,     0,    38,    39,     0,    41,    42,    37,
-      19,     0,    20,    47,    45,    46,     0,    43,     0,    61,
-      60,    62,    57,    58,    59,     0,    66,    67,     0,     0,
-      72,    71,     0,    81,    34,     0,    36,    21,     0,    52,
-      63,    64,    48,    84,     0,     0,     0,     0,    24,     0,
-      44,     0,     0,    79,    73,    80,    40,    49,    49,    78,
-      77,    75,     0,    74,    74,    79,    81,    81,    76,    25,
-      26
+       0,    23,    28,    85,    51,    67,     0,     0,     0,    33,
+      58,    51,    72,    55,     0,    34,     0,     0,    36,     0,
+       0,    53,    52,     0,     0,    24,     0,     0,     0,     0,
+       0,    76,    16,     0,    39,    40,     0,    43,    44,     0,
+      38,    20,     0,    21,    49,    47,    48,     0,    45,     0,
+      63,    62,    64,    59,    60,    61,     0,    68,    69,     0,
+       0,    74,    73,     0,    83,    17,    35,     0,     0,    37,
+      22,     0,    54,    65,    66,    50,    86,     0,     0,     0,
+       0,    25,     0,     0,    46,     0,     0,    81,    75,    82,
+      41,    42,    51,    51,    80,    79,    77,     0,    76,    76,
+      81,    83,    83,    78,    26,    27
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -90,   -90,   -90,   -90,   -90,   -90,   -90,   -90,   -90,   -90,
-     -90,    74,    43,   -90,   -90,   -89,    26,   -69,   -90,   -60,
-     -90,   -90,   -90,   -90,    57,    92,   -37,   -47,   -90,   -16,
-     -48,    -4,   -51,    21,   -90
+     -91,   -91,   -91,   -91,   -91,   -91,   -91,   -91,   -91,   -91,
+     -91,    81,    43,   -91,   -91,   -90,    31,   -69,   -91,   -59,
+     -91,   -91,   -91,   -91,    61,    96,   -44,   -55,   -91,   -16,
+     -56,    -4,   -51,    27,   -91
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    17,    18,    19,    20,    21,    22,    42,    43,    78,
-      84,    87,    85,   109,   116,   117,    91,    71,    92,    44,
-      45,   125,   142,    74,    75,    46,    81,   133,   154,   161,
-     148,    47,    48,   144,    34
+       0,    17,    18,    19,    20,    21,    22,    42,    43,    78,
+      84,    87,    85,   110,   117,   118,    91,    71,    92,    44,
+      45,   126,   145,    74,    75,    46,    81,   134,   158,   166,
+     151,    47,    48,   147,    34
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      30,    79,    80,    70,    35,    95,    29,   127,    76,    70,
-      93,    31,   101,    83,    99,    86,    88,    88,    25,    23,
-      32,    52,    53,    54,    55,   102,   103,    56,    57,    36,
-      37,    38,    39,     1,   100,     2,   140,     3,     4,     5,
-      94,    33,     6,    76,    49,    26,    27,    65,    24,   150,
-      40,    50,    86,     7,    72,     8,   159,     9,    93,    82,
-     136,    40,   160,    41,    51,   141,    10,    11,    12,    13,
-      14,    15,    58,    28,    41,    59,    16,   119,   120,   121,
-     104,   105,   106,   107,   108,   -82,   153,    62,   163,   164,
-      60,   122,   123,   124,    61,   130,   131,    40,   113,    63,
-     114,   115,   165,   113,    69,   114,   115,   110,   111,    70,
-     112,   111,   137,   138,   157,   158,   166,   167,   169,   170,
-      64,    66,    67,    68,    73,    40,    90,   128,    96,    97,
-      98,   118,   129,   132,   135,   143,   146,   149,   147,   151,
-     152,   155,    89,   156,   139,   162,   134,    82,    82,   168,
-     145,   126,    77
+      30,    29,    79,    80,    35,    95,   128,    70,    76,    70,
+      23,    93,   101,    83,    25,    86,    88,    88,    99,   164,
+      31,    52,    53,    54,    55,   165,    32,    56,    57,    27,
+      36,    37,    38,    39,   102,   103,   143,    33,   100,    24,
+      94,    26,    40,    76,     1,    49,     2,    65,     3,     4,
+       5,   154,    86,     6,    72,    41,    28,   111,   112,    82,
+      93,   139,    40,    51,     7,    58,     8,   144,     9,    50,
+     104,   105,   106,   107,   108,    41,   -84,    10,    11,    12,
+      13,    14,    15,   120,   121,   122,    59,    16,    60,   109,
+     157,   113,   112,   168,   169,   131,   132,   123,   124,   125,
+      40,   114,    61,   115,   116,   140,   141,   114,   170,   115,
+     116,   162,   163,   171,   172,   174,   175,    62,    63,    64,
+      66,    67,    68,    69,    70,    73,    40,    90,    96,    97,
+      98,   119,   129,   130,   133,   135,   137,   138,   146,   149,
+     152,   150,   153,   155,   156,   159,   136,   160,   161,    89,
+     142,    82,    82,   167,   173,   127,    77,   148
 };
 
 static const yytype_uint8 yycheck[] =
 {
-       4,    61,    62,    24,     8,    74,    47,    96,    59,    24,
-      70,    10,    81,    64,    35,    66,    67,    68,     6,     4,
-      13,    25,    26,    27,    28,    54,    55,    31,    32,    15,
-      16,    17,    18,     3,    55,     5,   125,     7,     8,     9,
-      55,    49,    12,    94,     0,    33,     6,    51,    33,   138,
-      47,    52,   103,    23,    58,    25,     8,    27,   118,    63,
-     111,    47,    14,    60,    13,   125,    36,    37,    38,    39,
-      40,    41,    10,    33,    60,    26,    46,    43,    44,    45,
-      28,    29,    30,    31,    32,    56,   146,    55,   157,   158,
-      53,    57,    58,    59,    53,    99,   100,    47,    48,    13,
-      50,    51,   162,    48,    11,    50,    51,    54,    55,    24,
-      54,    55,    54,    55,   151,   152,   163,   164,   166,   167,
-      56,    53,    53,    53,    47,    47,    53,    22,    57,    54,
-      54,    34,    22,    19,    53,    47,    20,    50,    21,    13,
-      13,    50,    68,    54,   118,    55,   103,   151,   152,   165,
-     129,    94,    60
+       4,    47,    61,    62,     8,    74,    96,    24,    59,    24,
+       4,    70,    81,    64,     6,    66,    67,    68,    35,     8,
+      10,    25,    26,    27,    28,    14,    13,    31,    32,     6,
+      15,    16,    17,    18,    54,    55,   126,    49,    55,    33,
+      55,    33,    47,    94,     3,     0,     5,    51,     7,     8,
+       9,   141,   103,    12,    58,    60,    33,    54,    55,    63,
+     119,   112,    47,    13,    23,    10,    25,   126,    27,    52,
+      28,    29,    30,    31,    32,    60,    56,    36,    37,    38,
+      39,    40,    41,    43,    44,    45,    26,    46,    53,    47,
+     149,    54,    55,   162,   163,    99,   100,    57,    58,    59,
+      47,    48,    53,    50,    51,    54,    55,    48,   167,    50,
+      51,   155,   156,   168,   169,   171,   172,    55,    13,    56,
+      53,    53,    53,    11,    24,    47,    47,    53,    57,    54,
+      54,    34,    22,    22,    19,    47,    53,    53,    47,    20,
+      50,    21,    50,    13,    13,    50,   103,    54,    54,    68,
+     119,   155,   156,    55,   170,    94,    60,   130
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,     3,     5,     7,     8,     9,    12,    23,    25,    27,
@@ -755,53 +782,54 @@ static const yytype_int8 yystos[] =
       24,    78,    92,    47,    84,    85,    93,    86,    70,    80,
       80,    87,    92,    93,    71,    73,    93,    72,    93,    72,
       53,    77,    79,    80,    55,    78,    57,    54,    54,    35,
-      55,    78,    54,    55,    28,    29,    30,    31,    32,    74,
-      54,    55,    54,    48,    50,    51,    75,    76,    34,    43,
-      44,    45,    57,    58,    59,    82,    85,    76,    22,    22,
-      92,    92,    19,    88,    73,    53,    93,    54,    55,    77,
-      76,    80,    83,    47,    94,    94,    20,    21,    91,    50,
-      76,    13,    13,    80,    89,    50,    54,    87,    87,     8,
-      14,    90,    55,    78,    78,    80,    88,    88,    90,    91,
-      91
+      55,    78,    54,    55,    28,    29,    30,    31,    32,    47,
+      74,    54,    55,    54,    48,    50,    51,    75,    76,    34,
+      43,    44,    45,    57,    58,    59,    82,    85,    76,    22,
+      22,    92,    92,    19,    88,    47,    73,    53,    53,    93,
+      54,    55,    77,    76,    80,    83,    47,    94,    94,    20,
+      21,    91,    50,    50,    76,    13,    13,    80,    89,    50,
+      54,    54,    87,    87,     8,    14,    90,    55,    78,    78,
+      80,    88,    88,    90,    91,    91
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    61,    62,    62,    62,    62,    63,    63,    63,    63,
       64,    64,    64,    64,    65,    65,    66,    66,    66,    66,
-      66,    67,    67,    67,    67,    67,    67,    67,    68,    69,
-      69,    69,    70,    71,    71,    72,    72,    73,    74,    74,
-      74,    74,    74,    75,    75,    76,    76,    76,    77,    78,
-      78,    79,    79,    80,    80,    81,    81,    82,    82,    82,
-      82,    82,    82,    83,    83,    84,    84,    85,    86,    86,
-      87,    87,    87,    88,    88,    89,    89,    90,    90,    90,
-      91,    91,    92,    93,    94,    95
+      66,    66,    67,    67,    67,    67,    67,    67,    67,    68,
+      69,    69,    69,    70,    71,    71,    72,    72,    73,    74,
+      74,    74,    74,    74,    74,    75,    75,    76,    76,    76,
+      77,    78,    78,    79,    79,    80,    80,    81,    81,    82,
+      82,    82,    82,    82,    82,    83,    83,    84,    84,    85,
+      86,    86,    87,    87,    87,    88,    88,    89,    89,    90,
+      90,    90,    91,    91,    92,    93,    94,    95
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     2,     4,     6,     3,     2,     6,
-       6,     7,     4,     5,     7,    12,    12,     4,     1,     1,
-       1,     1,     1,     1,     3,     1,     3,     2,     1,     1,
-       4,     1,     1,     1,     3,     1,     1,     1,     3,     0,
-       2,     1,     3,     3,     1,     1,     3,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     3,     3,     1,     1,
-       1,     3,     3,     3,     0,     2,     4,     1,     1,     0,
-       2,     0,     1,     1,     1,     1
+       1,     1,     1,     1,     2,     4,     6,     7,     3,     2,
+       6,     6,     7,     4,     5,     7,    12,    12,     4,     1,
+       1,     1,     1,     1,     1,     3,     1,     3,     2,     1,
+       1,     4,     4,     1,     1,     1,     3,     1,     1,     1,
+       3,     0,     2,     1,     3,     3,     1,     1,     3,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     3,     3,
+       1,     1,     1,     3,     3,     3,     0,     2,     4,     1,
+       1,     0,     2,     0,     1,     1,     1,     1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -823,10 +851,9 @@ static const yytype_int8 yyr2[] =
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -870,12 +897,19 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
@@ -903,24 +937,32 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location); \
+                  Kind, Value, Location); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -931,19 +973,16 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
-  YYUSE (yylocationp);
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -953,14 +992,15 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YY
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyo, *yylocationp);
+  YYLOCATION_PRINT (yyo, yylocationp);
   YYFPRINTF (yyo, ": ");
-  yy_symbol_value_print (yyo, yytype, yyvaluep, yylocationp);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
   YYFPRINTF (yyo, ")");
 }
 
@@ -993,7 +1033,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -1005,9 +1046,9 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]));
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1022,8 +1063,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1046,12 +1087,61 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
 static YYPTRDIFF_T
 yystrlen (const char *yystr)
@@ -1061,13 +1151,13 @@ yystrlen (const char *yystr)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1081,10 +1171,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1099,7 +1189,6 @@ yytnamerr (char *yyres, const char *yystr)
     {
       YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1133,31 +1222,15 @@ yytnamerr (char *yyres, const char *yystr)
   else
     return yystrlen (yystr);
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
   /* Actual size of YYARG. */
   int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1181,52 +1254,54 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1234,17 +1309,23 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1253,7 +1334,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1265,7 +1346,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
@@ -1276,29 +1357,32 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1306,7 +1390,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
 int
 yyparse (void)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1325,55 +1409,50 @@ static YYLTYPE yyloc_default
 YYLTYPE yylloc = yyloc_default;
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    yy_state_fast_t yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYPTRDIFF_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
   YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1381,17 +1460,10 @@ YYLTYPE yylloc = yyloc_default;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
@@ -1414,10 +1486,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1448,7 +1521,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1459,11 +1532,11 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1483,6 +1556,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1503,18 +1577,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, &yylloc);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1586,603 +1672,629 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2:
-#line 59 "yacc.y"
+  case 2: /* start: stmt ';'  */
+#line 60 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1596 "yacc.tab.cpp"
+#line 1682 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 3:
-#line 64 "yacc.y"
+  case 3: /* start: HELP  */
+#line 65 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1605 "yacc.tab.cpp"
+#line 1691 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 4:
-#line 69 "yacc.y"
+  case 4: /* start: EXIT  */
+#line 70 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1614 "yacc.tab.cpp"
+#line 1700 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 5:
-#line 74 "yacc.y"
+  case 5: /* start: T_EOF  */
+#line 75 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1623 "yacc.tab.cpp"
+#line 1709 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 10:
-#line 89 "yacc.y"
+  case 10: /* txnStmt: TXN_BEGIN  */
+#line 90 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1631 "yacc.tab.cpp"
+#line 1717 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 11:
-#line 93 "yacc.y"
+  case 11: /* txnStmt: TXN_COMMIT  */
+#line 94 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1639 "yacc.tab.cpp"
+#line 1725 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 12:
-#line 97 "yacc.y"
+  case 12: /* txnStmt: TXN_ABORT  */
+#line 98 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1647 "yacc.tab.cpp"
+#line 1733 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 13:
-#line 101 "yacc.y"
+  case 13: /* txnStmt: TXN_ROLLBACK  */
+#line 102 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1655 "yacc.tab.cpp"
+#line 1741 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 14:
-#line 108 "yacc.y"
+  case 14: /* dbStmt: SHOW TABLES  */
+#line 109 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1663 "yacc.tab.cpp"
+#line 1749 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 15:
-#line 112 "yacc.y"
+  case 15: /* dbStmt: SHOW INDEX FROM tbName  */
+#line 113 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowIndex>((yyvsp[0].sv_str));
     }
-#line 1671 "yacc.tab.cpp"
+#line 1757 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 16:
-#line 119 "yacc.y"
+  case 16: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
+#line 120 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
     }
-#line 1679 "yacc.tab.cpp"
+#line 1765 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 17: /* ddl: CREATE TABLE tbName '(' fieldList ')' IDENTIFIER  */
+#line 124 "/root/repo/src/parser/yacc.y"
+    {
+        // 表选项，目前只支持compressed，即按页压缩存储
+        if (strcasecmp((yyvsp[0].sv_str).c_str(), "compressed") != 0) {
+            yyerror(&(yylsp[0]), "unknown table option");
+            YYERROR;
+        }
+        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-4].sv_str), (yyvsp[-2].sv_fields), true);
+    }
+#line 1778 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 17:
-#line 123 "yacc.y"
+  case 18: /* ddl: DROP TABLE tbName  */
+#line 133 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1687 "yacc.tab.cpp"
+#line 1786 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 18:
-#line 127 "yacc.y"
+  case 19: /* ddl: DESC tbName  */
+#line 137 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1695 "yacc.tab.cpp"
+#line 1794 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 19:
-#line 131 "yacc.y"
+  case 20: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
+#line 141 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1703 "yacc.tab.cpp"
+#line 1802 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 20:
-#line 135 "yacc.y"
+  case 21: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 145 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1711 "yacc.tab.cpp"
+#line 1810 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 21:
-#line 142 "yacc.y"
+  case 22: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 152 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
     }
-#line 1719 "yacc.tab.cpp"
+#line 1818 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 22:
-#line 146 "yacc.y"
+  case 23: /* dml: DELETE FROM tbName optWhereClause  */
+#line 156 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1727 "yacc.tab.cpp"
+#line 1826 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 23:
-#line 150 "yacc.y"
+  case 24: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 160 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1735 "yacc.tab.cpp"
+#line 1834 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 24:
-#line 154 "yacc.y"
+  case 25: /* dml: SELECT selector FROM tableList optWhereClause opt_order_clause optLimitClause  */
+#line 164 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-5].sv_cols), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds), (yyvsp[-1].sv_orderby),(yyvsp[0].sv_limit));
     }
-#line 1743 "yacc.tab.cpp"
+#line 1842 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 25:
-#line 158 "yacc.y"
+  case 26: /* dml: SELECT countType '(' selector ')' AS asName FROM tableList optWhereClause opt_order_clause optLimitClause  */
+#line 168 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-10].sv_aggtype), (yyvsp[-5].sv_str), (yyvsp[-8].sv_cols), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds));
     }
-#line 1751 "yacc.tab.cpp"
+#line 1850 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 26:
-#line 162 "yacc.y"
+  case 27: /* dml: SELECT aggType '(' singleSelector ')' AS asName FROM tableList optWhereClause opt_order_clause optLimitClause  */
+#line 172 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-10].sv_aggtype), (yyvsp[-5].sv_str), (yyvsp[-8].sv_cols), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds));
     }
-#line 1759 "yacc.tab.cpp"
+#line 1858 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 27:
-#line 166 "yacc.y"
+  case 28: /* dml: LOAD fileName INTO tbName  */
+#line 176 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<LoadData>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 1767 "yacc.tab.cpp"
+#line 1866 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 28:
-#line 173 "yacc.y"
+  case 29: /* countType: COUNT  */
+#line 183 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggtype) = AGGTYPE_COUNT;
     }
-#line 1775 "yacc.tab.cpp"
+#line 1874 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 29:
-#line 179 "yacc.y"
+  case 30: /* aggType: MAX  */
+#line 189 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggtype) = AGGTYPE_MAX;
     }
-#line 1783 "yacc.tab.cpp"
+#line 1882 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 30:
-#line 183 "yacc.y"
+  case 31: /* aggType: MIN  */
+#line 193 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggtype) = AGGTYPE_MIN;
     }
-#line 1791 "yacc.tab.cpp"
+#line 1890 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 31:
-#line 187 "yacc.y"
+  case 32: /* aggType: SUM  */
+#line 197 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggtype) = AGGTYPE_SUM;
     }
-#line 1799 "yacc.tab.cpp"
+#line 1898 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 32:
-#line 193 "yacc.y"
+  case 33: /* singleSelector: col  */
+#line 203 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 1807 "yacc.tab.cpp"
+#line 1906 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 33:
-#line 200 "yacc.y"
+  case 34: /* fieldList: field  */
+#line 210 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1815 "yacc.tab.cpp"
+#line 1914 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 34:
-#line 204 "yacc.y"
+  case 35: /* fieldList: fieldList ',' field  */
+#line 214 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 1823 "yacc.tab.cpp"
+#line 1922 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 35:
-#line 211 "yacc.y"
+  case 36: /* colNameList: colName  */
+#line 221 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 1831 "yacc.tab.cpp"
+#line 1930 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 36:
-#line 215 "yacc.y"
+  case 37: /* colNameList: colNameList ',' colName  */
+#line 225 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 1839 "yacc.tab.cpp"
+#line 1938 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 37:
-#line 222 "yacc.y"
+  case 38: /* field: colName type  */
+#line 232 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 1847 "yacc.tab.cpp"
+#line 1946 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 38:
-#line 229 "yacc.y"
+  case 39: /* type: INT  */
+#line 239 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
     }
-#line 1855 "yacc.tab.cpp"
+#line 1954 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 39:
-#line 233 "yacc.y"
+  case 40: /* type: BIGINT  */
+#line 243 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_BIGINT, sizeof(long long));
     }
-#line 1863 "yacc.tab.cpp"
+#line 1962 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 40:
-#line 237 "yacc.y"
+  case 41: /* type: CHAR '(' VALUE_INT ')'  */
+#line 247 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 1871 "yacc.tab.cpp"
+#line 1970 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 41:
-#line 241 "yacc.y"
+  case 42: /* type: IDENTIFIER '(' VALUE_INT ')'  */
+#line 251 "/root/repo/src/parser/yacc.y"
+    {
+        // VARCHAR不是保留字，按标识符解析
+        if (strcasecmp((yyvsp[-3].sv_str).c_str(), "varchar") != 0) {
+            yyerror(&(yylsp[-3]), "unknown column type");
+            YYERROR;
+        }
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, (yyvsp[-1].sv_int));
+    }
+#line 1983 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 43: /* type: FLOAT  */
+#line 260 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(double));
     }
-#line 1879 "yacc.tab.cpp"
+#line 1991 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 42:
-#line 245 "yacc.y"
+  case 44: /* type: DATETIME  */
+#line 264 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_DATETIME, 8);
     }
-#line 1887 "yacc.tab.cpp"
+#line 1999 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 43:
-#line 253 "yacc.y"
+  case 45: /* valueList: value  */
+#line 272 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 1895 "yacc.tab.cpp"
+#line 2007 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 44:
-#line 257 "yacc.y"
+  case 46: /* valueList: valueList ',' value  */
+#line 276 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 1903 "yacc.tab.cpp"
+#line 2015 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 45:
-#line 264 "yacc.y"
+  case 47: /* value: VALUE_INT  */
+#line 283 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 1911 "yacc.tab.cpp"
+#line 2023 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 46:
-#line 268 "yacc.y"
+  case 48: /* value: VALUE_FLOAT  */
+#line 287 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 1919 "yacc.tab.cpp"
+#line 2031 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 47:
-#line 272 "yacc.y"
+  case 49: /* value: VALUE_STRING  */
+#line 291 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 1927 "yacc.tab.cpp"
+#line 2039 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 48:
-#line 279 "yacc.y"
+  case 50: /* condition: col op expr  */
+#line 298 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 1935 "yacc.tab.cpp"
+#line 2047 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 49:
-#line 285 "yacc.y"
+  case 51: /* optWhereClause: %empty  */
+#line 304 "/root/repo/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 1941 "yacc.tab.cpp"
+#line 2053 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 50:
-#line 287 "yacc.y"
+  case 52: /* optWhereClause: WHERE whereClause  */
+#line 306 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 1949 "yacc.tab.cpp"
+#line 2061 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 51:
-#line 294 "yacc.y"
+  case 53: /* whereClause: condition  */
+#line 313 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 1957 "yacc.tab.cpp"
+#line 2069 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 52:
-#line 298 "yacc.y"
+  case 54: /* whereClause: whereClause AND condition  */
+#line 317 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 1965 "yacc.tab.cpp"
+#line 2077 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 53:
-#line 305 "yacc.y"
+  case 55: /* col: tbName '.' colName  */
+#line 324 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 1973 "yacc.tab.cpp"
+#line 2085 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 54:
-#line 309 "yacc.y"
+  case 56: /* col: colName  */
+#line 328 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
     }
-#line 1981 "yacc.tab.cpp"
+#line 2093 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 55:
-#line 316 "yacc.y"
+  case 57: /* colList: col  */
+#line 335 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 1989 "yacc.tab.cpp"
+#line 2101 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 56:
-#line 320 "yacc.y"
+  case 58: /* colList: colList ',' col  */
+#line 339 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[0].sv_col));
     }
-#line 1997 "yacc.tab.cpp"
+#line 2109 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 57:
-#line 327 "yacc.y"
+  case 59: /* op: '='  */
+#line 346 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_EQ;
     }
-#line 2005 "yacc.tab.cpp"
+#line 2117 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 58:
-#line 331 "yacc.y"
+  case 60: /* op: '<'  */
+#line 350 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LT;
     }
-#line 2013 "yacc.tab.cpp"
+#line 2125 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 59:
-#line 335 "yacc.y"
+  case 61: /* op: '>'  */
+#line 354 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GT;
     }
-#line 2021 "yacc.tab.cpp"
+#line 2133 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 60:
-#line 339 "yacc.y"
+  case 62: /* op: NEQ  */
+#line 358 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_NE;
     }
-#line 2029 "yacc.tab.cpp"
+#line 2141 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 61:
-#line 343 "yacc.y"
+  case 63: /* op: LEQ  */
+#line 362 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LE;
     }
-#line 2037 "yacc.tab.cpp"
+#line 2149 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 62:
-#line 347 "yacc.y"
+  case 64: /* op: GEQ  */
+#line 366 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GE;
     }
-#line 2045 "yacc.tab.cpp"
+#line 2157 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 63:
-#line 354 "yacc.y"
+  case 65: /* expr: value  */
+#line 373 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 2053 "yacc.tab.cpp"
+#line 2165 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 64:
-#line 358 "yacc.y"
+  case 66: /* expr: col  */
+#line 377 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 2061 "yacc.tab.cpp"
+#line 2173 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 65:
-#line 365 "yacc.y"
+  case 67: /* setClauses: setClause  */
+#line 384 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 2069 "yacc.tab.cpp"
+#line 2181 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 66:
-#line 369 "yacc.y"
+  case 68: /* setClauses: setClauses ',' setClause  */
+#line 388 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 2077 "yacc.tab.cpp"
+#line 2189 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 67:
-#line 376 "yacc.y"
+  case 69: /* setClause: colName '=' value  */
+#line 395 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 2085 "yacc.tab.cpp"
+#line 2197 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 68:
-#line 383 "yacc.y"
+  case 70: /* selector: '*'  */
+#line 402 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = {};
     }
-#line 2093 "yacc.tab.cpp"
+#line 2205 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 70:
-#line 391 "yacc.y"
+  case 72: /* tableList: tbName  */
+#line 410 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2101 "yacc.tab.cpp"
+#line 2213 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 71:
-#line 395 "yacc.y"
+  case 73: /* tableList: tableList ',' tbName  */
+#line 414 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2109 "yacc.tab.cpp"
+#line 2221 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 72:
-#line 399 "yacc.y"
+  case 74: /* tableList: tableList JOIN tbName  */
+#line 418 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2117 "yacc.tab.cpp"
+#line 2229 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 73:
-#line 406 "yacc.y"
+  case 75: /* opt_order_clause: ORDER BY order_clause  */
+#line 425 "/root/repo/src/parser/yacc.y"
     { 
         (yyval.sv_orderby) = (yyvsp[0].sv_orderby); 
     }
-#line 2125 "yacc.tab.cpp"
+#line 2237 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 74:
-#line 409 "yacc.y"
+  case 76: /* opt_order_clause: %empty  */
+#line 428 "/root/repo/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 2131 "yacc.tab.cpp"
+#line 2243 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 75:
-#line 414 "yacc.y"
+  case 77: /* order_clause: col opt_asc_desc  */
+#line 433 "/root/repo/src/parser/yacc.y"
     { 
         (yyval.sv_orderby) = std::vector<std::shared_ptr<OrderBy>>();
         (yyval.sv_orderby).push_back(std::make_shared<ast::OrderBy>((yyvsp[-1].sv_col),(yyvsp[0].sv_orderby_dir)));
     }
-#line 2140 "yacc.tab.cpp"
+#line 2252 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 76:
-#line 419 "yacc.y"
+  case 78: /* order_clause: order_clause ',' col opt_asc_desc  */
+#line 438 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_orderby).push_back(std::make_shared<ast::OrderBy>((yyvsp[-1].sv_col),(yyvsp[0].sv_orderby_dir)));
     }
-#line 2148 "yacc.tab.cpp"
+#line 2260 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 77:
-#line 425 "yacc.y"
+  case 79: /* opt_asc_desc: ASC  */
+#line 444 "/root/repo/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_ASC;     }
-#line 2154 "yacc.tab.cpp"
+#line 2266 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 78:
-#line 426 "yacc.y"
+  case 80: /* opt_asc_desc: DESC  */
+#line 445 "/root/repo/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_DESC;    }
-#line 2160 "yacc.tab.cpp"
+#line 2272 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 79:
-#line 427 "yacc.y"
+  case 81: /* opt_asc_desc: %empty  */
+#line 446 "/root/repo/src/parser/yacc.y"
             { (yyval.sv_orderby_dir) = OrderBy_DEFAULT; }
-#line 2166 "yacc.tab.cpp"
+#line 2278 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 80:
-#line 431 "yacc.y"
+  case 82: /* optLimitClause: LIMIT VALUE_INT  */
+#line 450 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_limit)=(yyvsp[0].sv_int);
     }
-#line 2174 "yacc.tab.cpp"
+#line 2286 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 81:
-#line 435 "yacc.y"
+  case 83: /* optLimitClause: %empty  */
+#line 454 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_limit) = 0;
     }
-#line 2182 "yacc.tab.cpp"
+#line 2294 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
 
-#line 2186 "yacc.tab.cpp"
+#line 2298 "/root/repo/src/parser/yacc.tab.cpp"
 
       default: break;
     }
@@ -2197,11 +2309,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2226,50 +2337,45 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (&yylloc, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (&yylloc, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2302,6 +2408,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2318,13 +2425,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2338,7 +2446,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2349,13 +2457,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2366,7 +2472,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2374,24 +2480,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (&yylloc, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2407,18 +2511,17 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 446 "yacc.y"
+
+#line 465 "/root/repo/src/parser/yacc.y"
 
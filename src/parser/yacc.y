@@ -1,6 +1,7 @@
 %{
 #include "ast.h"
 #include "yacc.tab.h"
+#include <strings.h>
 #include <iostream>
 #include <memory>
 
@@ -119,6 +120,15 @@ ddl:
     {
         $$ = std::make_shared<CreateTable>($3, $5);
     }
+    |   CREATE TABLE tbName '(' fieldList ')' IDENTIFIER
+    {
+        // 表选项，目前只支持compressed，即按页压缩存储
+        if (strcasecmp($7.c_str(), "compressed") != 0) {
+            yyerror(&@7, "unknown table option");
+            YYERROR;
+        }
+        $$ = std::make_shared<CreateTable>($3, $5, true);
+    }
     |   DROP TABLE tbName
     {
         $$ = std::make_shared<DropTable>($3);
@@ -237,6 +247,15 @@ type:
     {
         $$ = std::make_shared<TypeLen>(SV_TYPE_STRING, $3);
     }
+    |   IDENTIFIER '(' VALUE_INT ')'
+    {
+        // VARCHAR不是保留字，按标识符解析
+        if (strcasecmp($1.c_str(), "varchar") != 0) {
+            yyerror(&@1, "unknown column type");
+            YYERROR;
+        }
+        $$ = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, $3);
+    }
     |   FLOAT
     {
         $$ = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(double));
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstring>
 
@@ -31,7 +32,7 @@ class Bitmap {
     static bool is_set(const char *bm, int pos) { return (bm[get_bucket(pos)] & get_bit(pos)) != 0; }
 
     /**
-     * @brief 找下一个为0 or 1的位
+     * @brief 找下一个为0 or 1的位，每次检查64位
      * @param bit false表示要找下一个为0的位，true表示要找下一个为1的位
      * @param bm 要找的起始地址为bm
      * @param max_n 要找的从起始地址开始的偏移为[curr+1,max_n)
@@ -39,23 +40,92 @@ class Bitmap {
      * @return 找到了就返回偏移位置，没找到就返回max_n
      */
     static int next_bit(bool bit, const char *bm, int max_n, int curr) {
-        for (int i = curr + 1; i < max_n; i++) {
-            if (is_set(bm, i) == bit) {
-                return i;
+        int pos = curr + 1;
+        if (pos >= max_n) {
+            return max_n;
+        }
+        int num_bytes = get_bucket(max_n - 1) + 1;
+        int byte = get_bucket(pos);
+        uint64_t word = load_word(bm, byte, num_bytes);
+        if (!bit) {
+            word = ~word;
+        }
+        word &= ~0ull >> (pos % BITMAP_WIDTH);  // 去掉pos之前的位
+        while (word == 0) {
+            byte += WORD_BYTES;
+            if (byte >= num_bytes) {
+                return max_n;
             }
+            word = bit ? load_word(bm, byte, num_bytes) : ~load_word(bm, byte, num_bytes);
         }
-        return max_n;
+        // 找0时，bitmap末尾补的0取反后为1，位置不小于max_n
+        return std::min(byte * BITMAP_WIDTH + __builtin_clzll(word), max_n);
     }
 
     // 找第一个为0 or 1的位
     static int first_bit(bool bit, const char *bm, int max_n) { return next_bit(bit, bm, max_n, -1); }
 
+    // [0, max_n)中为1的位的个数
+    static int count(const char *bm, int max_n) {
+        int num_bytes = max_n > 0 ? get_bucket(max_n - 1) + 1 : 0;
+        int n = 0;
+        for (int byte = 0; byte < num_bytes; byte += WORD_BYTES) {
+            uint64_t word = load_word(bm, byte, num_bytes);
+            int rest = max_n - byte * BITMAP_WIDTH;
+            if (rest < 64) {
+                word &= ~(~0ull >> rest);  // 只统计max_n之前的位
+            }
+            n += __builtin_popcountll(word);
+        }
+        return n;
+    }
+
+    /**
+     * @brief 按位置递增的顺序对[0, max_n)中每个为1的位调用f(pos)，每次取出一个字中最高的1
+     */
+    template <typename F>
+    static void for_each_set_bit(const char *bm, int max_n, F &&f) {
+        int num_bytes = max_n > 0 ? get_bucket(max_n - 1) + 1 : 0;
+        for (int byte = 0; byte < num_bytes; byte += WORD_BYTES) {
+            uint64_t word = load_word(bm, byte, num_bytes);
+            while (word != 0) {
+                int lz = __builtin_clzll(word);
+                int pos = byte * BITMAP_WIDTH + lz;
+                if (pos >= max_n) {
+                    return;
+                }
+                f(pos);
+                word ^= HIGHEST_WORD_BIT >> lz;
+            }
+        }
+    }
+
     // for example:
     // rid_.slot_no = Bitmap::next_bit(true, page_handle.bitmap, file_handle_->file_hdr_.num_records_per_page,
     // rid_.slot_no); int slot_no = Bitmap::first_bit(false, page_handle.bitmap, file_hdr_.num_records_per_page);
 
    private:
+    static constexpr int WORD_BYTES = sizeof(uint64_t);
+    static constexpr uint64_t HIGHEST_WORD_BIT = 1ull << 63;
+
     static int get_bucket(int pos) { return pos / BITMAP_WIDTH; }
 
+    /**
+     * @brief 读取从第byte个字节开始的8个字节，不超过num_bytes，不足8个字节时低位补0。
+     * 字节内按位置从高位到低位排列，按大端序读取，使得整个字中位置也从最高位开始递增
+     */
+    static uint64_t load_word(const char *bm, int byte, int num_bytes) {
+        uint64_t word = 0;
+        if (byte + WORD_BYTES <= num_bytes) {
+            memcpy(&word, bm + byte, WORD_BYTES);
+        } else {
+            memcpy(&word, bm + byte, num_bytes - byte);
+        }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        return word;
+    }
+
     static char get_bit(int pos) { return BITMAP_HIGHEST_BIT >> static_cast<char>(pos % BITMAP_WIDTH); }
 };
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 #include <unistd.h>
 
 #include <cassert>
+#include <cstdint>
 #include <list>
 #include <unordered_map>
 #include <vector>
@@ -27,14 +28,27 @@ constexpr int RM_NO_PAGE = -1;
 constexpr int RM_FILE_HDR_PAGE = 0;
 constexpr int RM_FIRST_RECORD_PAGE = 1;
 constexpr int RM_MAX_RECORD_SIZE = 512;
+constexpr int RM_MAX_VAR_COLS = 64;
+constexpr int RM_FILE_VERSION = 1;  // 文件头的格式版本，旧版本的文件头没有version及之后的字段，读出为0
+constexpr int RM_MAX_TUPLE_SIZE = RM_MAX_RECORD_SIZE + 2 * RM_MAX_VAR_COLS;  // slotted page中编码后记录的最大长度
+
+/* 变长字段在记录中的位置，记录在内存中仍按定长格式存放，变长字段占len字节，不足的部分填0 */
+struct RmVarCol {
+    int offset;
+    int len;
+};
 
 /* 文件头，记录表数据文件的元信息，写入磁盘中文件的第0号页面 */
 struct RmFileHdr {
-    int record_size;  // 表中每条记录的大小，由于不包含变长字段，因此当前字段初始化后保持不变
+    int record_size;  // 表中每条记录在内存中的大小，当前字段初始化后保持不变
     int num_pages;             // 文件中分配的页面个数（初始化为1）
     int num_records_per_page;  // 每个页面最多能存储的元组个数
     int first_free_page_no;    // 文件中当前第一个包含空闲空间的页面号（初始化为-1）
     int bitmap_size;           // 每个页面bitmap大小（字节）
+    int version;               // 文件头的格式版本RM_FILE_VERSION
+    int num_allocated_pages;   // 文件中已经用fallocate预分配的页面个数（初始化为1）
+    int num_var_cols;          // 变长字段的个数，大于0时页面按slotted page组织
+    RmVarCol var_cols[RM_MAX_VAR_COLS];  // 变长字段，按offset递增
 };
 
 /* 表数据文件中每个页面的页头，记录每个页面的元信息 */
@@ -43,6 +57,29 @@ struct RmPageHdr {
     int num_records;        // 当前页面中当前已经存储的记录个数（初始化为0）
 };
 
+/**
+ * 有变长字段的表使用slotted page，页面布局为：RmPageHdr | RmSlottedPageHdr | bitmap | 槽目录 | 空闲空间 | 记录区。
+ * 记录去掉变长字段末尾的填充后从页尾向前存放，槽目录中的每一项记录它的位置和长度，记录的Rid即槽号，在页面内移动记录时不变。
+ * bitmap只标记表中的记录所在的槽，从其他页面迁移来的记录所在的槽不标记，扫描时不会重复读到
+ */
+struct RmSlottedPageHdr {
+    int num_slots;       // 槽目录中的槽个数
+    int num_used_slots;  // 存放了数据的槽个数，包括迁移来的记录和迁移走的记录留下的转发地址
+    int data_begin;      // 记录区的起始偏移
+    int live_bytes;      // 记录区中仍在使用的字节数，其余的是删除或移动记录留下的碎片，空间不够时整理
+    int on_free_list;    // 页面是否在空闲页面链表中
+};
+
+/* 槽目录的一项 */
+struct RmSlot {
+    uint16_t offset;  // 记录在页面中的偏移
+    uint16_t len;     // 低14位为记录的长度，为0时槽空闲，高2位为下面的标志
+};
+
+constexpr uint16_t RM_SLOT_FORWARD = 0x8000;  // 记录变长后放不下，已迁移到其他页面，槽中存放新位置的Rid
+constexpr uint16_t RM_SLOT_MOVED = 0x4000;    // 从其他页面迁移来的记录，前面存放它原来位置的Rid
+constexpr uint16_t RM_SLOT_LEN_MASK = 0x3fff;
+
 /* 表中的记录 */
 struct RmRecord {
     char* data;               // 记录的数据
@@ -10,36 +10,69 @@ See the Mulan PSL v2 for more details. */
 
 #include "rm_file_handle.h"
 
+#include <algorithm>
+
+namespace {
+
+/* slotted page中记录实际占用的空间，至少能放下转发用的Rid，使记录迁移走时可以原地改写为转发地址 */
+int alloc_len(int len) { return std::max(len, static_cast<int>(sizeof(Rid))); }
+
+}  // namespace
+
 /**
  * @description: 获取当前表中记录号为rid的记录
  * @param {Rid&} rid 记录号，指定记录的位置
  * @param {Context*} context
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略，扫描中逐条读取记录时传入扫描使用的策略
  * @return {unique_ptr<RmRecord>} rid对应的记录对象指针
  */
-std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid& rid, Context* context) const {
-    // 0. txn, 加行级S锁
-    context->lock_mgr_->lock_shared_on_record(context->txn_, rid, fd_);
+std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid& rid, Context* context,
+                                                   BufferAccessStrategy* strategy) const {
+    // 数据copy到record里之后视图析构，unpin
+    return get_record_view(rid, context, strategy).to_record();
+}
 
-    // 1. 获取指定记录所在的page handle
-    auto page_handle = fetch_page_handle(rid.page_no);
+/**
+ * @description: 获取当前表中记录号为rid的记录的只读视图，不复制记录的数据
+ * @param {Rid&} rid 记录号，指定记录的位置
+ * @param {Context*} context 为nullptr时不加锁
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略，扫描中逐条读取记录时传入扫描使用的策略
+ * @return {RmRecordView} 指向页面中记录的视图，记录所在的页面在视图析构前保持固定
+ */
+RmRecordView RmFileHandle::get_record_view(const Rid& rid, Context* context, BufferAccessStrategy* strategy) const {
+    // 0. txn, 加行级S锁
+    if (context != nullptr) {
+        context->lock_mgr_->lock_shared_on_record(context->txn_, rid, fd_);
+    }
 
-    // 2. 初始化一个指向RmRecord的指针（赋值其内部的data和size）
-    auto record_size = page_handle.file_hdr->record_size;
-    auto record = std::make_unique<RmRecord>(record_size, page_handle.get_slot(rid.slot_no));
-    // 数据已经copy到record里了，unpin
-    bpm_->unpin_page(page_handle.page->get_page_id(), false);
-    return record;
+    // 1. 获取指定记录所在的page handle，由视图负责unpin
+    auto page_handle = fetch_page_handle(rid.page_no, strategy);
+    if (is_varlen()) {
+        // slotted page中的记录解码到视图自己的缓冲区，页面随即unpin
+        auto buf = std::make_unique<char[]>(file_hdr_.record_size);
+        read_record(page_handle, rid.slot_no, buf.get());
+        bpm_->unpin_page(page_handle.page->get_page_id(), false);
+        return RmRecordView(std::move(buf), file_hdr_.record_size);
+    }
+    return RmRecordView(bpm_, page_handle.page, page_handle.get_slot(rid.slot_no), file_hdr_.record_size);
 }
 
 /**
  * @description: 在当前表中插入一条记录，不指定插入位置
  * @param {char*} buf 要插入的记录的数据
  * @param {Context*} context
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略，批量导入时传入
  * @return {Rid} 插入的记录的记录号（位置）
  */
-Rid RmFileHandle::insert_record(char* buf, Context* context) {
+Rid RmFileHandle::insert_record(char* buf, Context* context, BufferAccessStrategy* strategy) {
+    if (is_varlen()) {
+        char tuple[RM_MAX_TUPLE_SIZE];
+        int len = encode_tuple(buf, tuple);
+        return append_tuple(tuple, len, 0, context, strategy);
+    }
+
     // 1. 获取当前未满的page handle
-    auto page_handle = create_page_handle();
+    auto page_handle = create_page_handle(strategy);
 
     // 2. 在page handle中找到空闲slot位置
     auto slot_no = Bitmap::first_bit(false, page_handle.bitmap, file_hdr_.num_records_per_page);
@@ -67,6 +100,75 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
     return rid;
 }
 
+/**
+ * @description: 在当前表中批量追加记录。逐个页面填满空闲slot，每个页面只固定一次；
+ * 没有空闲页面时为剩下的记录一次性预分配所需的全部新页面，再依次创建
+ * @param {char*} bufs 要插入的记录，num_records条记录依次存放，每条长度为record_size
+ * @param {int} num_records 记录条数
+ * @param {Context*} context 为nullptr时不加锁
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略，批量导入时传入
+ * @return {vector<Rid>} 各条记录插入的位置，与bufs中的顺序一致
+ */
+std::vector<Rid> RmFileHandle::insert_records(const char* bufs, int num_records, Context* context,
+                                              BufferAccessStrategy* strategy) {
+    std::vector<Rid> rids;
+    rids.reserve(num_records);
+    if (is_varlen()) {
+        // 变长记录的页面能放下的记录数事先不知道，不预分配，逐个页面放到没有空间为止
+        char tuple[RM_MAX_TUPLE_SIZE];
+        while (static_cast<int>(rids.size()) < num_records) {
+            auto page_handle = create_page_handle(strategy);
+            int page_no = page_handle.page->get_page_id().page_no;
+            do {
+                Rid rid{page_no, find_free_slot(page_handle)};
+                if (context != nullptr) {
+                    context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_);
+                }
+                int len = encode_tuple(bufs + rids.size() * file_hdr_.record_size, tuple);
+                write_tuple(page_handle, rid.slot_no, tuple, len, 0);
+                Bitmap::set(page_handle.bitmap, rid.slot_no);
+                page_handle.page_hdr->num_records++;
+                rids.push_back(rid);
+            } while (static_cast<int>(rids.size()) < num_records && has_room(page_handle));
+            if (!has_room(page_handle)) {
+                pop_free_page(page_handle);
+            }
+            bpm_->unpin_page(page_handle.page->get_page_id(), true);
+        }
+        return rids;
+    }
+    int max_n = file_hdr_.num_records_per_page;
+    while (static_cast<int>(rids.size()) < num_records) {
+        // 1. 没有空闲页面时按剩余记录数一次扩展文件，之后的新页面不再逐个扩展
+        if (file_hdr_.first_free_page_no == RM_NO_PAGE) {
+            int num_new_pages = (num_records - static_cast<int>(rids.size()) + max_n - 1) / max_n;
+            file_hdr_.num_allocated_pages = disk_manager_->preallocate_pages(
+                fd_, file_hdr_.num_pages + num_new_pages - 1, file_hdr_.num_allocated_pages);
+        }
+        auto page_handle = create_page_handle(strategy);
+        int page_no = page_handle.page->get_page_id().page_no;
+
+        // 2. 填满当前页面的空闲slot
+        int slot_no = -1;
+        while (static_cast<int>(rids.size()) < num_records && page_handle.page_hdr->num_records < max_n) {
+            slot_no = Bitmap::next_bit(false, page_handle.bitmap, max_n, slot_no);
+            Rid rid{page_no, slot_no};
+            if (context != nullptr) {
+                context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_);
+            }
+            memcpy(page_handle.get_slot(slot_no), bufs + rids.size() * file_hdr_.record_size, file_hdr_.record_size);
+            Bitmap::set(page_handle.bitmap, slot_no);
+            page_handle.page_hdr->num_records++;
+            rids.push_back(rid);
+        }
+        if (page_handle.page_hdr->num_records == max_n) {
+            file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
+        }
+        bpm_->unpin_page(page_handle.page->get_page_id(), true);
+    }
+    return rids;
+}
+
 /**
  * @description: 在当前表中的指定位置插入一条记录
  * @note 用于rollback delete，避免delete后update+delete回滚时出现的问题
@@ -75,6 +177,11 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
  */
 void RmFileHandle::insert_record(const Rid& rid, char* buf) {
     auto page_handle = fetch_page_handle(rid.page_no);
+    if (is_varlen()) {
+        restore_tuple(page_handle, rid.slot_no, buf);
+        bpm_->unpin_page(page_handle.page->get_page_id(), true);
+        return;
+    }
     auto slot = page_handle.get_slot(rid.slot_no);
     
     if (!Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
@@ -104,6 +211,11 @@ bool RmFileHandle::delete_record(const Rid& rid, Context* context) {
         bpm_->unpin_page(page_handle.page->get_page_id(), false);
         return false;
     }
+    if (is_varlen()) {
+        delete_tuple(page_handle, rid.slot_no);
+        bpm_->unpin_page(page_handle.page->get_page_id(), true);
+        return true;
+    }
     // 2. 更新page_handle.page_hdr中的数据结构
     auto slot = page_handle.get_slot(rid.slot_no);
     memset(slot, 0, page_handle.file_hdr->record_size);
@@ -139,6 +251,11 @@ void RmFileHandle::update_record(const Rid& rid, char* buf, Context* context) {
     }
 
     // 2. 更新记录
+    if (is_varlen()) {
+        update_tuple(page_handle, rid.slot_no, buf);
+        bpm_->unpin_page(page_handle.page->get_page_id(), true);
+        return;
+    }
     auto slot = page_handle.get_slot(rid.slot_no);
     memcpy(slot, buf, page_handle.file_hdr->record_size);
     bpm_->unpin_page(page_handle.page->get_page_id(), true);
@@ -150,33 +267,85 @@ void RmFileHandle::update_record(const Rid& rid, char* buf, Context* context) {
 /**
  * @description: 获取指定页面的页面句柄
  * @param {int} page_no 页面号
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略
  * @return {RmPageHandle} 指定页面的句柄
  */
-RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
+RmPageHandle RmFileHandle::fetch_page_handle(int page_no, BufferAccessStrategy* strategy) const {
     // 使用缓冲池获取指定页面，并生成page_handle返回给上层
     // if page_no is invalid, throw PageNotExistError exception
     PageId page_id = {.fd = fd_, .page_no = page_no};
-    auto page = bpm_->fetch_page(page_id);
+    auto page = bpm_->fetch_page(page_id, strategy);
     return RmPageHandle(&file_hdr_, page);
 }
 
+/**
+ * @description: 批量预取从start_page_no开始的n个页面，超出文件范围的部分被忽略
+ * @param {int} start_page_no 起始页面号
+ * @param {int} n 页面个数
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略
+ * @return {int} 实际发起读取的页面个数
+ */
+int RmFileHandle::prefetch_pages(int start_page_no, int n, BufferAccessStrategy* strategy) const {
+    n = std::min(n, file_hdr_.num_pages - start_page_no);
+    if (n <= 0) {
+        return 0;
+    }
+    return bpm_->fetch_range(fd_, start_page_no, n, strategy);
+}
+
+/**
+ * @description: 把页面中指定slot的记录按定长格式复制到buf。slotted page中的记录先解码，迁移走的记录到新位置读取
+ * @param {RmPageHandle&} page_handle 记录所在的页面，可以是复制出来的页面
+ * @param {int} slot_no 记录的slot号
+ * @param {char*} buf 长度为record_size的缓冲区
+ */
+void RmFileHandle::read_record(const RmPageHandle& page_handle, int slot_no, char* buf) const {
+    if (!is_varlen()) {
+        memcpy(buf, page_handle.get_slot(slot_no), file_hdr_.record_size);
+        return;
+    }
+    if (slot_no >= page_handle.slotted_hdr->num_slots || page_handle.get_slot_entry(slot_no)->len == 0) {
+        memset(buf, 0, file_hdr_.record_size);
+        return;
+    }
+    if (page_handle.get_slot_entry(slot_no)->len & RM_SLOT_FORWARD) {
+        Rid target;
+        memcpy(&target, page_handle.get_tuple(slot_no), sizeof(Rid));
+        auto target_handle = fetch_page_handle(target.page_no);
+        decode_tuple(target_handle.get_tuple(target.slot_no) + sizeof(Rid), buf);
+        bpm_->unpin_page(target_handle.page->get_page_id(), false);
+        return;
+    }
+    decode_tuple(page_handle.get_tuple(slot_no), buf);
+}
+
 /**
  * @description: 创建一个新的page handle
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略
  * @return {RmPageHandle} 新的PageHandle
  */
-RmPageHandle RmFileHandle::create_new_page_handle() {
+RmPageHandle RmFileHandle::create_new_page_handle(BufferAccessStrategy* strategy) {
     // 1.使用缓冲池来创建一个新page
     PageId page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
-    auto page = bpm_->new_page(&page_id);
+    auto page = bpm_->new_page(&page_id, strategy);
 
     // 2.更新page handle中的相关信息
     RmPageHandle page_handle = RmPageHandle(&file_hdr_,page);
     page_handle.page_hdr->num_records = 0;
     page_handle.page_hdr->next_free_page_no = RM_NO_PAGE;
     Bitmap::init(page_handle.bitmap,file_hdr_.bitmap_size);
+    if (page_handle.slotted_hdr != nullptr) {
+        page_handle.slotted_hdr->num_slots = 0;
+        page_handle.slotted_hdr->num_used_slots = 0;
+        page_handle.slotted_hdr->data_begin = PAGE_SIZE;
+        page_handle.slotted_hdr->live_bytes = 0;
+        page_handle.slotted_hdr->on_free_list = 1;
+    }
 
-    // 3.更新file_hdr_
+    // 3.更新file_hdr_，新页面超出已预分配的范围时按extent扩展文件
     file_hdr_.num_pages++;
+    file_hdr_.num_allocated_pages =
+        disk_manager_->preallocate_pages(fd_, page->get_page_id().page_no, file_hdr_.num_allocated_pages);
     // 不需要判断有没有空闲页了，因为这个函数就是在没有空闲页时才被调用的
     file_hdr_.first_free_page_no = page->get_page_id().page_no;
     return page_handle;
@@ -203,18 +372,25 @@ void RmFileHandle::update_page_lsn(int page_no, lsn_t lsn) const {
 /**
  * @brief 创建或获取一个空闲的page handle
  *
+ * @param strategy 缓冲池访问策略
  * @return RmPageHandle 返回生成的空闲page handle
  * @note pin the page, remember to unpin it outside!
  */
-RmPageHandle RmFileHandle::create_page_handle() {
+RmPageHandle RmFileHandle::create_page_handle(BufferAccessStrategy* strategy) {
     // 1. 判断file_hdr_中是否还有空闲页
     //     1.1 没有空闲页：使用缓冲池来创建一个新page；可直接调用create_new_page_handle()
     //     1.2 有空闲页：直接获取第一个空闲页
     // 2. 生成page handle并返回给上层
-    if (file_hdr_.first_free_page_no != RM_NO_PAGE) {
-        return fetch_page_handle(file_hdr_.first_free_page_no);
+    while (file_hdr_.first_free_page_no != RM_NO_PAGE) {
+        auto page_handle = fetch_page_handle(file_hdr_.first_free_page_no, strategy);
+        if (!is_varlen() || has_room(page_handle)) {
+            return page_handle;
+        }
+        // slotted page中的记录原地变长后页面可能已经放不下新记录，此时才从空闲页面链表中摘下
+        pop_free_page(page_handle);
+        bpm_->unpin_page(page_handle.page->get_page_id(), true);
     }
-    return create_new_page_handle();
+    return create_new_page_handle(strategy);
 }
 
 /**
@@ -230,4 +406,347 @@ void RmFileHandle::release_page_handle(RmPageHandle& page_handle) {
     //     page_handle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
     // }
     // file_hdr_.first_free_page_no = page_handle.page->get_page_id().page_no;
+}
+/**
+ * 以下函数用于有变长字段的表的slotted page
+ */
+/**
+ * @description: 把定长格式的记录编码为slotted page中存放的格式：定长字段原样复制，变长字段去掉末尾的0，前面加2字节的长度
+ * @param {char*} buf 定长格式的记录，长度为record_size
+ * @param {char*} tuple 编码后的记录，长度不超过RM_MAX_TUPLE_SIZE
+ * @return {int} 编码后的长度
+ */
+int RmFileHandle::encode_tuple(const char* buf, char* tuple) const {
+    char* out = tuple;
+    int pos = 0;
+    for (int i = 0; i < file_hdr_.num_var_cols; i++) {
+        auto& var_col = file_hdr_.var_cols[i];
+        memcpy(out, buf + pos, var_col.offset - pos);
+        out += var_col.offset - pos;
+        uint16_t len = strnlen(buf + var_col.offset, var_col.len);
+        memcpy(out, &len, sizeof(len));
+        memcpy(out + sizeof(len), buf + var_col.offset, len);
+        out += sizeof(len) + len;
+        pos = var_col.offset + var_col.len;
+    }
+    memcpy(out, buf + pos, file_hdr_.record_size - pos);
+    out += file_hdr_.record_size - pos;
+    return static_cast<int>(out - tuple);
+}
+
+/**
+ * @description: 把slotted page中的记录解码为定长格式，变长字段不足的部分填0
+ */
+void RmFileHandle::decode_tuple(const char* tuple, char* buf) const {
+    int pos = 0;
+    for (int i = 0; i < file_hdr_.num_var_cols; i++) {
+        auto& var_col = file_hdr_.var_cols[i];
+        memcpy(buf + pos, tuple, var_col.offset - pos);
+        tuple += var_col.offset - pos;
+        uint16_t len;
+        memcpy(&len, tuple, sizeof(len));
+        memcpy(buf + var_col.offset, tuple + sizeof(len), len);
+        memset(buf + var_col.offset + len, 0, var_col.len - len);
+        tuple += sizeof(len) + len;
+        pos = var_col.offset + var_col.len;
+    }
+    memcpy(buf + pos, tuple, file_hdr_.record_size - pos);
+}
+
+/**
+ * @description: 页面中除槽目录和存放的记录之外的空间，包括碎片
+ */
+int RmFileHandle::free_bytes(const RmPageHandle& page_handle) const {
+    int dir_end = static_cast<int>(page_handle.slots - page_handle.page->get_data()) +
+                  page_handle.slotted_hdr->num_slots * static_cast<int>(sizeof(RmSlot));
+    return PAGE_SIZE - dir_end - page_handle.slotted_hdr->live_bytes;
+}
+
+/**
+ * @description: 页面是否一定能放下一条新记录，即有空闲的槽，空闲空间能放下最长的记录和一个新的槽目录项
+ */
+bool RmFileHandle::has_room(const RmPageHandle& page_handle) const {
+    auto slotted_hdr = page_handle.slotted_hdr;
+    // 迁移来的记录前面多存放原来的位置
+    int max_len = static_cast<int>(sizeof(Rid)) + file_hdr_.record_size +
+                  static_cast<int>(sizeof(uint16_t)) * file_hdr_.num_var_cols;
+    return (slotted_hdr->num_used_slots < slotted_hdr->num_slots ||
+            slotted_hdr->num_slots < file_hdr_.num_records_per_page) &&
+           free_bytes(page_handle) >= alloc_len(max_len) + static_cast<int>(sizeof(RmSlot));
+}
+
+/**
+ * @description: 找到页面中第一个空闲的槽，没有时返回槽目录的下一项
+ */
+int RmFileHandle::find_free_slot(const RmPageHandle& page_handle) const {
+    auto slotted_hdr = page_handle.slotted_hdr;
+    if (slotted_hdr->num_used_slots == slotted_hdr->num_slots) {
+        return slotted_hdr->num_slots;
+    }
+    for (int slot_no = 0; slot_no < slotted_hdr->num_slots; slot_no++) {
+        if (page_handle.get_slot_entry(slot_no)->len == 0) {
+            return slot_no;
+        }
+    }
+    return slotted_hdr->num_slots;
+}
+
+/**
+ * @description: 在记录区为空闲的槽分配空间，连续的空闲空间不够时先整理页面，调用者需保证页面的空闲空间足够
+ * @param {int} slot_no 槽号，超出槽目录时扩展槽目录
+ * @param {int} len 记录的长度
+ * @param {uint16_t} flags 槽的标志
+ * @return {char*} 分配的空间
+ */
+char* RmFileHandle::alloc_tuple(RmPageHandle& page_handle, int slot_no, int len, uint16_t flags) {
+    auto slotted_hdr = page_handle.slotted_hdr;
+    int num_slots = std::max(slotted_hdr->num_slots, slot_no + 1);
+    int dir_end = static_cast<int>(page_handle.slots - page_handle.page->get_data()) +
+                  num_slots * static_cast<int>(sizeof(RmSlot));
+    if (slotted_hdr->data_begin - dir_end < alloc_len(len)) {
+        compact_page(page_handle);
+    }
+    for (int i = slotted_hdr->num_slots; i < num_slots; i++) {
+        *page_handle.get_slot_entry(i) = RmSlot{0, 0};
+    }
+    slotted_hdr->num_slots = num_slots;
+    slotted_hdr->data_begin -= alloc_len(len);
+    slotted_hdr->live_bytes += alloc_len(len);
+    slotted_hdr->num_used_slots++;
+    *page_handle.get_slot_entry(slot_no) =
+        RmSlot{static_cast<uint16_t>(slotted_hdr->data_begin), static_cast<uint16_t>(len | flags)};
+    return page_handle.get_tuple(slot_no);
+}
+
+/**
+ * @description: 释放槽中存放的数据，槽目录末尾的空闲槽一并去掉
+ */
+void RmFileHandle::free_tuple(RmPageHandle& page_handle, int slot_no) {
+    auto slotted_hdr = page_handle.slotted_hdr;
+    RmSlot* entry = page_handle.get_slot_entry(slot_no);
+    int len = alloc_len(entry->len & RM_SLOT_LEN_MASK);
+    slotted_hdr->live_bytes -= len;
+    if (entry->offset == slotted_hdr->data_begin) {
+        slotted_hdr->data_begin += len;
+    }
+    *entry = RmSlot{0, 0};
+    slotted_hdr->num_used_slots--;
+    while (slotted_hdr->num_slots > 0 && page_handle.get_slot_entry(slotted_hdr->num_slots - 1)->len == 0) {
+        slotted_hdr->num_slots--;
+    }
+}
+
+/**
+ * @description: 整理页面，把存放的记录依次移到页尾，消除碎片。记录的槽号不变
+ */
+void RmFileHandle::compact_page(RmPageHandle& page_handle) {
+    char copy[PAGE_SIZE];
+    char* data = page_handle.page->get_data();
+    memcpy(copy, data, PAGE_SIZE);
+    int end = PAGE_SIZE;
+    for (int slot_no = 0; slot_no < page_handle.slotted_hdr->num_slots; slot_no++) {
+        RmSlot* entry = page_handle.get_slot_entry(slot_no);
+        if (entry->len != 0) {
+            int len = alloc_len(entry->len & RM_SLOT_LEN_MASK);
+            end -= len;
+            memcpy(data + end, copy + entry->offset, len);
+            entry->offset = static_cast<uint16_t>(end);
+        }
+    }
+    page_handle.slotted_hdr->data_begin = end;
+    page_handle.slotted_hdr->live_bytes = PAGE_SIZE - end;
+}
+
+/**
+ * @description: 把编码后的记录写入页面中的指定槽，槽中原有数据时替换。变短时原地覆盖，变长时在页面中重新分配
+ * @return {bool} 页面空间不够时返回false，页面不变
+ */
+bool RmFileHandle::write_tuple(RmPageHandle& page_handle, int slot_no, const char* tuple, int len, uint16_t flags) {
+    auto slotted_hdr = page_handle.slotted_hdr;
+    if (slot_no < slotted_hdr->num_slots && page_handle.get_slot_entry(slot_no)->len != 0) {
+        RmSlot* entry = page_handle.get_slot_entry(slot_no);
+        int old_len = alloc_len(entry->len & RM_SLOT_LEN_MASK);
+        if (alloc_len(len) <= old_len) {
+            memcpy(page_handle.get_tuple(slot_no), tuple, len);
+            entry->len = static_cast<uint16_t>(len | flags);
+            slotted_hdr->live_bytes -= old_len - alloc_len(len);
+            return true;
+        }
+        if (free_bytes(page_handle) + old_len < alloc_len(len)) {
+            return false;
+        }
+        free_tuple(page_handle, slot_no);
+    } else {
+        int new_slots = std::max(0, slot_no + 1 - slotted_hdr->num_slots);
+        if (free_bytes(page_handle) - new_slots * static_cast<int>(sizeof(RmSlot)) < alloc_len(len)) {
+            return false;
+        }
+    }
+    memcpy(alloc_tuple(page_handle, slot_no, len, flags), tuple, len);
+    return true;
+}
+
+/**
+ * @description: 把编码后的记录放到空闲页面链表中的第一个页面
+ * @param {uint16_t} flags 为RM_SLOT_MOVED时是从其他页面迁移来的记录，前面是原来的位置，不标记bitmap，也不加锁
+ * @return {Rid} 记录存放的位置
+ */
+Rid RmFileHandle::append_tuple(const char* tuple, int len, uint16_t flags, Context* context,
+                               BufferAccessStrategy* strategy) {
+    auto page_handle = create_page_handle(strategy);
+    Rid rid{page_handle.page->get_page_id().page_no, find_free_slot(page_handle)};
+    if (context != nullptr && flags == 0) {
+        context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_);
+    }
+    write_tuple(page_handle, rid.slot_no, tuple, len, flags);
+    if (flags == 0) {
+        Bitmap::set(page_handle.bitmap, rid.slot_no);
+        page_handle.page_hdr->num_records++;
+    }
+    if (!has_room(page_handle)) {
+        pop_free_page(page_handle);
+    }
+    bpm_->unpin_page(page_handle.page->get_page_id(), true);
+    return rid;
+}
+
+/**
+ * @description: 在指定的槽放回一条记录，用于回滚delete。槽中是表中的记录时不做任何事，与定长记录的insert_record一致；
+ * 槽被迁移来的记录占用时先把它移走。页面放不下时记录迁移到其他页面，槽中只留转发地址
+ */
+void RmFileHandle::restore_tuple(RmPageHandle& page_handle, int slot_no, const char* buf) {
+    if (Bitmap::is_set(page_handle.bitmap, slot_no)) {
+        return;
+    }
+    if (slot_no < page_handle.slotted_hdr->num_slots && page_handle.get_slot_entry(slot_no)->len != 0) {
+        relocate_moved_tuple(page_handle, slot_no);
+    }
+    Rid rid{page_handle.page->get_page_id().page_no, slot_no};
+    char tuple[sizeof(Rid) + RM_MAX_TUPLE_SIZE];
+    memcpy(tuple, &rid, sizeof(Rid));
+    int len = encode_tuple(buf, tuple + sizeof(Rid));
+    if (!write_tuple(page_handle, slot_no, tuple + sizeof(Rid), len, 0)) {
+        // 删除之后页面中的其他记录可能已经占满了空间，连转发地址也放不下时把其他记录迁移走
+        int new_slots = std::max(0, slot_no + 1 - page_handle.slotted_hdr->num_slots);
+        make_room(page_handle, new_slots * static_cast<int>(sizeof(RmSlot)) + alloc_len(0));
+        Rid target = append_tuple(tuple, sizeof(Rid) + len, RM_SLOT_MOVED, nullptr, nullptr);
+        write_tuple(page_handle, slot_no, reinterpret_cast<const char*>(&target), sizeof(Rid), RM_SLOT_FORWARD);
+    }
+    Bitmap::set(page_handle.bitmap, slot_no);
+    page_handle.page_hdr->num_records++;
+}
+
+/**
+ * @description: 把槽中迁移来的记录移到其他位置，并修改它原来位置的转发地址，空出这个槽
+ */
+void RmFileHandle::relocate_moved_tuple(RmPageHandle& page_handle, int slot_no) {
+    char tuple[sizeof(Rid) + RM_MAX_TUPLE_SIZE];
+    int len = page_handle.get_slot_entry(slot_no)->len & RM_SLOT_LEN_MASK;
+    memcpy(tuple, page_handle.get_tuple(slot_no), len);
+    // 先放到新位置再释放，新位置不会是这个槽
+    Rid target = append_tuple(tuple, len, RM_SLOT_MOVED, nullptr, nullptr);
+    Rid home;
+    memcpy(&home, tuple, sizeof(Rid));
+    auto home_handle = fetch_page_handle(home.page_no);
+    memcpy(home_handle.get_tuple(home.slot_no), &target, sizeof(Rid));
+    bpm_->unpin_page(home_handle.page->get_page_id(), true);
+    free_tuple(page_handle, slot_no);
+}
+
+/**
+ * @description: 把页面中的记录迁移到其他页面，直到空闲空间不少于need字节。先移走迁移来的记录，
+ * 不够时再把表中的记录迁移走，只留转发地址；所有槽都只存放转发地址时页面一定放得下，因此总能腾出空间
+ */
+void RmFileHandle::make_room(RmPageHandle& page_handle, int need) {
+    for (uint16_t flag : {RM_SLOT_MOVED, static_cast<uint16_t>(0)}) {
+        for (int slot_no = 0; slot_no < page_handle.slotted_hdr->num_slots && free_bytes(page_handle) < need;
+             slot_no++) {
+            uint16_t len = page_handle.get_slot_entry(slot_no)->len;
+            if (len == 0 || (len & ~RM_SLOT_LEN_MASK) != flag) {
+                continue;
+            }
+            if (flag == RM_SLOT_MOVED) {
+                relocate_moved_tuple(page_handle, slot_no);
+                continue;
+            }
+            if (alloc_len(len) == alloc_len(0)) {
+                continue;
+            }
+            Rid rid{page_handle.page->get_page_id().page_no, slot_no};
+            char tuple[sizeof(Rid) + RM_MAX_TUPLE_SIZE];
+            memcpy(tuple, &rid, sizeof(Rid));
+            memcpy(tuple + sizeof(Rid), page_handle.get_tuple(slot_no), len);
+            Rid target = append_tuple(tuple, sizeof(Rid) + len, RM_SLOT_MOVED, nullptr, nullptr);
+            write_tuple(page_handle, slot_no, reinterpret_cast<const char*>(&target), sizeof(Rid), RM_SLOT_FORWARD);
+        }
+    }
+}
+
+/**
+ * @description: 更新槽中的记录。页面放不下变长后的记录时把它迁移到其他页面，槽中只留转发地址，记录的Rid不变；
+ * 已经迁移走的记录先尝试在新位置更新，放不下时再尝试放回原来的页面，转发最多一跳
+ */
+void RmFileHandle::update_tuple(RmPageHandle& page_handle, int slot_no, const char* buf) {
+    // 迁移走的记录前面加上原来的位置
+    Rid rid{page_handle.page->get_page_id().page_no, slot_no};
+    char tuple[sizeof(Rid) + RM_MAX_TUPLE_SIZE];
+    memcpy(tuple, &rid, sizeof(Rid));
+    int len = encode_tuple(buf, tuple + sizeof(Rid));
+    if (page_handle.get_slot_entry(slot_no)->len & RM_SLOT_FORWARD) {
+        Rid target;
+        memcpy(&target, page_handle.get_tuple(slot_no), sizeof(Rid));
+        auto target_handle = fetch_page_handle(target.page_no);
+        bool written = write_tuple(target_handle, target.slot_no, tuple, sizeof(Rid) + len, RM_SLOT_MOVED);
+        if (!written) {
+            free_tuple(target_handle, target.slot_no);
+            push_free_page(target_handle);
+        }
+        bpm_->unpin_page(target_handle.page->get_page_id(), true);
+        if (written) {
+            return;
+        }
+    }
+    if (!write_tuple(page_handle, slot_no, tuple + sizeof(Rid), len, 0)) {
+        // 原来的槽至少占alloc_len(0)字节，一定能原地改写为转发地址
+        Rid target = append_tuple(tuple, sizeof(Rid) + len, RM_SLOT_MOVED, nullptr, nullptr);
+        write_tuple(page_handle, slot_no, reinterpret_cast<const char*>(&target), sizeof(Rid), RM_SLOT_FORWARD);
+    }
+    push_free_page(page_handle);
+}
+
+/**
+ * @description: 删除槽中的记录，迁移走的记录在新位置一并删除
+ */
+void RmFileHandle::delete_tuple(RmPageHandle& page_handle, int slot_no) {
+    if (page_handle.get_slot_entry(slot_no)->len & RM_SLOT_FORWARD) {
+        Rid target;
+        memcpy(&target, page_handle.get_tuple(slot_no), sizeof(Rid));
+        auto target_handle = fetch_page_handle(target.page_no);
+        free_tuple(target_handle, target.slot_no);
+        push_free_page(target_handle);
+        bpm_->unpin_page(target_handle.page->get_page_id(), true);
+    }
+    free_tuple(page_handle, slot_no);
+    Bitmap::reset(page_handle.bitmap, slot_no);
+    page_handle.page_hdr->num_records--;
+    push_free_page(page_handle);
+}
+
+/**
+ * @description: 把空闲页面链表的第一个页面从链表中摘下，调用者需保证page_handle就是该页面
+ */
+void RmFileHandle::pop_free_page(RmPageHandle& page_handle) {
+    assert(file_hdr_.first_free_page_no == page_handle.page->get_page_id().page_no);
+    file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
+    page_handle.slotted_hdr->on_free_list = 0;
+}
+
+/**
+ * @description: 页面不在空闲页面链表中、删除或更新记录后又能放下新记录时，把它放回链表头部
+ */
+void RmFileHandle::push_free_page(RmPageHandle& page_handle) {
+    if (!page_handle.slotted_hdr->on_free_list && has_room(page_handle)) {
+        release_page_handle(page_handle);
+        page_handle.slotted_hdr->on_free_list = 1;
+    }
 }
\ No newline at end of file
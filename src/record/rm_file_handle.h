@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 #include <assert.h>
 
 #include <memory>
+#include <vector>
 
 #include "bitmap.h"
 #include "common/context.h"
@@ -25,12 +26,18 @@ struct RmPageHandle {
     const RmFileHdr *file_hdr;  // 当前页面所在文件的文件头指针
     Page *page;                 // 页面的实际数据，包括页面存储的数据、元信息等
     RmPageHdr *page_hdr;  // page->data的第一部分，存储页面元信息，指针指向首地址，长度为sizeof(RmPageHdr)
+    RmSlottedPageHdr *slotted_hdr;  // slotted page紧跟在page_hdr之后的页头，定长记录的页面为nullptr
     char *bitmap;  // page->data的第二部分，存储页面的bitmap，指针指向首地址，长度为file_hdr->bitmap_size
-    char *slots;  // page->data的第三部分，存储表的记录，指针指向首地址，每个slot的长度为file_hdr->record_size
+    char *slots;  // page->data的第三部分，存储表的记录，指针指向首地址，每个slot的长度为file_hdr->record_size；slotted page中为槽目录
 
     RmPageHandle(const RmFileHdr *fhdr_, Page *page_) : file_hdr(fhdr_), page(page_) {
         page_hdr = reinterpret_cast<RmPageHdr *>(page->get_data() + page->OFFSET_PAGE_HDR);
         bitmap = page->get_data() + sizeof(RmPageHdr) + page->OFFSET_PAGE_HDR;
+        slotted_hdr = nullptr;
+        if (file_hdr->num_var_cols > 0) {
+            slotted_hdr = reinterpret_cast<RmSlottedPageHdr *>(bitmap);
+            bitmap += sizeof(RmSlottedPageHdr);
+        }
         slots = bitmap + file_hdr->bitmap_size;
     }
 
@@ -38,11 +45,86 @@ struct RmPageHandle {
     char *get_slot(int slot_no) const {
         return slots + slot_no * file_hdr->record_size;  // slots的首地址 + slot个数 * 每个slot的大小(每个record的大小)
     }
+
+    // slotted page中指定slot_no的槽目录项
+    RmSlot *get_slot_entry(int slot_no) const { return reinterpret_cast<RmSlot *>(slots) + slot_no; }
+
+    // slotted page中指定slot_no的槽存放的数据
+    char *get_tuple(int slot_no) const { return page->get_data() + get_slot_entry(slot_no)->offset; }
+};
+
+/**
+ * @description: 记录的只读视图，直接指向缓冲池中被固定的页面里的slot，读取记录时不复制数据，视图析构时unpin页面。
+ * 视图存在期间页面不会被换出，扫描和谓词求值时只在处理当前记录期间持有；
+ * 需要在unpin之后继续使用的记录（排序缓冲区、连接的build侧等）用to_record()复制出来。
+ * slotted page中的记录需要先解码，视图持有解码后的记录，不固定页面
+ */
+class RmRecordView {
+   public:
+    RmRecordView() = default;
+
+    RmRecordView(BufferPoolManager *bpm, Page *page, const char *data, int size)
+        : bpm_(bpm), page_(page), data_(data), size_(size) {}
+
+    RmRecordView(std::unique_ptr<char[]> buf, int size) : buf_(std::move(buf)), data_(buf_.get()), size_(size) {}
+
+    RmRecordView(RmRecordView &&other) noexcept
+        : bpm_(other.bpm_), page_(other.page_), buf_(std::move(other.buf_)), data_(other.data_), size_(other.size_) {
+        other.page_ = nullptr;
+        other.data_ = nullptr;
+    }
+
+    RmRecordView &operator=(RmRecordView &&other) noexcept {
+        if (this != &other) {
+            release();
+            bpm_ = other.bpm_;
+            page_ = other.page_;
+            buf_ = std::move(other.buf_);
+            data_ = other.data_;
+            size_ = other.size_;
+            other.page_ = nullptr;
+            other.data_ = nullptr;
+        }
+        return *this;
+    }
+
+    RmRecordView(const RmRecordView &) = delete;
+    RmRecordView &operator=(const RmRecordView &) = delete;
+
+    ~RmRecordView() { release(); }
+
+    /* 是否指向一条记录 */
+    bool valid() const { return data_ != nullptr; }
+
+    const char *data() const { return data_; }
+
+    int size() const { return size_; }
+
+    /* 把记录复制到新分配的RmRecord中，复制出的记录不依赖页面的固定 */
+    std::unique_ptr<RmRecord> to_record() const { return std::make_unique<RmRecord>(size_, const_cast<char *>(data_)); }
+
+    /* 提前unpin页面，之后视图不再指向任何记录 */
+    void release() {
+        if (page_ != nullptr) {
+            bpm_->unpin_page(page_->get_page_id(), false);
+            page_ = nullptr;
+        }
+        buf_.reset();
+        data_ = nullptr;
+    }
+
+   private:
+    BufferPoolManager *bpm_ = nullptr;
+    Page *page_ = nullptr;         // 被固定的页面
+    std::unique_ptr<char[]> buf_;  // 解码后的记录，视图直接指向页面时为nullptr
+    const char *data_ = nullptr;   // 为nullptr时视图为空
+    int size_ = 0;
 };
 
 /* 每个RmFileHandle对应一个表的数据文件，里面有多个page，每个page的数据封装在RmPageHandle中 */
 class RmFileHandle {
     friend class RmScan;
+    friend class RmBatchScan;
     friend class BlockBufferManager;
     friend class RmManager;
 
@@ -57,8 +139,18 @@ class RmFileHandle {
         : disk_manager_(disk_manager), bpm_(buffer_pool_manager), fd_(fd) {
         // 注意：这里从磁盘中读出文件描述符为fd的文件的file_hdr，读到内存中
         // 这里实际就是初始化file_hdr，只不过是从磁盘中读出进行初始化
-        // init file_hdr_
-        disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
+        // init file_hdr_。旧版本的文件头较短，之后的字节从未写入过，文件可能只有文件头那么长
+        int file_size = disk_manager_->get_file_size(disk_manager_->get_file_name(fd));
+        file_hdr_ = {};
+        disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr_,
+                                 std::min(file_size, static_cast<int>(sizeof(file_hdr_))));
+        if (file_hdr_.version == 0) {
+            // 旧版本的文件头没有记录预分配的页面个数，文件中已有的页面都已分配；关闭时按新格式写回
+            file_hdr_ = {file_hdr_.record_size, file_hdr_.num_pages, file_hdr_.num_records_per_page,
+                         file_hdr_.first_free_page_no, file_hdr_.bitmap_size};
+            file_hdr_.version = RM_FILE_VERSION;
+            file_hdr_.num_allocated_pages = std::max(1, file_size / PAGE_SIZE);
+        }
         // disk_manager管理的fd对应的文件中，设置从file_hdr_.num_pages开始分配page_no
         disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
     }
@@ -66,30 +158,88 @@ class RmFileHandle {
     RmFileHdr get_file_hdr() { return file_hdr_; }
     int GetFd() { return fd_; }
 
+    /* 页面是否按slotted page组织，存放变长记录 */
+    bool is_varlen() const { return file_hdr_.num_var_cols > 0; }
+
     /* 判断指定位置上是否已经存在一条记录，通过Bitmap来判断 */
     bool is_record(const Rid &rid) const {
         RmPageHandle page_handle = fetch_page_handle(rid.page_no);
         return Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
     }
 
-    std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context) const;
+    std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context,
+                                         BufferAccessStrategy *strategy = nullptr) const;
+
+    RmRecordView get_record_view(const Rid &rid, Context *context, BufferAccessStrategy *strategy = nullptr) const;
 
-    Rid insert_record(char *buf, Context *context);
+    Rid insert_record(char *buf, Context *context, BufferAccessStrategy *strategy = nullptr);
 
     void insert_record(const Rid &rid, char *buf);
 
+    std::vector<Rid> insert_records(const char *bufs, int num_records, Context *context,
+                                    BufferAccessStrategy *strategy = nullptr);
+
     bool delete_record(const Rid &rid, Context *context);
 
     void update_record(const Rid &rid, char *buf, Context *context);
 
-    RmPageHandle create_new_page_handle();
+    RmPageHandle create_new_page_handle(BufferAccessStrategy *strategy = nullptr);
 
-    RmPageHandle fetch_page_handle(int page_no) const;
+    RmPageHandle fetch_page_handle(int page_no, BufferAccessStrategy *strategy = nullptr) const;
 
     void update_page_lsn(int page_no, lsn_t lsn) const;
 
+    int prefetch_pages(int start_page_no, int n, BufferAccessStrategy *strategy = nullptr) const;
+
+    void read_record(const RmPageHandle &page_handle, int slot_no, char *buf) const;
+
+    /* 顺序扫描整个表时使用的缓冲池访问策略，表较小时为nullptr；repeated表示表会被反复扫描 */
+    std::unique_ptr<BufferAccessStrategy> create_scan_strategy(bool repeated = false) const {
+        return bpm_->create_scan_strategy(file_hdr_.num_pages, repeated);
+    }
+
+    /* 批量导入时使用的缓冲池访问策略 */
+    std::unique_ptr<BufferAccessStrategy> create_bulk_write_strategy() const {
+        return bpm_->create_access_strategy(BULK_WRITE_RING_PAGES);
+    }
+
    private:
-    RmPageHandle create_page_handle();
+    RmPageHandle create_page_handle(BufferAccessStrategy *strategy = nullptr);
 
     void release_page_handle(RmPageHandle &page_handle);
+
+    // 以下用于slotted page
+    int encode_tuple(const char *buf, char *tuple) const;
+
+    void decode_tuple(const char *tuple, char *buf) const;
+
+    int free_bytes(const RmPageHandle &page_handle) const;
+
+    bool has_room(const RmPageHandle &page_handle) const;
+
+    int find_free_slot(const RmPageHandle &page_handle) const;
+
+    char *alloc_tuple(RmPageHandle &page_handle, int slot_no, int len, uint16_t flags);
+
+    void free_tuple(RmPageHandle &page_handle, int slot_no);
+
+    void compact_page(RmPageHandle &page_handle);
+
+    bool write_tuple(RmPageHandle &page_handle, int slot_no, const char *tuple, int len, uint16_t flags);
+
+    Rid append_tuple(const char *tuple, int len, uint16_t flags, Context *context, BufferAccessStrategy *strategy);
+
+    void restore_tuple(RmPageHandle &page_handle, int slot_no, const char *buf);
+
+    void relocate_moved_tuple(RmPageHandle &page_handle, int slot_no);
+
+    void make_room(RmPageHandle &page_handle, int need);
+
+    void update_tuple(RmPageHandle &page_handle, int slot_no, const char *buf);
+
+    void delete_tuple(RmPageHandle &page_handle, int slot_no);
+
+    void pop_free_page(RmPageHandle &page_handle);
+
+    void push_free_page(RmPageHandle &page_handle);
 };
\ No newline at end of file
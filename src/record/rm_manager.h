@@ -30,23 +30,48 @@ class RmManager {
      * @description: 创建表的数据文件并初始化相关信息
      * @param {string&} filename 要创建的文件名称
      * @param {int} record_size 表中记录的大小
+     * @param {bool} compressed 是否按页压缩存储，压缩在DiskManager读写页面时完成，对上层透明
+     * @param {vector<RmVarCol>&} var_cols 变长字段，按offset递增，不为空时页面按slotted page组织
      */ 
-    void create_file(const std::string& filename, int record_size) {
+    void create_file(const std::string& filename, int record_size, bool compressed = false,
+                     const std::vector<RmVarCol>& var_cols = {}) {
         if (record_size < 1 || record_size > RM_MAX_RECORD_SIZE) {
             throw InvalidRecordSizeError(record_size);
         }
-        disk_manager_->create_file(filename);
+        if (var_cols.size() > RM_MAX_VAR_COLS) {
+            throw InternalError("Too many varchar columns");
+        }
+        disk_manager_->create_file(filename, compressed);
         int fd = disk_manager_->open_file(filename);
 
         // 初始化file header
         RmFileHdr file_hdr{};
         file_hdr.record_size = record_size;
+        file_hdr.version = RM_FILE_VERSION;
         file_hdr.num_pages = 1;
+        file_hdr.num_allocated_pages = 1;
         file_hdr.first_free_page_no = RM_NO_PAGE;
-        // We have: sizeof(hdr) + (n + 7) / 8 + n * record_size <= PAGE_SIZE
+        file_hdr.num_var_cols = static_cast<int>(var_cols.size());
+        std::copy(var_cols.begin(), var_cols.end(), file_hdr.var_cols);
+        int hdr_size = Page::OFFSET_PAGE_HDR + (int)sizeof(RmPageHdr);
+        int slot_size = record_size;
+        if (!var_cols.empty()) {
+            // slotted page中每个槽至少占一个槽目录项和变长字段都为空时的记录长度，记录区至少能放下转发用的Rid；
+            // 槽目录按4字节对齐，bitmap最多多占3个字节
+            int min_len = record_size + (int)sizeof(uint16_t) * file_hdr.num_var_cols;
+            for (auto& var_col : var_cols) {
+                min_len -= var_col.len;
+            }
+            hdr_size += (int)sizeof(RmSlottedPageHdr) + 3;
+            slot_size = (int)sizeof(RmSlot) + std::max(min_len, (int)sizeof(Rid));
+        }
+        // We have: sizeof(hdr) + (n + 7) / 8 + n * slot_size <= PAGE_SIZE
         file_hdr.num_records_per_page =
-            (BITMAP_WIDTH * (PAGE_SIZE - 1 - (int)sizeof(RmFileHdr)) + 1) / (1 + record_size * BITMAP_WIDTH);
+            (BITMAP_WIDTH * (PAGE_SIZE - 1 - hdr_size) + 1) / (1 + slot_size * BITMAP_WIDTH);
         file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        if (!var_cols.empty()) {
+            file_hdr.bitmap_size = (file_hdr.bitmap_size + 3) / 4 * 4;
+        }
 
         // 将file header写入磁盘文件（名为file name，文件描述符为fd）中的第0页
         // head page直接写入磁盘，没有经过缓冲区的NewPage，那么也就不需要FlushPage
@@ -68,7 +93,13 @@ class RmManager {
      */
     std::unique_ptr<RmFileHandle> open_file(const std::string& filename) {
         int fd = disk_manager_->open_file(filename);
-        return std::make_unique<RmFileHandle>(disk_manager_, bpm_, fd);
+        auto file_handle = std::make_unique<RmFileHandle>(disk_manager_, bpm_, fd);
+        if (file_handle->file_hdr_.version != RM_FILE_VERSION) {
+            // 文件头不是能识别的任何版本，不能按当前格式读写
+            disk_manager_->close_file(fd);
+            throw FileFormatError(filename);
+        }
+        return file_handle;
     }
     /**
      * @description: 关闭表的数据文件
@@ -78,6 +109,7 @@ class RmManager {
         disk_manager_->write_page(file_handle->fd_, RM_FILE_HDR_PAGE, (char *)&file_handle->file_hdr_,
                                   sizeof(file_handle->file_hdr_));
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
+        bpm_->cancel_readahead(file_handle->fd_);
         bpm_->flush_all_pages(file_handle->fd_);
         disk_manager_->close_file(file_handle->fd_);
     }
@@ -15,7 +15,11 @@ See the Mulan PSL v2 for more details. */
  * @brief 初始化file_handle和rid
  * @param file_handle
  */
-RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
+RmScan::RmScan(const RmFileHandle *file_handle)
+    : file_handle_(file_handle),
+      strategy_(file_handle->create_scan_strategy()),
+      readahead_(file_handle->bpm_, file_handle->fd_, strategy_.get(),
+                 strategy_ == nullptr ? READAHEAD_MAX_PAGES : static_cast<int>(strategy_->capacity() / 2)) {
     // 初始化file_handle和rid（指向第一个存放了记录的位置）
     rid_.page_no = RM_FIRST_RECORD_PAGE;
     rid_.slot_no = -1;
@@ -29,7 +33,9 @@ void RmScan::next() {
     // 找到文件中下一个存放了记录的非空闲位置，用rid_来指向这个位置
     auto max_n = file_handle_->file_hdr_.num_records_per_page;
     while (rid_.page_no < file_handle_->file_hdr_.num_pages) {
-        auto page_handle = file_handle_->fetch_page_handle(rid_.page_no);
+        // 由预读线程提前读入后面的页面，扫描不必等待每个页面的读取
+        readahead_.access(rid_.page_no, file_handle_->file_hdr_.num_pages);
+        auto page_handle = file_handle_->fetch_page_handle(rid_.page_no, strategy_.get());
         rid_.slot_no = Bitmap::next_bit(true, page_handle.bitmap, max_n, rid_.slot_no);
         // 本页找到空slot
         file_handle_->bpm_->unpin_page(page_handle.page->get_page_id(), false);
@@ -50,4 +56,68 @@ bool RmScan::is_end() const { return (rid_.page_no >= file_handle_->file_hdr_.nu
 /**
  * @brief RmScan内部存放的rid
  */
-Rid RmScan::rid() const { return rid_; }
\ No newline at end of file
+Rid RmScan::rid() const { return rid_; }
+/**
+ * @brief 初始化file_handle，固定第一个存放了记录的页面
+ * @param file_handle
+ */
+RmBatchScan::RmBatchScan(const RmFileHandle *file_handle)
+    : file_handle_(file_handle),
+      page_no_(RM_FIRST_RECORD_PAGE - 1),
+      strategy_(file_handle->create_scan_strategy()),
+      readahead_(file_handle->bpm_, file_handle->fd_, strategy_.get(),
+                 strategy_ == nullptr ? READAHEAD_MAX_PAGES : static_cast<int>(strategy_->capacity() / 2)) {
+    sel_.reserve(file_handle->file_hdr_.num_records_per_page);
+    next_page();
+}
+
+RmBatchScan::~RmBatchScan() { release_page(); }
+
+/**
+ * @brief 找到下一个存放了记录的页面，一次收集页面中所有记录的slot号
+ */
+void RmBatchScan::next_page() {
+    release_page();
+    auto max_n = file_handle_->file_hdr_.num_records_per_page;
+    for (page_no_++; page_no_ < file_handle_->file_hdr_.num_pages; page_no_++) {
+        readahead_.access(page_no_, file_handle_->file_hdr_.num_pages);
+        auto page_handle = file_handle_->fetch_page_handle(page_no_, strategy_.get());
+        Bitmap::for_each_set_bit(page_handle.bitmap, max_n, [this](int slot_no) { sel_.push_back(slot_no); });
+        if (!sel_.empty()) {
+            // 页面在处理完其中的记录之前保持固定
+            page_ = page_handle.page;
+            slots_ = page_handle.slots;
+            if (file_handle_->is_varlen()) {
+                int record_size = file_handle_->file_hdr_.record_size;
+                decoded_.resize(sel_.size() * record_size);
+                for (size_t i = 0; i < sel_.size(); i++) {
+                    file_handle_->read_record(page_handle, sel_[i], decoded_.data() + i * record_size);
+                }
+            }
+            return;
+        }
+        file_handle_->bpm_->unpin_page(page_handle.page->get_page_id(), false);
+    }
+}
+
+/**
+ * @brief 当前页面中第i条记录的数据
+ */
+const char *RmBatchScan::record(size_t i) const {
+    if (file_handle_->is_varlen()) {
+        return decoded_.data() + i * file_handle_->file_hdr_.record_size;
+    }
+    return slots_ + sel_[i] * file_handle_->file_hdr_.record_size;
+}
+
+std::unique_ptr<RmRecord> RmBatchScan::get_record(size_t i) const {
+    return std::make_unique<RmRecord>(file_handle_->file_hdr_.record_size, const_cast<char *>(record(i)));
+}
+
+void RmBatchScan::release_page() {
+    if (page_ != nullptr) {
+        file_handle_->bpm_->unpin_page(page_->get_page_id(), false);
+        page_ = nullptr;
+    }
+    sel_.clear();
+}
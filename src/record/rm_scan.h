@@ -10,13 +10,21 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "rm_defs.h"
+#include "storage/buffer_pool_manager.h"
+#include "storage/readahead.h"
 
 class RmFileHandle;
 
 class RmScan : public RecScan {
     const RmFileHandle *file_handle_;
     Rid rid_;
+    std::unique_ptr<BufferAccessStrategy> strategy_;  // 表大于缓冲池的1/4时在环形帧中扫描，否则为nullptr
+    // 顺序预读。必须声明在strategy_之后，从而先于strategy_析构：取消排队的预读之后才释放环形帧
+    ReadaheadStream readahead_;
 public:
     RmScan(const RmFileHandle *file_handle);
 
@@ -25,4 +33,53 @@ public:
     bool is_end() const override;
 
     Rid rid() const override;
+
+    // 读取扫描到的记录时也应使用该策略
+    BufferAccessStrategy *strategy() const { return strategy_.get(); }
+
+    const ReadaheadStream &readahead() const { return readahead_; }
+};
+
+/**
+ * @description: 按页面批量扫描表中的记录。每个页面只固定一次，把页面bitmap中所有为1的位收集到选择向量中，
+ * 调用者处理完整个页面的记录后再调用next_page()换到下一个有记录的页面；
+ * record(i)直接指向被固定的页面中的数据，slotted page中的记录在换页时一次解码，都在next_page()或扫描析构之前有效
+ */
+class RmBatchScan {
+    const RmFileHandle *file_handle_;
+    int page_no_;
+    Page *page_ = nullptr;       // 当前固定的页面，扫描结束时为nullptr
+    char *slots_ = nullptr;      // 当前页面的slot区
+    std::vector<int> sel_;       // 当前页面中存放了记录的slot号，按slot号递增
+    std::vector<char> decoded_;  // slotted page中的记录解码后依次存放在这里
+    std::unique_ptr<BufferAccessStrategy> strategy_;  // 同RmScan
+    ReadaheadStream readahead_;                       // 同RmScan，必须先于strategy_析构
+
+   public:
+    RmBatchScan(const RmFileHandle *file_handle);
+
+    ~RmBatchScan();
+
+    RmBatchScan(const RmBatchScan &) = delete;
+    RmBatchScan &operator=(const RmBatchScan &) = delete;
+
+    /* unpin当前页面，固定下一个存放了记录的页面 */
+    void next_page();
+
+    bool is_end() const { return page_ == nullptr; }
+
+    /* 当前页面中记录的个数 */
+    size_t size() const { return sel_.size(); }
+
+    const std::vector<int> &slots() const { return sel_; }
+
+    const char *record(size_t i) const;
+
+    Rid rid(size_t i) const { return Rid{page_no_, sel_[i]}; }
+
+    /* 把第i条记录复制出来，复制出的记录在页面unpin之后仍然有效 */
+    std::unique_ptr<RmRecord> get_record(size_t i) const;
+
+   private:
+    void release_page();
 };
@@ -247,4 +247,489 @@ TEST(RecordManagerTest, MultipleFilesTest) {
         std::string filename = filenames[i];
         rm_manager->destroy_file(filename);
     }
-}
\ No newline at end of file
+}
+/**
+ * @brief 记录视图直接指向页面中的数据，视图存在期间页面保持固定，析构、release或被移动覆盖时unpin
+ */
+TEST(RecordManagerTest, RecordViewTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "record_view.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    const int record_size = 100;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+
+    char write_buf[PAGE_SIZE];
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    for (int i = 0; i < 200; i++) {
+        rand_buf(record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, nullptr);
+        mock[rid] = std::string(write_buf, record_size);
+    }
+    auto pin_count = [&](int page_no) {
+        Page *page = file_handle->fetch_page_handle(page_no).page;
+        int count = page->pin_count_ - 1;
+        buffer_pool_manager->unpin_page(page->get_page_id(), false);
+        return count;
+    };
+
+    for (auto &entry : mock) {
+        auto view = file_handle->get_record_view(entry.first, nullptr);
+        ASSERT_TRUE(view.valid());
+        ASSERT_EQ(view.size(), record_size);
+        ASSERT_EQ(memcmp(view.data(), entry.second.data(), record_size), 0);
+        // 视图指向页面中的slot，没有复制数据
+        RmPageHandle page_handle = file_handle->fetch_page_handle(entry.first.page_no);
+        EXPECT_EQ(view.data(), page_handle.get_slot(entry.first.slot_no));
+        buffer_pool_manager->unpin_page(page_handle.page->get_page_id(), false);
+        EXPECT_EQ(pin_count(entry.first.page_no), 1);
+    }
+
+    Rid rid = mock.begin()->first;
+    EXPECT_EQ(pin_count(rid.page_no), 0);
+    std::unique_ptr<RmRecord> copy;
+    {
+        auto view = file_handle->get_record_view(rid, nullptr);
+        auto moved = std::move(view);
+        EXPECT_FALSE(view.valid());
+        EXPECT_EQ(pin_count(rid.page_no), 1);
+        copy = moved.to_record();
+        moved.release();
+        EXPECT_FALSE(moved.valid());
+        EXPECT_EQ(pin_count(rid.page_no), 0);
+
+        // 移动赋值时先unpin原来指向的页面
+        moved = file_handle->get_record_view(rid, nullptr);
+        moved = file_handle->get_record_view(rid, nullptr);
+        EXPECT_EQ(pin_count(rid.page_no), 1);
+    }
+    EXPECT_EQ(pin_count(rid.page_no), 0);
+    // 复制出的记录在页面unpin之后仍然有效
+    EXPECT_EQ(memcmp(copy->data, mock.at(rid).data(), record_size), 0);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 批量扫描按页面返回所有记录，与逐条扫描的结果一致，扫描期间只有当前页面被固定
+ */
+TEST(RecordManagerTest, BatchScanTest) {
+    std::srand(20230801);
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "batch_scan.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    const int record_size = 64;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+
+    // 空表
+    {
+        RmBatchScan scan(file_handle.get());
+        EXPECT_TRUE(scan.is_end());
+    }
+
+    char write_buf[PAGE_SIZE];
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    for (int i = 0; i < 2000; i++) {
+        rand_buf(record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, nullptr);
+        mock[rid] = std::string(write_buf, record_size);
+    }
+    // 删除部分记录，并清空第2个页面，批量扫描应跳过没有记录的页面
+    std::vector<Rid> to_delete;
+    for (auto &entry : mock) {
+        if (entry.first.page_no == 2 || rand() % 3 == 0) {
+            to_delete.push_back(entry.first);
+        }
+    }
+    for (auto &rid : to_delete) {
+        file_handle->delete_record(rid, nullptr);
+        mock.erase(rid);
+    }
+
+    std::vector<Rid> expected;
+    for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) {
+        expected.push_back(scan.rid());
+    }
+    std::vector<Rid> scanned;
+    int num_batches = 0;
+    for (RmBatchScan scan(file_handle.get()); !scan.is_end(); scan.next_page()) {
+        num_batches++;
+        ASSERT_GT(scan.size(), 0u);
+        int page_no = scan.rid(0).page_no;
+        EXPECT_NE(page_no, 2);
+        for (size_t i = 0; i < scan.size(); i++) {
+            Rid rid = scan.rid(i);
+            EXPECT_EQ(rid.page_no, page_no);
+            EXPECT_EQ(rid.slot_no, scan.slots()[i]);
+            ASSERT_EQ(mock.count(rid), 1u);
+            EXPECT_EQ(memcmp(scan.record(i), mock.at(rid).data(), record_size), 0);
+            scanned.push_back(rid);
+        }
+        // 当前页面被扫描固定了一次
+        PageId page_id = {.fd = file_handle->GetFd(), .page_no = page_no};
+        Page *page = buffer_pool_manager->fetch_page(page_id);
+        EXPECT_EQ(page->pin_count_, 2);
+        buffer_pool_manager->unpin_page(page_id, false);
+    }
+    EXPECT_EQ(num_batches, file_handle->get_file_hdr().num_pages - 2);
+    ASSERT_EQ(scanned.size(), expected.size());
+    for (size_t i = 0; i < scanned.size(); i++) {
+        EXPECT_TRUE(rid_equal_t()(scanned[i], expected[i]));
+    }
+    EXPECT_EQ(scanned.size(), mock.size());
+
+    // 扫描结束后所有页面都已unpin
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_handle->get_file_hdr().num_pages; page_no++) {
+        PageId page_id = {.fd = file_handle->GetFd(), .page_no = page_no};
+        Page *page = buffer_pool_manager->fetch_page(page_id);
+        EXPECT_EQ(page->pin_count_, 1);
+        buffer_pool_manager->unpin_page(page_id, false);
+    }
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 按字查找的bitmap与逐位检查的结果一致，包括长度不是8或64的倍数、从字的中间开始查找的情况
+ */
+TEST(RecordManagerTest, BitmapTest) {
+    std::srand(20230802);
+    char bm[PAGE_SIZE / BITMAP_WIDTH];
+    for (int max_n : {1, 7, 8, 9, 63, 64, 65, 127, 200, 1000, 1017}) {
+        int num_bytes = (max_n + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        // 依次为：全0、全1、稀疏、稠密、随机
+        for (int density : {0, 100, 2, 98, 50}) {
+            Bitmap::init(bm, num_bytes);
+            int expected_count = 0;
+            for (int i = 0; i < max_n; i++) {
+                if (rand() % 100 < density) {
+                    Bitmap::set(bm, i);
+                    expected_count++;
+                }
+            }
+            EXPECT_EQ(Bitmap::count(bm, max_n), expected_count);
+            for (bool bit : {false, true}) {
+                for (int curr = -1; curr < max_n; curr++) {
+                    int expected = max_n;
+                    for (int i = curr + 1; i < max_n; i++) {
+                        if (Bitmap::is_set(bm, i) == bit) {
+                            expected = i;
+                            break;
+                        }
+                    }
+                    ASSERT_EQ(Bitmap::next_bit(bit, bm, max_n, curr), expected)
+                        << "max_n=" << max_n << " density=" << density << " bit=" << bit << " curr=" << curr;
+                }
+            }
+            std::vector<int> set_bits;
+            Bitmap::for_each_set_bit(bm, max_n, [&](int pos) { set_bits.push_back(pos); });
+            ASSERT_EQ(static_cast<int>(set_bits.size()), expected_count);
+            for (size_t i = 0; i < set_bits.size(); i++) {
+                EXPECT_TRUE(Bitmap::is_set(bm, set_bits[i]));
+                if (i > 0) {
+                    EXPECT_LT(set_bits[i - 1], set_bits[i]);
+                }
+            }
+        }
+    }
+    // max_n之后的位不参与查找和统计
+    Bitmap::init(bm, 2);
+    Bitmap::set(bm, 12);
+    EXPECT_EQ(Bitmap::first_bit(true, bm, 10), 10);
+    EXPECT_EQ(Bitmap::count(bm, 10), 0);
+    int num_visited = 0;
+    Bitmap::for_each_set_bit(bm, 10, [&](int) { num_visited++; });
+    EXPECT_EQ(num_visited, 0);
+}
+
+/**
+ * @brief 批量追加与逐条插入得到相同的位置：先填满空闲页面中的空位，再依次使用新页面
+ */
+TEST(RecordManagerTest, BulkInsertTest) {
+    std::srand(20230803);
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    const int record_size = 48;
+    std::vector<std::unique_ptr<RmFileHandle>> file_handles;
+    for (std::string filename : {"bulk_single.txt", "bulk_batch.txt"}) {
+        if (disk_manager->is_file(filename)) {
+            disk_manager->destroy_file(filename);
+        }
+        rm_manager->create_file(filename, record_size);
+        file_handles.push_back(rm_manager->open_file(filename));
+    }
+    auto &single = file_handles[0];
+    auto &batch = file_handles[1];
+
+    std::vector<char> rows(5000 * record_size);
+    rand_buf(rows.size(), rows.data());
+    auto insert_both = [&](int begin, int n) {
+        auto rids = batch->insert_records(rows.data() + begin * record_size, n, nullptr);
+        ASSERT_EQ(static_cast<int>(rids.size()), n);
+        for (int i = 0; i < n; i++) {
+            Rid rid = single->insert_record(rows.data() + (begin + i) * record_size, nullptr);
+            ASSERT_TRUE(rid_equal_t()(rid, rids[i]));
+        }
+    };
+    insert_both(0, 0);
+    insert_both(0, 1000);
+    // 在前面的页面中删除一些记录留出空位，批量追加时先填这些空位
+    for (int i = 0; i < 200; i++) {
+        Rid rid = {.page_no = RM_FIRST_RECORD_PAGE + rand() % (single->file_hdr_.num_pages - 1),
+                   .slot_no = rand() % single->file_hdr_.num_records_per_page};
+        single->delete_record(rid, nullptr);
+        batch->delete_record(rid, nullptr);
+    }
+    insert_both(1000, 4000);
+
+    EXPECT_EQ(single->file_hdr_.num_pages, batch->file_hdr_.num_pages);
+    EXPECT_EQ(single->file_hdr_.first_free_page_no, batch->file_hdr_.first_free_page_no);
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    for (RmScan scan(single.get()); !scan.is_end(); scan.next()) {
+        mock[scan.rid()] = std::string(single->get_record(scan.rid(), nullptr)->data, record_size);
+    }
+    size_t num_records = 0;
+    for (RmScan scan(batch.get()); !scan.is_end(); scan.next()) {
+        ASSERT_EQ(mock.count(scan.rid()), 1u);
+        EXPECT_EQ(memcmp(batch->get_record(scan.rid(), nullptr)->data, mock.at(scan.rid()).data(), record_size), 0);
+        num_records++;
+    }
+    EXPECT_EQ(num_records, mock.size());
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < batch->file_hdr_.num_pages; page_no++) {
+        RmPageHandle page_handle = batch->fetch_page_handle(page_no);
+        EXPECT_EQ(page_handle.page->pin_count_, 1);
+        EXPECT_EQ(page_handle.page_hdr->num_records,
+                  Bitmap::count(page_handle.bitmap, batch->file_hdr_.num_records_per_page));
+        buffer_pool_manager->unpin_page(page_handle.page->get_page_id(), false);
+    }
+
+    for (auto &file_handle : file_handles) {
+        std::string filename = disk_manager->get_file_name(file_handle->GetFd());
+        rm_manager->close_file(file_handle.get());
+        rm_manager->destroy_file(filename);
+    }
+}
+
+/**
+ * @brief 变长记录：随机插入、删除、更新和回滚删除，更新时变长的记录可能迁移到其他页面，Rid保持不变；
+ * 与逐条读取、RmScan、RmBatchScan的结果比对，重新打开文件后再比对一次
+ */
+TEST(RecordManagerTest, VarlenRecordTest) {
+    std::srand(20231017);
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // int | varchar(100) | char(8) | varchar(200)
+    const int record_size = 4 + 100 + 8 + 200;
+    const std::vector<RmVarCol> var_cols = {{.offset = 4, .len = 100}, {.offset = 112, .len = 200}};
+    std::string filename = "varlen.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, record_size, false, var_cols);
+    auto file_handle = rm_manager->open_file(filename);
+    ASSERT_TRUE(file_handle->is_varlen());
+
+    // 变长字段大多很短，偶尔填满，更新时容易变长
+    auto make_record = [&](char *buf) {
+        memset(buf, 0, record_size);
+        rand_buf(4, buf);
+        rand_buf(8, buf + 104);
+        for (auto &var_col : var_cols) {
+            int len = rand() % 10 == 0 ? var_col.len : rand() % 16;
+            for (int i = 0; i < len; i++) {
+                buf[var_col.offset + i] = static_cast<char>('a' + rand() % 26);
+            }
+        }
+    };
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::vector<Rid> rids;
+    std::vector<std::pair<Rid, std::string>> deleted;
+    char buf[record_size];
+    int num_forwarded = 0;
+    auto check = [&]() {
+        num_forwarded = 0;
+        for (auto &entry : mock) {
+            ASSERT_EQ(memcmp(file_handle->get_record(entry.first, nullptr)->data, entry.second.data(), record_size), 0);
+        }
+        size_t num_records = 0;
+        for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) {
+            ASSERT_EQ(mock.count(scan.rid()), 1u);
+            num_records++;
+        }
+        EXPECT_EQ(num_records, mock.size());
+        num_records = 0;
+        for (RmBatchScan scan(file_handle.get()); !scan.is_end(); scan.next_page()) {
+            for (size_t i = 0; i < scan.size(); i++) {
+                ASSERT_EQ(memcmp(scan.record(i), mock.at(scan.rid(i)).data(), record_size), 0);
+                num_records++;
+            }
+        }
+        EXPECT_EQ(num_records, mock.size());
+        for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_handle->file_hdr_.num_pages; page_no++) {
+            RmPageHandle page_handle = file_handle->fetch_page_handle(page_no);
+            EXPECT_EQ(page_handle.page->pin_count_, 1);
+            EXPECT_EQ(page_handle.page_hdr->num_records,
+                      Bitmap::count(page_handle.bitmap, file_handle->file_hdr_.num_records_per_page));
+            for (int slot_no = 0; slot_no < page_handle.slotted_hdr->num_slots; slot_no++) {
+                num_forwarded += (page_handle.get_slot_entry(slot_no)->len & RM_SLOT_FORWARD) != 0;
+            }
+            buffer_pool_manager->unpin_page(page_handle.page->get_page_id(), false);
+        }
+    };
+
+    for (int round = 0; round < 20000; round++) {
+        int op = rand() % 10;
+        if (op < 5 || rids.empty()) {
+            make_record(buf);
+            Rid rid = file_handle->insert_record(buf, nullptr);
+            ASSERT_EQ(mock.count(rid), 0u);
+            mock[rid] = std::string(buf, record_size);
+            rids.push_back(rid);
+        } else if (op < 8) {
+            Rid rid = rids[rand() % rids.size()];
+            make_record(buf);
+            file_handle->update_record(rid, buf, nullptr);
+            mock[rid] = std::string(buf, record_size);
+        } else if (op < 9 || deleted.empty()) {
+            size_t i = rand() % rids.size();
+            Rid rid = rids[i];
+            ASSERT_TRUE(file_handle->delete_record(rid, nullptr));
+            deleted.emplace_back(rid, mock.at(rid));
+            mock.erase(rid);
+            rids[i] = rids.back();
+            rids.pop_back();
+        } else {
+            // 回滚最近一次删除，记录放回原来的位置
+            auto [rid, rec] = deleted.back();
+            deleted.pop_back();
+            if (mock.count(rid) == 0) {
+                file_handle->insert_record(rid, rec.data());
+                mock[rid] = rec;
+                rids.push_back(rid);
+            }
+        }
+    }
+    // 批量追加先填满空闲页面，再使用新页面
+    std::vector<char> rows(2000 * record_size);
+    for (size_t i = 0; i < 2000; i++) {
+        make_record(rows.data() + i * record_size);
+    }
+    auto bulk_rids = file_handle->insert_records(rows.data(), 2000, nullptr);
+    ASSERT_EQ(bulk_rids.size(), 2000u);
+    for (size_t i = 0; i < bulk_rids.size(); i++) {
+        ASSERT_EQ(mock.count(bulk_rids[i]), 0u);
+        mock[bulk_rids[i]] = std::string(rows.data() + i * record_size, record_size);
+    }
+    check();
+    EXPECT_GT(num_forwarded, 0);
+
+    // 记录平均远小于定长格式的312字节，页面数应明显少于定长格式所需
+    int fixed_pages = static_cast<int>(mock.size()) / ((PAGE_SIZE - 64) / record_size) + 1;
+    EXPECT_LT(file_handle->file_hdr_.num_pages, fixed_pages);
+
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    check();
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+/**
+ * @brief 旧版本的文件头只有前5个字段：打开时按文件大小得到预分配的页面个数，记录仍能读出，关闭时按新格式写回
+ */
+TEST(RecordManagerTest, OldFileHdrTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    const int record_size = 64;
+    std::string filename = "old_hdr.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    char buf[record_size];
+    for (int i = 0; i < 1000; i++) {
+        rand_buf(record_size, buf);
+        mock[file_handle->insert_record(buf, nullptr)] = std::string(buf, record_size);
+    }
+    RmFileHdr file_hdr = file_handle->file_hdr_;
+    rm_manager->close_file(file_handle.get());
+    auto check = [&]() {
+        size_t num_records = 0;
+        for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) {
+            ASSERT_EQ(mock.count(scan.rid()), 1u);
+            EXPECT_EQ(memcmp(file_handle->get_record(scan.rid(), nullptr)->data, mock.at(scan.rid()).data(), record_size),
+                      0);
+            num_records++;
+        }
+        EXPECT_EQ(num_records, mock.size());
+    };
+
+    // 把文件头改写为旧格式，之后的字节清零
+    auto write_old_hdr = [&](const RmFileHdr &hdr) {
+        int fd = disk_manager->open_file(filename);
+        char page[PAGE_SIZE] = {};
+        memcpy(page, &hdr, offsetof(RmFileHdr, version));
+        disk_manager->write_page(fd, RM_FILE_HDR_PAGE, page, PAGE_SIZE);
+        disk_manager->close_file(fd);
+    };
+    write_old_hdr(file_hdr);
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(file_handle->file_hdr_.version, RM_FILE_VERSION);
+    EXPECT_EQ(file_handle->file_hdr_.num_allocated_pages, disk_manager->get_file_size(filename) / PAGE_SIZE);
+    EXPECT_EQ(file_handle->file_hdr_.num_pages, file_hdr.num_pages);
+    check();
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(file_handle->file_hdr_.version, RM_FILE_VERSION);
+    check();
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+
+    // 旧版本的空表文件只有文件头那么长
+    rm_manager->create_file(filename, record_size);
+    file_handle = rm_manager->open_file(filename);
+    file_hdr = file_handle->file_hdr_;
+    rm_manager->close_file(file_handle.get());
+    ASSERT_EQ(truncate(filename.c_str(), 0), 0);
+    int fd = disk_manager->open_file(filename);
+    disk_manager->write_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr, offsetof(RmFileHdr, version));
+    disk_manager->close_file(fd);
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(file_handle->file_hdr_.num_allocated_pages, 1);
+    EXPECT_EQ(file_handle->file_hdr_.num_records_per_page, file_hdr.num_records_per_page);
+    Rid rid = file_handle->insert_record(buf, nullptr);
+    EXPECT_EQ(rid.page_no, RM_FIRST_RECORD_PAGE);
+    file_hdr = file_handle->file_hdr_;
+    rm_manager->close_file(file_handle.get());
+
+    // 不能识别的文件头版本直接拒绝，文件被关闭
+    file_hdr.version = RM_FILE_VERSION + 1;
+    fd = disk_manager->open_file(filename);
+    disk_manager->write_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr, sizeof(file_hdr));
+    disk_manager->close_file(fd);
+    EXPECT_THROW(rm_manager->open_file(filename), FileFormatError);
+    rm_manager->destroy_file(filename);
+}
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <condition_variable>
 #include <iostream>
 #include <mutex>
 #include <vector>
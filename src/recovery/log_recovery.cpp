@@ -10,6 +10,8 @@ See the Mulan PSL v2 for more details. */
 
 #include "log_recovery.h"
 
+#include <set>
+
 #include "common/config.h"
 
 /**
@@ -206,6 +208,19 @@ void RecoveryManager::analyze() {
  * @description: 重做所有操作
  */
 void RecoveryManager::redo() {
+    // 连续的、不是回滚产生的同一个表上的insert攒成一批，一次追加到表中。插入的位置与逐条插入时相同，
+    // 在遇到其他日志之前完成这一批，之后的日志中引用的rid保持正确
+    std::string batch_tab_name;
+    std::vector<char> batch;
+    int batch_rows = 0;
+    auto flush_inserts = [&]() {
+        if (batch_rows > 0) {
+            redo_inserts(batch_tab_name, batch, batch_rows);
+            batch.clear();
+            batch_rows = 0;
+        }
+    };
+
     for (auto pair : redo_logs_) {
         if (pair.second == false) {
             continue;
@@ -217,6 +232,9 @@ void RecoveryManager::redo() {
         memset(log_buf, 0, log_len);
         disk_manager_->read_log(log_buf, log_len, lsn_offsets_[rd]);
         LogType log_type = *(LogType *)log_buf;
+        if (log_type != LogType::INSERT) {
+            flush_inserts();
+        }
         switch (log_type) {
             case LogType::INSERT: {
                 InsertLogRecord *log_rec = new InsertLogRecord();
@@ -231,11 +249,21 @@ void RecoveryManager::redo() {
                 if (!sm_manager_->get_db()->is_table(tab_name)) {
                     continue;
                 }
-                if (log_rec->is_rollback_) {
-                    sm_manager_->fhs_.at(tab_name)->insert_record(log_rec->rid_, log_rec->insert_value_.data);
-                } else {
-                    log_rec->rid_ = sm_manager_->fhs_.at(tab_name)->insert_record(log_rec->insert_value_.data, nullptr);
+                if (!log_rec->is_rollback_) {
+                    if (tab_name != batch_tab_name) {
+                        flush_inserts();
+                        batch_tab_name = tab_name;
+                    }
+                    batch.insert(batch.end(), log_rec->insert_value_.data,
+                                 log_rec->insert_value_.data + log_rec->insert_value_.size);
+                    if (++batch_rows == BULK_INSERT_BATCH_ROWS) {
+                        flush_inserts();
+                    }
+                    delete log_rec;
+                    break;
                 }
+                flush_inserts();
+                sm_manager_->fhs_.at(tab_name)->insert_record(log_rec->rid_, log_rec->insert_value_.data);
                 // sm_manager_->get_bpm()->unpin_page(page_handle.page->get_page_id(), true);
 
                 TabMeta &tab = sm_manager_->db_.get_table(tab_name);
@@ -368,6 +396,60 @@ void RecoveryManager::redo() {
         }
         delete[] log_buf;
     }
+    flush_inserts();
+}
+
+/**
+ * @description: 重做一批insert，批量追加记录后插入索引。逐条重做时，索引项重复的记录插入后随即被删除，
+ * 下一条记录会复用它的位置；这里先找出这些记录不追加，使其余记录的位置与逐条重做时相同
+ * @param {string&} tab_name 表名
+ * @param {vector<char>&} rows 依次存放的记录
+ * @param {int} num_rows 记录条数
+ */
+void RecoveryManager::redo_inserts(const std::string &tab_name, const std::vector<char> &rows, int num_rows) {
+    auto fh = sm_manager_->fhs_.at(tab_name).get();
+    int record_size = fh->get_file_hdr().record_size;
+    TabMeta &tab = sm_manager_->db_.get_table(tab_name);
+
+    // 1. 计算每条记录在各个索引上的key，与索引中已有的key或本批前面的记录重复时跳过这条记录
+    std::vector<IxIndexHandle *> ihs;
+    for (auto &index : tab.indexes) {
+        ihs.push_back(sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name, index.cols)).get());
+    }
+    std::vector<std::set<std::string>> batch_keys(tab.indexes.size());
+    std::vector<std::vector<std::string>> keys;  // 追加的记录在各个索引上的key
+    std::vector<char> appended;
+    for (int row = 0; row < num_rows; row++) {
+        const char *rec = rows.data() + static_cast<size_t>(row) * record_size;
+        std::vector<std::string> row_keys;
+        bool duplicated = false;
+        for (size_t i = 0; i < tab.indexes.size() && !duplicated; ++i) {
+            auto &index = tab.indexes.at(i);
+            std::string key;
+            for (int j = 0; j < index.col_num; j++) {
+                key.append(rec + index.cols[j].offset, index.cols[j].len);
+            }
+            std::vector<Rid> old_rids;
+            duplicated = batch_keys[i].count(key) > 0 || ihs[i]->get_value(key.data(), &old_rids, nullptr);
+            row_keys.push_back(std::move(key));
+        }
+        if (duplicated) {
+            continue;
+        }
+        for (size_t i = 0; i < row_keys.size(); ++i) {
+            batch_keys[i].insert(row_keys[i]);
+        }
+        keys.push_back(std::move(row_keys));
+        appended.insert(appended.end(), rec, rec + record_size);
+    }
+
+    // 2. 批量追加记录，再插入索引
+    auto rids = fh->insert_records(appended.data(), static_cast<int>(keys.size()), nullptr);
+    for (size_t row = 0; row < keys.size(); row++) {
+        for (size_t i = 0; i < ihs.size(); ++i) {
+            ihs[i]->insert_entry(keys[row][i].data(), rids[row], nullptr);
+        }
+    }
 }
 
 /**
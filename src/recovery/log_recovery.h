@@ -40,6 +40,8 @@ class RecoveryManager {
     void undo();
 
    private:
+    void redo_inserts(const std::string& tab_name, const std::vector<char>& rows, int num_rows);
+
     LogBuffer buffer_;                               // 读入日志
     DiskManager* disk_manager_;                      // 用来读写文件
     BufferPoolManager* bpm_;                         // 对页面进行读写
@@ -0,0 +1,120 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#include "clock_replacer.h"
+
+ClockReplacer::ClockReplacer(size_t num_pages, frame_id_t first_frame_id)
+    : states_(std::make_unique<std::atomic<uint8_t>[]>(num_pages)), first_frame_id_(first_frame_id), max_size_(num_pages) {
+    for (size_t i = 0; i < max_size_; i++) {
+        states_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+ClockReplacer::~ClockReplacer() = default;
+
+/**
+ * @description: 转动时钟指针找到一个引用位为0的帧并将其移除，扫过的帧的引用位被清除
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool ClockReplacer::victim(frame_id_t* frame_id) {
+    std::scoped_lock lock{latch_};
+    // 最多转两圈：第一圈清除引用位，第二圈一定能找到引用位为0的帧
+    for (size_t steps = 0; steps < 2 * max_size_; steps++) {
+        size_t i = hand_;
+        hand_ = (hand_ + 1) % max_size_;
+        uint8_t state = states_[i].load(std::memory_order_relaxed);
+        if ((state & IN_REPLACER) == 0) {
+            continue;
+        }
+        if ((state & REFERENCED) != 0) {
+            states_[i].fetch_and(static_cast<uint8_t>(~REFERENCED), std::memory_order_relaxed);
+            continue;
+        }
+        if (states_[i].compare_exchange_strong(state, 0, std::memory_order_relaxed)) {
+            size_--;
+            *frame_id = first_frame_id_ + static_cast<frame_id_t>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰
+ * @param {frame_id_t} frame_id 需要固定的frame的id
+ */
+void ClockReplacer::pin(frame_id_t frame_id) {
+    uint8_t state = states_[frame_id - first_frame_id_].exchange(0, std::memory_order_relaxed);
+    if ((state & IN_REPLACER) != 0) {
+        size_--;
+    }
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void ClockReplacer::unpin(frame_id_t frame_id) {
+    uint8_t state = states_[frame_id - first_frame_id_].fetch_or(IN_REPLACER, std::memory_order_relaxed);
+    if ((state & IN_REPLACER) == 0) {
+        size_++;
+    }
+}
+
+/**
+ * @description: 记录一次对frame的访问，设置它的引用位
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ */
+void ClockReplacer::access(frame_id_t frame_id) {
+    auto& state = states_[frame_id - first_frame_id_];
+    if ((state.load(std::memory_order_relaxed) & IN_REPLACER) != 0) {
+        state.fetch_or(REFERENCED, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @description: 移除从victim_candidates中选出的victim frame，时钟指针转到它之后，扫过的帧的引用位被清除
+ * @param {frame_id_t} frame_id 被淘汰的frame的id
+ */
+void ClockReplacer::remove_victim(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    size_t target = frame_id - first_frame_id_;
+    for (size_t i = hand_; i != target; i = (i + 1) % max_size_) {
+        states_[i].fetch_and(static_cast<uint8_t>(~REFERENCED), std::memory_order_relaxed);
+    }
+    hand_ = (target + 1) % max_size_;
+    pin(frame_id);
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t ClockReplacer::Size() { return size_; }
+
+/**
+ * @description: 按淘汰顺序列出接下来会被淘汰的帧，不改变replacer的状态。
+ *              先是从时钟指针开始引用位为0的帧，然后是引用位为1、要等指针转过一圈才会被淘汰的帧
+ * @param {vector<frame_id_t>*} frames 按淘汰顺序存放的帧
+ * @param {size_t} max_count 最多列出的帧数
+ */
+void ClockReplacer::victim_candidates(std::vector<frame_id_t>* frames, size_t max_count) {
+    std::scoped_lock lock{latch_};
+    frames->clear();
+    for (uint8_t expected : {IN_REPLACER, static_cast<uint8_t>(IN_REPLACER | REFERENCED)}) {
+        for (size_t steps = 0, i = hand_; steps < max_size_ && frames->size() < max_count; steps++) {
+            if (states_[i].load(std::memory_order_relaxed) == expected) {
+                frames->push_back(first_frame_id_ + static_cast<frame_id_t>(i));
+            }
+            i = (i + 1) % max_size_;
+        }
+    }
+}
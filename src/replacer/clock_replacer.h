@@ -0,0 +1,64 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+ClockReplacer实现了CLOCK替换策略。每个帧在一个平坦数组中有一个状态字节，记录它是否在replacer中以及引用位，
+pin、unpin和access都只是对状态字节的原子操作，不需要加锁；只有移动时钟指针的操作需要加锁。
+淘汰时指针扫过的帧若引用位为1，则清除引用位并跳过，否则淘汰该帧
+*/
+class ClockReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的ClockReplacer
+     * @param {size_t} num_pages ClockReplacer管理的帧数
+     * @param {frame_id_t} first_frame_id 管理的第一个帧，管理的帧为[first_frame_id, first_frame_id + num_pages)
+     */
+    explicit ClockReplacer(size_t num_pages, frame_id_t first_frame_id = 0);
+
+    ~ClockReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void access(frame_id_t frame_id);
+
+    void remove_victim(frame_id_t frame_id);
+
+    size_t Size();
+
+    void victim_candidates(std::vector<frame_id_t> *frames, size_t max_count);
+
+   private:
+    static constexpr uint8_t IN_REPLACER = 1;  // 帧在replacer中，可以被淘汰
+    static constexpr uint8_t REFERENCED = 2;   // 引用位
+
+    std::mutex latch_;                             // 保护时钟指针
+    size_t hand_ = 0;                              // 时钟指针，下一个要检查的帧相对first_frame_id_的位置
+    std::unique_ptr<std::atomic<uint8_t>[]> states_;  // 每个帧的状态，IN_REPLACER和REFERENCED的组合
+    std::atomic<size_t> size_{0};                  // replacer中的帧数
+
+    frame_id_t first_frame_id_;  // 管理的第一个帧
+    size_t max_size_;            // 最大容量（与缓冲池分区的容量相同）
+};
@@ -0,0 +1,130 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#include "lru_k_replacer.h"
+
+#include <algorithm>
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k) : k_(std::max<size_t>(k, 1)), max_size_(num_pages) {}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+/**
+ * @description: 使用LRU-K策略删除一个victim frame，并返回该frame的id
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool LRUKReplacer::victim(frame_id_t* frame_id) {
+    std::scoped_lock lock{latch_};
+    if (!cold_list_.empty()) {
+        *frame_id = cold_list_.front();
+    } else if (!hot_set_.empty()) {
+        *frame_id = hot_set_.begin()->second;
+    } else {
+        return false;
+    }
+    remove(*frame_id);
+    return true;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰，同时丢弃它的访问历史
+ * @param {frame_id_t} frame_id 需要固定的frame的id
+ */
+void LRUKReplacer::pin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    if (history_.count(frame_id) != 0) {
+        remove(frame_id);
+    }
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰。新加入的frame记为访问了一次
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void LRUKReplacer::unpin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    if (history_.count(frame_id) != 0) {
+        return;
+    }
+    auto& history = history_[frame_id];
+    history.timestamps.push_back(current_timestamp_++);
+    if (k_ == 1) {
+        hot_set_.emplace(history.timestamps.front(), frame_id);
+    } else {
+        cold_list_.push_back(frame_id);
+        history.cold_iter = std::prev(cold_list_.end());
+    }
+}
+
+/**
+ * @description: 记录一次对frame的访问，访问满k次后按倒数第k次访问的时间排序
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ */
+void LRUKReplacer::access(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto iter = history_.find(frame_id);
+    if (iter == history_.end()) {
+        return;
+    }
+    auto& timestamps = iter->second.timestamps;
+    if (timestamps.size() < k_) {
+        timestamps.push_back(current_timestamp_++);
+        if (timestamps.size() == k_) {
+            cold_list_.erase(iter->second.cold_iter);
+            hot_set_.emplace(timestamps.front(), frame_id);
+        }
+        return;
+    }
+    hot_set_.erase({timestamps.front(), frame_id});
+    timestamps.pop_front();
+    timestamps.push_back(current_timestamp_++);
+    hot_set_.emplace(timestamps.front(), frame_id);
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t LRUKReplacer::Size() {
+    std::scoped_lock lock{latch_};
+    return history_.size();
+}
+
+/**
+ * @description: 按淘汰顺序列出接下来会被淘汰的帧，不改变replacer的状态
+ * @param {vector<frame_id_t>*} frames 按淘汰顺序存放的帧
+ * @param {size_t} max_count 最多列出的帧数
+ */
+void LRUKReplacer::victim_candidates(std::vector<frame_id_t>* frames, size_t max_count) {
+    std::scoped_lock lock{latch_};
+    frames->clear();
+    for (auto iter = cold_list_.begin(); iter != cold_list_.end() && frames->size() < max_count; iter++) {
+        frames->push_back(*iter);
+    }
+    for (auto iter = hot_set_.begin(); iter != hot_set_.end() && frames->size() < max_count; iter++) {
+        frames->push_back(iter->second);
+    }
+}
+
+/**
+ * @description: 从replacer中移除一个帧及其访问历史，调用者需持有latch_
+ * @param {frame_id_t} frame_id 需要移除的frame的id
+ */
+void LRUKReplacer::remove(frame_id_t frame_id) {
+    auto iter = history_.find(frame_id);
+    auto& timestamps = iter->second.timestamps;
+    if (timestamps.size() < k_) {
+        cold_list_.erase(iter->second.cold_iter);
+    } else {
+        hot_set_.erase({timestamps.front(), frame_id});
+    }
+    history_.erase(iter);
+}
@@ -0,0 +1,69 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+LRUKReplacer实现了LRU-K替换策略：淘汰倒数第k次访问最早的帧。访问不足k次的帧视为倒数第k次访问在无穷远处，
+最先被淘汰，它们之间按首次访问的先后淘汰。只访问过一次的扫描页面因此不会挤掉被反复访问的页面
+*/
+class LRUKReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的LRUKReplacer
+     * @param {size_t} num_pages LRUKReplacer最多需要存储的page数量
+     * @param {size_t} k 计算淘汰顺序时使用倒数第k次访问
+     */
+    LRUKReplacer(size_t num_pages, size_t k);
+
+    ~LRUKReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void access(frame_id_t frame_id);
+
+    size_t Size();
+
+    void victim_candidates(std::vector<frame_id_t> *frames, size_t max_count);
+
+   private:
+    struct FrameHistory {
+        std::deque<uint64_t> timestamps;          // 最近至多k次访问的时间，最早的在前
+        std::list<frame_id_t>::iterator cold_iter;  // 访问不足k次时在cold_list_中的位置
+    };
+
+    void remove(frame_id_t frame_id);
+
+    std::mutex latch_;                  // 互斥锁
+    size_t k_;                          // 计算淘汰顺序时使用倒数第k次访问
+    uint64_t current_timestamp_ = 0;    // 逻辑时钟，每次访问加一
+    std::list<frame_id_t> cold_list_;   // 访问不足k次的帧，按首次访问的时间顺序存放，首部最先被淘汰
+    std::set<std::pair<uint64_t, frame_id_t>> hot_set_;  // 访问满k次的帧，按倒数第k次访问的时间排序
+    std::unordered_map<frame_id_t, FrameHistory> history_;  // frame_id_t -> 帧的访问历史
+
+    size_t max_size_;  // 最大容量（与缓冲池的容量相同）
+};
@@ -65,7 +65,33 @@ void LRUReplacer::unpin(frame_id_t frame_id) {
     }
 }
 
+/**
+ * @description: 记录一次对frame的访问，把它移到最后淘汰的位置
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ */
+void LRUReplacer::access(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto iter = LRUhash_.find(frame_id);
+    if (iter != LRUhash_.end()) {
+        LRUlist_.splice(LRUlist_.end(), LRUlist_, iter->second);
+    }
+}
+
 /**
  * @description: 获取当前replacer中可以被淘汰的页面数量
  */
 size_t LRUReplacer::Size() { return LRUlist_.size(); }
+
+
+/**
+ * @description: 按淘汰顺序列出接下来会被淘汰的帧，不改变replacer的状态
+ * @param {vector<frame_id_t>*} frames 按淘汰顺序存放的帧
+ * @param {size_t} max_count 最多列出的帧数
+ */
+void LRUReplacer::victim_candidates(std::vector<frame_id_t>* frames, size_t max_count) {
+    std::scoped_lock lock{latch_};
+    frames->clear();
+    for (auto iter = LRUlist_.begin(); iter != LRUlist_.end() && frames->size() < max_count; iter++) {
+        frames->push_back(*iter);
+    }
+}
\ No newline at end of file
@@ -38,8 +38,12 @@ class LRUReplacer : public Replacer {
 
     void unpin(frame_id_t frame_id);
 
+    void access(frame_id_t frame_id);
+
     size_t Size();
 
+    void victim_candidates(std::vector<frame_id_t> *frames, size_t max_count);
+
    private:
     std::mutex latch_;               // 互斥锁
     std::list<frame_id_t> LRUlist_;  // 按加入的时间顺序存放unpinned pages的frame id，首部表示最近被访问
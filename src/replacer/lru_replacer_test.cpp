@@ -1,4 +1,7 @@
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
 #include "replacer/lru_replacer.h"
+#include "replacer/two_q_replacer.h"
 
 #include <algorithm>
 #include <cstdio>
@@ -155,3 +158,110 @@ TEST(LRUReplacerTest, ConcurrencyTest) {
         EXPECT_EQ(0, lru_replacer->victim(&result));
     }
 }
+
+/**
+ * @brief 测试LRUKReplacer的淘汰顺序：访问不足k次的帧先按首次访问的顺序淘汰，其余按倒数第k次访问的时间淘汰
+ */
+TEST(LRUKReplacerTest, SimpleTest) {
+    LRUKReplacer lru_k_replacer(7, 2);
+
+    for (int i = 1; i <= 6; i++) {
+        lru_k_replacer.unpin(i);
+    }
+    EXPECT_EQ(6, lru_k_replacer.Size());
+    // 1、2、3被访问了两次，倒数第二次访问的顺序为1、3、2
+    lru_k_replacer.access(2);
+    lru_k_replacer.access(3);
+    lru_k_replacer.access(1);
+    lru_k_replacer.access(2);
+
+    std::vector<frame_id_t> candidates;
+    lru_k_replacer.victim_candidates(&candidates, 10);
+    EXPECT_EQ((std::vector<frame_id_t>{4, 5, 6, 1, 3, 2}), candidates);
+
+    int value;
+    for (int expected : {4, 5, 6}) {
+        ASSERT_TRUE(lru_k_replacer.victim(&value));
+        EXPECT_EQ(expected, value);
+    }
+    // 固定的帧不再被淘汰，重新加入后访问历史从头开始
+    lru_k_replacer.pin(2);
+    lru_k_replacer.unpin(2);
+    for (int expected : {2, 1, 3}) {
+        ASSERT_TRUE(lru_k_replacer.victim(&value));
+        EXPECT_EQ(expected, value);
+    }
+    EXPECT_FALSE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(0, lru_k_replacer.Size());
+}
+
+/**
+ * @brief 测试TwoQReplacer的淘汰顺序：A1超过上限时先淘汰A1，否则淘汰Am中最久未被访问的帧
+ */
+TEST(TwoQReplacerTest, SimpleTest) {
+    TwoQReplacer two_q_replacer(8, 0.25);
+
+    for (int i = 1; i <= 4; i++) {
+        two_q_replacer.unpin(i);
+        two_q_replacer.access(i);
+    }
+    // 模拟一次扫描：5到8只被访问一次，A1的长度超过上限2
+    for (int i = 5; i <= 8; i++) {
+        two_q_replacer.unpin(i);
+    }
+    two_q_replacer.access(1);
+    EXPECT_EQ(8, two_q_replacer.Size());
+
+    std::vector<frame_id_t> candidates;
+    two_q_replacer.victim_candidates(&candidates, 10);
+    EXPECT_EQ((std::vector<frame_id_t>{5, 6, 2, 3, 4, 1, 7, 8}), candidates);
+
+    int value;
+    for (int expected : {5, 6, 2}) {
+        ASSERT_TRUE(two_q_replacer.victim(&value));
+        EXPECT_EQ(expected, value);
+    }
+    two_q_replacer.pin(3);
+    for (int expected : {4, 1, 7, 8}) {
+        ASSERT_TRUE(two_q_replacer.victim(&value));
+        EXPECT_EQ(expected, value);
+    }
+    EXPECT_FALSE(two_q_replacer.victim(&value));
+}
+
+/**
+ * @brief 测试ClockReplacer：时钟指针跳过并清除引用位为1的帧，remove_victim把指针转到被淘汰的帧之后
+ */
+TEST(ClockReplacerTest, SimpleTest) {
+    // 管理帧[10, 16)
+    ClockReplacer clock_replacer(6, 10);
+
+    for (int i = 10; i < 16; i++) {
+        clock_replacer.unpin(i);
+    }
+    clock_replacer.unpin(10);
+    EXPECT_EQ(6, clock_replacer.Size());
+    clock_replacer.access(10);
+    clock_replacer.access(12);
+    clock_replacer.pin(13);
+    EXPECT_EQ(5, clock_replacer.Size());
+
+    std::vector<frame_id_t> candidates;
+    clock_replacer.victim_candidates(&candidates, 10);
+    EXPECT_EQ((std::vector<frame_id_t>{11, 14, 15, 10, 12}), candidates);
+
+    int value;
+    ASSERT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(11, value);
+    // victim扫过10时清除了它的引用位，remove_victim(15)把指针从12转到15之后，清除12的引用位
+    clock_replacer.remove_victim(15);
+    clock_replacer.victim_candidates(&candidates, 10);
+    EXPECT_EQ((std::vector<frame_id_t>{10, 12, 14}), candidates);
+    clock_replacer.unpin(13);
+    for (int expected : {10, 12, 13, 14}) {
+        ASSERT_TRUE(clock_replacer.victim(&value));
+        EXPECT_EQ(expected, value);
+    }
+    EXPECT_FALSE(clock_replacer.victim(&value));
+    EXPECT_EQ(0, clock_replacer.Size());
+}
@@ -10,6 +10,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <vector>
+
 #include "common/config.h"
 
 /**
@@ -39,6 +41,27 @@ class Replacer {
      */
     virtual void unpin(frame_id_t frame_id) = 0;
 
+    /**
+     * Records a reference to a frame that is in the replacer. The buffer pool does not call the replacer on a hit;
+     * it reports the references it finds when it looks for a victim.
+     * @param frame_id the id of the referenced frame
+     */
+    virtual void access(frame_id_t frame_id) = 0;
+
+    /**
+     * Removes a frame that the buffer pool picked from victim_candidates() as its victim.
+     * Policies with a clock hand move the hand past the frame, as victim() would have.
+     * @param frame_id the id of the victim frame
+     */
+    virtual void remove_victim(frame_id_t frame_id) { pin(frame_id); }
+
     /** @return the number of elements in the replacer that can be victimized */
     virtual size_t Size() = 0;
+
+    /**
+     * Lists the frames that would be victimized next, in victim order, without removing them.
+     * @param[out] frames the first at most max_count frames in victim order
+     * @param max_count the maximum number of frames to list
+     */
+    virtual void victim_candidates(std::vector<frame_id_t> *frames, size_t max_count) = 0;
 };
@@ -0,0 +1,112 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#include "two_q_replacer.h"
+
+#include <algorithm>
+
+TwoQReplacer::TwoQReplacer(size_t num_pages, double a1_ratio)
+    : a1_max_size_(std::max<size_t>(1, static_cast<size_t>(num_pages * a1_ratio))), max_size_(num_pages) {}
+
+TwoQReplacer::~TwoQReplacer() = default;
+
+/**
+ * @description: 使用2Q策略删除一个victim frame，并返回该frame的id
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool TwoQReplacer::victim(frame_id_t* frame_id) {
+    std::scoped_lock lock{latch_};
+    if (a1_.empty() && am_.empty()) {
+        return false;
+    }
+    if (a1_.size() > a1_max_size_ || am_.empty()) {
+        *frame_id = a1_.front();
+        a1_.pop_front();
+    } else {
+        *frame_id = am_.front();
+        am_.pop_front();
+    }
+    entries_.erase(*frame_id);
+    return true;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰
+ * @param {frame_id_t} frame_id 需要固定的frame的id
+ */
+void TwoQReplacer::pin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto iter = entries_.find(frame_id);
+    if (iter == entries_.end()) {
+        return;
+    }
+    (iter->second.in_am ? am_ : a1_).erase(iter->second.iter);
+    entries_.erase(iter);
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰。新加入的frame进入A1
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void TwoQReplacer::unpin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    if (entries_.count(frame_id) != 0) {
+        return;
+    }
+    a1_.push_back(frame_id);
+    entries_.emplace(frame_id, FrameEntry{false, std::prev(a1_.end())});
+}
+
+/**
+ * @description: 记录一次对frame的访问，把它移到Am的末尾
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ */
+void TwoQReplacer::access(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto iter = entries_.find(frame_id);
+    if (iter == entries_.end()) {
+        return;
+    }
+    auto& entry = iter->second;
+    am_.splice(am_.end(), entry.in_am ? am_ : a1_, entry.iter);
+    entry.in_am = true;
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t TwoQReplacer::Size() {
+    std::scoped_lock lock{latch_};
+    return entries_.size();
+}
+
+/**
+ * @description: 按淘汰顺序列出接下来会被淘汰的帧，不改变replacer的状态
+ * @param {vector<frame_id_t>*} frames 按淘汰顺序存放的帧
+ * @param {size_t} max_count 最多列出的帧数
+ */
+void TwoQReplacer::victim_candidates(std::vector<frame_id_t>* frames, size_t max_count) {
+    std::scoped_lock lock{latch_};
+    frames->clear();
+    // 模拟连续调用victim的过程
+    auto a1_iter = a1_.begin();
+    auto am_iter = am_.begin();
+    size_t a1_size = a1_.size();
+    while (frames->size() < max_count && (a1_iter != a1_.end() || am_iter != am_.end())) {
+        if (a1_iter != a1_.end() && (a1_size > a1_max_size_ || am_iter == am_.end())) {
+            frames->push_back(*a1_iter++);
+            a1_size--;
+        } else {
+            frames->push_back(*am_iter++);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+TwoQReplacer实现了简化的2Q替换策略：新装入的帧进入FIFO队列A1，在A1中再次被访问的帧移入LRU队列Am。
+A1的长度超过上限时先淘汰A1的首部，否则淘汰Am中最久未被访问的帧，大范围扫描最多只能占用A1上限个帧
+*/
+class TwoQReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的TwoQReplacer
+     * @param {size_t} num_pages TwoQReplacer最多需要存储的page数量
+     * @param {double} a1_ratio A1队列的长度上限占num_pages的比例
+     */
+    TwoQReplacer(size_t num_pages, double a1_ratio);
+
+    ~TwoQReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void access(frame_id_t frame_id);
+
+    size_t Size();
+
+    void victim_candidates(std::vector<frame_id_t> *frames, size_t max_count);
+
+   private:
+    struct FrameEntry {
+        bool in_am;                          // 是否在Am中
+        std::list<frame_id_t>::iterator iter;  // 在A1或Am中的位置
+    };
+
+    std::mutex latch_;              // 互斥锁
+    std::list<frame_id_t> a1_;      // 只被访问过一次的帧，按装入的时间顺序存放，首部最先被淘汰
+    std::list<frame_id_t> am_;      // 被多次访问的帧，按最近访问的时间顺序存放，首部最久未被访问
+    std::unordered_map<frame_id_t, FrameEntry> entries_;  // frame_id_t -> 帧所在的队列和位置
+
+    size_t a1_max_size_;  // A1的长度上限
+    size_t max_size_;     // 最大容量（与缓冲池的容量相同）
+};
@@ -8,6 +8,7 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#include <getopt.h>
 #include <netinet/in.h>
 #include <readline/history.h>
 #include <readline/readline.h>
@@ -16,6 +17,7 @@ See the Mulan PSL v2 for more details. */
 #include <unistd.h>
 
 #include <atomic>
+#include <cstring>
 
 #include "analyze/analyze.h"
 #include "common/config.h"
@@ -34,7 +36,8 @@ static bool should_exit = false;
 // 构建全局所需的管理器对象
 auto disk_manager = std::make_unique<DiskManager>();
 auto log_manager = std::make_unique<LogManager>(disk_manager.get());
-auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get(), log_manager.get());
+auto buffer_pool_manager =
+    std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get(), log_manager.get(), BUFFER_POOL_SHARDS);
 auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
 auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
 auto sm_manager =
@@ -267,17 +270,83 @@ void start_server() {
         printf("%s\n", strerror(errno));
     }
     //    assert(ret != -1);
+    buffer_pool_manager->stop_hot_page_saver();
+    buffer_pool_manager->stop_bg_writer();
     sm_manager->close_db();
     std::cout << " DB has been closed.\n";
     std::cout << "Server shuts down." << std::endl;
 }
 
 int main(int argc, char **argv) {
-    if (argc != 2) {
+    // 启动参数：[options] <database>
+    static const char *usage_options =
+        "[--io-backend=sync|uring] [--extent-mb=0..64] [--direct-io] [--bg-writer-pages=N] [--replacer=LRU|LRU-K|2Q|CLOCK]";
+    static struct option long_options[] = {{"io-backend", required_argument, nullptr, 'b'},
+                                           {"extent-mb", required_argument, nullptr, 'e'},
+                                           {"direct-io", no_argument, nullptr, 'd'},
+                                           {"bg-writer-pages", required_argument, nullptr, 'w'},
+                                           {"replacer", required_argument, nullptr, 'r'},
+                                           {nullptr, 0, nullptr, 0}};
+    IoBackendType io_backend = IoBackendType::SYNC;
+    int extent_size = FILE_EXTENT_SIZE;
+    bool direct_io = false;
+    BgWriterConfig bg_writer_config;
+    std::string replacer_type = REPLACER_TYPE;
+    bool bad_args = false;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'b':
+                if (strcmp(optarg, "sync") == 0 || strcmp(optarg, "uring") == 0) {
+                    io_backend = io_backend_from_name(optarg);
+                } else {
+                    bad_args = true;
+                }
+                break;
+            case 'e': {
+                // 表/索引文件每次扩展的大小，单位MB，0表示不预分配
+                int extent_mb = atoi(optarg);
+                if (extent_mb < 0 || extent_mb > 64) {
+                    bad_args = true;
+                }
+                extent_size = extent_mb << 20;
+                break;
+            }
+            case 'd':
+                // 表和索引文件绕过page cache，页面只缓存在缓冲池中
+                direct_io = true;
+                break;
+            case 'w': {
+                // 后台写线程每轮最多写回的页面个数，0表示关闭后台写线程
+                int max_pages = atoi(optarg);
+                if (max_pages < 0) {
+                    bad_args = true;
+                }
+                bg_writer_config.max_pages = max_pages;
+                break;
+            }
+            case 'r':
+                // 缓冲池的置换策略，LRU-K和2Q能避免大范围扫描挤掉被反复访问的页面，CLOCK的维护开销最小
+                if (strcmp(optarg, "LRU") == 0 || strcmp(optarg, "LRU-K") == 0 || strcmp(optarg, "2Q") == 0 ||
+                    strcmp(optarg, "CLOCK") == 0) {
+                    replacer_type = optarg;
+                } else {
+                    bad_args = true;
+                }
+                break;
+            default:
+                bad_args = true;
+        }
+    }
+    if (bad_args || optind != argc - 1) {
         // 需要指定数据库名称
-        std::cerr << "Usage: " << argv[0] << " <database>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " " << usage_options << " <database>" << std::endl;
         exit(1);
     }
+    disk_manager->set_io_backend(io_backend);
+    disk_manager->set_extent_size(extent_size);
+    disk_manager->set_direct_io(direct_io);
+    buffer_pool_manager->set_replacer(replacer_type);
 
     signal(SIGINT, sigint_handler);
     try {
@@ -293,7 +362,7 @@ int main(int argc, char **argv) {
                      "Type 'help;' for help.\n"
                      "\n";
         // Database name is passed by args
-        std::string db_name = argv[1];
+        std::string db_name = argv[optind];
         if (!sm_manager->is_dir(db_name)) {
             // Database not found, create a new one
             sm_manager->create_db(db_name);
@@ -305,6 +374,10 @@ int main(int argc, char **argv) {
         recovery->analyze();
         recovery->redo();
         // recovery->undo();
+        if (bg_writer_config.max_pages > 0) {
+            buffer_pool_manager->start_bg_writer(bg_writer_config);
+        }
+        buffer_pool_manager->start_hot_page_saver(HOT_PAGE_FILE_NAME, std::chrono::seconds(HOT_PAGE_SAVE_INTERVAL_S));
 
         // 开启服务端，开始接受客户端连接
         start_server();
@@ -0,0 +1,293 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/async_io.h"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <unordered_map>
+
+#include "errors.h"
+
+namespace {
+
+/* 同步实现：prep时只记录请求，submit时逐个调用pread/pwrite */
+class SyncIo : public AsyncIo {
+   public:
+    explicit SyncIo(unsigned depth) : depth_(depth) {}
+
+    void prep_read(int fd, page_id_t page_no, char *buf, int num_bytes, uint64_t tag) override {
+        pending_.push_back({fd, page_no, buf, num_bytes, false, tag});
+    }
+
+    void prep_write(int fd, page_id_t page_no, const char *buf, int num_bytes, uint64_t tag) override {
+        pending_.push_back({fd, page_no, const_cast<char *>(buf), num_bytes, true, tag});
+    }
+
+    void prep_readv(int fd, page_id_t start_page_no, char **bufs, int n, uint64_t tag) override {
+        Request req = {fd, start_page_no, nullptr, n * PAGE_SIZE, false, tag};
+        for (int i = 0; i < n; i++) {
+            req.iov.push_back({bufs[i], PAGE_SIZE});
+        }
+        pending_.push_back(std::move(req));
+    }
+
+    int submit() override {
+        for (auto &req : pending_) {
+            off_t offset_in_file = static_cast<off_t>(req.page_no) * PAGE_SIZE;
+            ssize_t ret;
+            if (!req.iov.empty()) {
+                ret = preadv(req.fd, req.iov.data(), req.iov.size(), offset_in_file);
+            } else if (req.is_write) {
+                ret = pwrite(req.fd, req.buf, req.num_bytes, offset_in_file);
+            } else {
+                ret = pread(req.fd, req.buf, req.num_bytes, offset_in_file);
+            }
+            done_.push_back({req.tag, ret < 0 ? -errno : static_cast<int>(ret)});
+        }
+        int n = pending_.size();
+        pending_.clear();
+        return n;
+    }
+
+    int wait(std::vector<IoCompletion> *completions, __attribute__((unused)) int min_complete) override {
+        int n = done_.size();
+        completions->insert(completions->end(), done_.begin(), done_.end());
+        done_.clear();
+        return n;
+    }
+
+    int in_flight() const override { return done_.size(); }
+
+    unsigned depth() const override { return depth_; }
+
+    IoBackendType type() const override { return IoBackendType::SYNC; }
+
+   private:
+    struct Request {
+        int fd;
+        page_id_t page_no;
+        char *buf;
+        int num_bytes;
+        bool is_write;
+        uint64_t tag;
+        std::vector<struct iovec> iov;  // 向量读请求的各个缓冲区，非空时忽略buf
+    };
+    unsigned depth_;
+    std::vector<Request> pending_;
+    std::vector<IoCompletion> done_;
+};
+
+/* io_uring实现，直接使用系统调用，不依赖liburing */
+class UringIo : public AsyncIo {
+   public:
+    explicit UringIo(unsigned depth) : depth_(depth) {}
+
+    ~UringIo() override {
+        if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+        if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) munmap(cq_ptr_, cq_ring_size_);
+        if (sq_ptr_ != nullptr) munmap(sq_ptr_, sq_ring_size_);
+        if (ring_fd_ >= 0) close(ring_fd_);
+    }
+
+    /**
+     * @description: 创建io_uring实例并映射SQ/CQ环形队列
+     * @return {bool} 内核不支持或没有权限时返回false
+     */
+    bool init() {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        ring_fd_ = syscall(__NR_io_uring_setup, depth_, &params);
+        if (ring_fd_ < 0) {
+            return false;
+        }
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        }
+        sq_ptr_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                       IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) {
+            sq_ptr_ = nullptr;
+            return false;
+        }
+        if (single_mmap) {
+            cq_ptr_ = sq_ptr_;
+        } else {
+            cq_ptr_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                           IORING_OFF_CQ_RING);
+            if (cq_ptr_ == MAP_FAILED) {
+                cq_ptr_ = nullptr;
+                return false;
+            }
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                          IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return false;
+        }
+        sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+        char *sq = static_cast<char *>(sq_ptr_);
+        sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        char *cq = static_cast<char *>(cq_ptr_);
+        cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        depth_ = params.sq_entries;
+        return true;
+    }
+
+    void prep_read(int fd, page_id_t page_no, char *buf, int num_bytes, uint64_t tag) override {
+        prep(IORING_OP_READ, fd, page_no, buf, num_bytes, tag);
+    }
+
+    void prep_write(int fd, page_id_t page_no, const char *buf, int num_bytes, uint64_t tag) override {
+        prep(IORING_OP_WRITE, fd, page_no, const_cast<char *>(buf), num_bytes, tag);
+    }
+
+    void prep_readv(int fd, page_id_t start_page_no, char **bufs, int n, uint64_t tag) override {
+        // 内核在请求完成前都会访问iovec数组，需要保存到收集完成结果为止
+        auto &iov = iovecs_[tag];
+        iov.clear();
+        for (int i = 0; i < n; i++) {
+            iov.push_back({bufs[i], PAGE_SIZE});
+        }
+        prep(IORING_OP_READV, fd, start_page_no, reinterpret_cast<char *>(iov.data()), n, tag);
+    }
+
+    int submit() override {
+        int to_submit = prepared_;
+        // 内核可能只接受一部分请求，循环直到全部提交
+        while (prepared_ > 0) {
+            int ret = syscall(__NR_io_uring_enter, ring_fd_, prepared_, 0, 0, nullptr, 0);
+            if (ret < 0) {
+                if (errno == EINTR || errno == EAGAIN) continue;
+                throw UnixError();
+            }
+            prepared_ -= ret;
+        }
+        in_flight_ += to_submit;
+        return to_submit;
+    }
+
+    int wait(std::vector<IoCompletion> *completions, int min_complete) override {
+        min_complete = std::min(min_complete, in_flight_);
+        int reaped = reap(completions);
+        while (reaped < min_complete) {
+            int ret = syscall(__NR_io_uring_enter, ring_fd_, 0, min_complete - reaped, IORING_ENTER_GETEVENTS,
+                              nullptr, 0);
+            if (ret < 0 && errno != EINTR) {
+                throw UnixError();
+            }
+            reaped += reap(completions);
+        }
+        return reaped;
+    }
+
+    int in_flight() const override { return in_flight_; }
+
+    unsigned depth() const override { return depth_; }
+
+    IoBackendType type() const override { return IoBackendType::URING; }
+
+   private:
+    // 对于IORING_OP_READV，buf为iovec数组，num_bytes为iovec的个数
+    void prep(uint8_t opcode, int fd, page_id_t page_no, char *buf, int num_bytes, uint64_t tag) {
+        if (in_flight_ + prepared_ >= static_cast<int>(depth_)) {
+            throw InternalError("AsyncIo::prep queue is full");
+        }
+        unsigned tail = *sq_tail_;
+        unsigned index = tail & sq_mask_;
+        io_uring_sqe *sqe = &sqes_[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = opcode;
+        sqe->fd = fd;
+        sqe->off = static_cast<uint64_t>(page_no) * PAGE_SIZE;
+        sqe->addr = reinterpret_cast<uint64_t>(buf);
+        sqe->len = num_bytes;
+        sqe->user_data = tag;
+        sq_array_[index] = index;
+        // 内核通过tail看到新的sqe，必须保证sqe的内容先于tail写入
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        prepared_++;
+    }
+
+    int reap(std::vector<IoCompletion> *completions) {
+        int n = 0;
+        unsigned head = *cq_head_;
+        while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+            io_uring_cqe *cqe = &cqes_[head & cq_mask_];
+            completions->push_back({cqe->user_data, cqe->res});
+            iovecs_.erase(cqe->user_data);
+            head++;
+            n++;
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        in_flight_ -= n;
+        return n;
+    }
+
+    unsigned depth_;
+    int ring_fd_ = -1;
+    int prepared_ = 0;   // 已写入SQ但还未提交的请求数
+    int in_flight_ = 0;  // 已提交但还未收集的请求数
+
+    void *sq_ptr_ = nullptr;
+    void *cq_ptr_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    size_t cq_ring_size_ = 0;
+    io_uring_sqe *sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+
+    unsigned *sq_head_;
+    unsigned *sq_tail_;
+    unsigned sq_mask_;
+    unsigned *sq_array_;
+    unsigned *cq_head_;
+    unsigned *cq_tail_;
+    unsigned cq_mask_;
+    io_uring_cqe *cqes_;
+
+    std::unordered_map<uint64_t, std::vector<struct iovec>> iovecs_;  // 在途向量读请求的iovec数组，按tag索引
+};
+
+}  // namespace
+
+std::unique_ptr<AsyncIo> AsyncIo::create(IoBackendType type, unsigned depth) {
+    if (type == IoBackendType::URING) {
+        auto uring = std::make_unique<UringIo>(depth);
+        if (uring->init()) {
+            return uring;
+        }
+    }
+    return std::make_unique<SyncIo>(depth);
+}
+
+std::string io_backend_name(IoBackendType type) { return type == IoBackendType::URING ? "uring" : "sync"; }
+
+IoBackendType io_backend_from_name(const std::string &name) {
+    if (name == "uring") return IoBackendType::URING;
+    if (name == "sync") return IoBackendType::SYNC;
+    throw InternalError("Unknown io backend: " + name);
+}
@@ -0,0 +1,77 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+
+/* 页面异步I/O使用的后端类型 */
+enum class IoBackendType { SYNC, URING };
+
+/* 一个已完成的异步I/O请求 */
+struct IoCompletion {
+    uint64_t tag;  // 提交请求时由调用者指定，用于区分请求
+    int result;    // 读写的字节数，小于0时为-errno
+};
+
+/**
+ * @description: 页面读写的提交/完成队列。调用者先用prep_read/prep_write准备若干请求，
+ * 调用submit一次性提交，再用wait批量收集完成的请求。
+ * @note 一个AsyncIo对象只能被一个线程使用；同时在途的请求数不能超过创建时指定的depth
+ */
+class AsyncIo {
+   public:
+    virtual ~AsyncIo() = default;
+
+    /**
+     * @description: 创建指定类型的AsyncIo，io_uring不可用时退化为同步实现
+     * @param {IoBackendType} type 期望的后端类型
+     * @param {unsigned} depth 队列深度，即同时在途的最大请求数
+     */
+    static std::unique_ptr<AsyncIo> create(IoBackendType type, unsigned depth);
+
+    virtual void prep_read(int fd, page_id_t page_no, char *buf, int num_bytes, uint64_t tag) = 0;
+
+    virtual void prep_write(int fd, page_id_t page_no, const char *buf, int num_bytes, uint64_t tag) = 0;
+
+    /**
+     * @description: 准备一个向量读请求，把从start_page_no开始的n个连续页面分别读到bufs[0..n)中
+     * @note bufs指向的数组只需在本次调用期间有效，每个缓冲区的大小为PAGE_SIZE
+     */
+    virtual void prep_readv(int fd, page_id_t start_page_no, char **bufs, int n, uint64_t tag) = 0;
+
+    /**
+     * @description: 提交所有已准备的请求
+     * @return {int} 提交的请求个数
+     */
+    virtual int submit() = 0;
+
+    /**
+     * @description: 等待至少min_complete个请求完成，并把所有已完成的请求追加到completions中
+     * @return {int} 本次收集到的请求个数
+     */
+    virtual int wait(std::vector<IoCompletion> *completions, int min_complete) = 0;
+
+    /** @return 已提交但还未被wait收集的请求个数 */
+    virtual int in_flight() const = 0;
+
+    virtual unsigned depth() const = 0;
+
+    virtual IoBackendType type() const = 0;
+};
+
+std::string io_backend_name(IoBackendType type);
+
+IoBackendType io_backend_from_name(const std::string &name);
@@ -0,0 +1,59 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "disk_manager.h"
+#include "gtest/gtest.h"
+
+/**
+ * @description: 各层性能测试共用的fixture，性能测试只输出吞吐量，不作为正确性测试的计分项
+ * 每个测试在以db_name命名的空目录中运行，结束后删除该目录
+ */
+class BenchFixture : public ::testing::Test {
+   public:
+    std::unique_ptr<DiskManager> disk_manager_;
+
+   protected:
+    explicit BenchFixture(std::string db_name) : db_name_(std::move(db_name)) {}
+
+    void SetUp() override {
+        ::testing::Test::SetUp();
+        disk_manager_ = std::make_unique<DiskManager>();
+        if (disk_manager_->is_dir(db_name_)) {
+            disk_manager_->destroy_dir(db_name_);
+        }
+        disk_manager_->create_dir(db_name_);
+        if (chdir(db_name_.c_str()) < 0) {
+            throw UnixError();
+        }
+    }
+
+    void TearDown() override {
+        if (chdir("..") < 0) {
+            throw UnixError();
+        }
+        disk_manager_->destroy_dir(db_name_);
+    }
+
+    static double elapsed_seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+   private:
+    std::string db_name_;  // 存放测试文件的根目录名
+};
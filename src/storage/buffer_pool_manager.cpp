@@ -10,93 +10,420 @@ See the Mulan PSL v2 for more details. */
 
 #include "buffer_pool_manager.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
+
 #include "common/logger.h"
 /**
- * @description: 从free_list或replacer中得到可淘汰帧页的 *frame_id
+ * @description: 从分区的free_list或replacer中得到可淘汰帧页的 *frame_id，调用者需持有分区的latch_
  * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
+ * @param {BufferPoolShard&} shard 分区
  * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
  */
-bool BufferPoolManager::find_victim_page(frame_id_t* frame_id) {
-    // 1 使用BufferPoolManager::free_list_判断缓冲池是否已满需要淘汰页面
-    if (!free_list_.empty()) {
-        // 1.1 未满获得frame
-        *frame_id = free_list_.front();
-        free_list_.pop_front();
+bool BufferPoolManager::find_victim_page(BufferPoolShard& shard, frame_id_t* frame_id) {
+    // 1 使用分区的free_list_和未使用过的帧判断分区是否已满需要淘汰页面
+    if (!shard.free_list_.empty()) {
+        // 1.1 未满获得frame，空闲帧的pin_count_已经为-1
+        *frame_id = shard.free_list_.back();
+        shard.free_list_.pop_back();
+        return true;
+    }
+    if (shard.next_unused_frame_ < shard.end_frame_) {
+        // 帧第一次被使用，构造它的Page对象
+        *frame_id = shard.next_unused_frame_++;
+        auto page = new (pages_ + *frame_id) Page(frames_ + static_cast<size_t>(*frame_id) * PAGE_SIZE);
+        page->pin_count_ = -1;
         return true;
     }
-    // 1.2 已满使用lru_replacer中的方法选择淘汰页面
-    bool flag = replacer_->victim(frame_id);
-    return flag;
+    // 1.2 已满则按replacer的淘汰顺序检查候选帧。命中缓冲池时不经过replacer，候选帧可能最近被访问过，
+    //     这时把访问告知replacer，由置换策略调整它的位置；正被固定的帧留在原处，之后跳过。每个帧最多被检查两次
+    size_t max_tries = 2 * shard.replacer_->Size();
+    size_t num_pinned = 0;  // 排在淘汰顺序前面、正被固定的帧数
+    std::vector<frame_id_t> candidates;
+    for (size_t tries = 0; tries < max_tries;) {
+        shard.replacer_->victim_candidates(&candidates, num_pinned + VICTIM_SCAN_BATCH);
+        if (candidates.size() <= num_pinned) {
+            return false;
+        }
+        for (size_t i = num_pinned; i < candidates.size(); i++) {
+            frame_id_t victim_id = candidates[i];
+            auto page = pages_ + victim_id;
+            if (page->referenced_.exchange(false, std::memory_order_relaxed)) {
+                shard.replacer_->access(victim_id);
+            } else if (try_claim(page)) {
+                shard.replacer_->remove_victim(victim_id);
+                *frame_id = victim_id;
+                return true;
+            } else {
+                num_pinned++;
+            }
+            tries++;
+        }
+    }
+    return false;
 }
 
 /**
- * @description: 更新页面数据, 如果为脏页则需写入磁盘，再更新为新页面，更新page元数据(data, is_dirty, page_id)和page
- * table
- * @param {Page*} page 写回页指针
+ * @description: 按访问策略得到可替换帧：先尝试复用策略在该分区的环中的下一个帧，它必须仍存放着通过该策略装入的页面、
+ *              没有被其他查询访问过且未被固定；否则按find_victim_page正常得到一个帧，放入环中替代原来的帧。
+ *              调用者需持有分区的latch_
+ * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
+ * @param {BufferPoolShard&} shard 分区
+ * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
+ * @param {BufferAccessStrategy*} strategy 访问策略，为nullptr时与find_victim_page(shard, frame_id)相同
+ * @param {PageId} new_page_id 将要装入该帧的页面
+ */
+bool BufferPoolManager::find_victim_page(BufferPoolShard& shard, frame_id_t* frame_id, BufferAccessStrategy* strategy,
+                                         PageId new_page_id) {
+    if (strategy == nullptr) {
+        return find_victim_page(shard, frame_id);
+    }
+    auto& ring = strategy->rings_[&shard - shards_.get()];
+    auto& slot = ring.slots[ring.next];
+    ring.next = (ring.next + 1) % ring.slots.size();
+    if (slot.frame_id != INVALID_FRAME_ID) {
+        // 帧中的页面只在分区的latch下改变，核对之后不会再变
+        auto page = pages_ + slot.frame_id;
+        if (page->get_page_id() == slot.page_id && !page->referenced_.load(std::memory_order_relaxed) &&
+            try_claim(page)) {
+            shard.replacer_->pin(slot.frame_id);
+            slot.page_id = new_page_id;
+            strategy->num_reused_++;
+            *frame_id = slot.frame_id;
+            return true;
+        }
+    }
+    if (!find_victim_page(shard, frame_id)) {
+        return false;
+    }
+    slot = {*frame_id, new_page_id};
+    return true;
+}
+
+/**
+ * @description: 把帧更新为新页面，更新page元数据(data, page_id)和page table。帧需已被占用（pin_count_为-1），
+ * 其中的旧页面已经写回，由调用者在装入页面后设置pin_count_。调用者需持有分区的latch_
+ * @param {BufferPoolShard&} shard 帧所在的分区，新旧页面都属于该分区
+ * @param {Page*} page 帧中的页面
  * @param {PageId} new_page_id 新的page_id
  * @param {frame_id_t} new_frame_id 新的帧frame_id
  */
-void BufferPoolManager::update_page(Page* page, PageId new_page_id, frame_id_t new_frame_id) {
-    // std::scoped_lock lock{latch_};
+void BufferPoolManager::update_page(BufferPoolShard& shard, Page* page, PageId new_page_id, frame_id_t new_frame_id) {
+    assert(!page->is_dirty_);
+    if (page->prefetched_.exchange(false, std::memory_order_relaxed)) {
+        num_prefetch_wasted_++;
+    }
+    // 1 更新page table
+    if (page->get_page_id().page_no != INVALID_PAGE_ID) {
+        shard.page_table_->erase(page->get_page_id());
+    }
+    if (new_page_id.page_no == INVALID_PAGE_ID) {
+        LOG_DEBUG("update invalid page id");
+    }
+    shard.page_table_->insert(new_page_id, new_frame_id);
+    // 2 重置page的data，更新page id
+    page->reset_memory();
+    page->set_page_id(new_page_id);
+    page->referenced_ = false;
+}
 
-    // 1 如果是脏页，写回磁盘，并且把dirty置为false
+/**
+ * @description: 为page_id占用一个帧，并把帧标记为I/O进行中。调用时和返回时都持有分区的latch_：
+ *              如果帧中的旧页面是脏页，先把page_id登记到页表，再释放latch_写回旧页面，这期间请求新旧两个页面的线程
+ *              都在该帧上等待，其他线程不受影响；写回后重新加锁，把帧更新为page_id。
+ *              返回后调用者释放latch_读入页面，再调用finish_io；出错时调用abort_io
+ * @return {bool} 没有可用帧时返回false
+ * @param {BufferPoolShard&} shard 页面所在的分区
+ * @param {unique_lock<mutex>&} lock 分区latch_上的锁
+ * @param {PageId} page_id 将要装入的页面
+ * @param {BufferAccessStrategy*} strategy 访问策略，可以为nullptr
+ * @param {frame_id_t*} frame_id 返回占用的帧
+ */
+bool BufferPoolManager::reserve_frame(BufferPoolShard& shard, std::unique_lock<std::mutex>& lock, PageId page_id,
+                                      BufferAccessStrategy* strategy, frame_id_t* frame_id) {
+    if (!find_victim_page(shard, frame_id, strategy, page_id)) {
+        return false;
+    }
+    auto page = pages_ + *frame_id;
+    page->io_in_progress_ = true;
     if (page->is_dirty_) {
-        if (log_manager_->get_persist_lsn_() < page->get_page_lsn()) {
-            log_manager_->flush_log_to_disk();
+        // 1 先登记新页面，这样在写回期间其他线程不会为它再分配一个帧
+        num_dirty_evictions_++;
+        shard.page_table_->insert(page_id, *frame_id);
+        lock.unlock();
+        try {
+            if (log_manager_ != nullptr && log_manager_->get_persist_lsn_() < page->get_page_lsn()) {
+                log_manager_->flush_log_to_disk();
+            }
+            disk_manager_->write_page(page->get_page_id().fd, page->get_page_id().page_no, page->data_, PAGE_SIZE);
+        } catch (...) {
+            // 写回失败，旧页面留在帧中，新页面不再登记
+            lock.lock();
+            shard.page_table_->erase(page_id);
+            shard.replacer_->unpin(*frame_id);
+            page->io_in_progress_ = false;
+            page->pin_count_.store(0, std::memory_order_release);
+            shard.io_cv_.notify_all();
+            throw;
         }
-        disk_manager_->write_page(page->get_page_id().fd, page->get_page_id().page_no, page->data_, PAGE_SIZE);
+        lock.lock();
         page->is_dirty_ = false;
     }
-    // 2 更新page table
-    page_table_.erase(page->get_page_id());
-    if (new_page_id.page_no == INVALID_PAGE_ID) {
-        LOG_DEBUG("update invalid page id");
+    // 2 帧中不再有旧页面，请求旧页面的线程之后会从磁盘读取写回的数据
+    update_page(shard, page, page_id, *frame_id);
+    return true;
+}
+
+/**
+ * @description: 帧的I/O完成，把帧交还给replacer并按pin_count固定，唤醒等待该帧的线程
+ * @param {BufferPoolShard&} shard 帧所在的分区，调用者不能持有其latch_
+ * @param {frame_id_t} frame_id 帧号
+ * @param {int} pin_count 调用者对页面的固定次数
+ */
+void BufferPoolManager::finish_io(BufferPoolShard& shard, frame_id_t frame_id, int pin_count) {
+    {
+        std::scoped_lock lock{shard.latch_};
+        auto page = pages_ + frame_id;
+        shard.replacer_->unpin(frame_id);
+        page->io_in_progress_ = false;
+        page->pin_count_.store(pin_count, std::memory_order_release);
     }
-    page_table_.emplace(new_page_id, new_frame_id);
-    // 3 重置page的data，更新page id
+    shard.io_cv_.notify_all();
+}
+
+/**
+ * @description: 读入页面失败，把页面从页表中删除，帧放回free_list_，唤醒等待该帧的线程，它们之后会重新读取。
+ *              调用者需持有分区的latch_
+ */
+void BufferPoolManager::abort_io(BufferPoolShard& shard, frame_id_t frame_id, PageId page_id) {
+    auto page = pages_ + frame_id;
+    shard.page_table_->erase(page_id);
     page->reset_memory();
-    page->set_page_id(new_page_id);
-    page->pin_count_ = 0;
+    page->set_page_id({.fd = -1, .page_no = INVALID_PAGE_ID});
+    page->io_in_progress_ = false;
+    shard.free_list_.push_back(frame_id);
+    shard.io_cv_.notify_all();
 }
 
 /**
  * @description: 从buffer pool获取需要的页。
- *              如果页表中存在page_id（说明该page在缓冲池中），并且pin_count++。
+ *              如果页表中存在page_id（说明该page在缓冲池中），并且pin_count++；页面正在读入时等待读入完成。
  *              如果页表不存在page_id（说明该page在磁盘中），则找缓冲池victim
- * page，将其替换为磁盘中读取的page，pin_count置1。
+ * page，将其替换为磁盘中读取的page，pin_count置1。读写磁盘时不持有分区的latch_
  * @return {Page*} 若获得了需要的页则将其返回，否则返回nullptr
  * @param {PageId} page_id 需要获取的页的PageId
+ * @param {BufferAccessStrategy*} strategy 访问策略，不为nullptr时缺失的页面读入策略的环形帧中，命中的页面不记为被访问过
  */
-Page* BufferPoolManager::fetch_page(PageId page_id) {
-    std::scoped_lock lock{latch_};
+Page* BufferPoolManager::fetch_page(PageId page_id, BufferAccessStrategy* strategy) {
+    auto& shard = shard_of(page_id);
+
+    // 0.     不加锁地从page_table_中搜寻目标页并固定其所在frame。帧中的页面只在帧被占用时才会改变，
+    //        所以固定成功后再核对帧中的页面，一致即命中；否则撤销固定，加锁后重新查找
+    frame_id_t frame_id = shard.page_table_->find(page_id);
+    if (frame_id != INVALID_FRAME_ID) {
+        auto page = pages_ + frame_id;
+        if (try_pin(page)) {
+            if (page->get_page_id() == page_id) {
+                note_hit(page, strategy);
+                return page;
+            }
+            page->pin_count_.fetch_sub(1, std::memory_order_release);
+        }
+    }
 
+    std::unique_lock lock{shard.latch_};
     // 1.     从page_table_中搜寻目标页
-    auto iter = page_table_.find(page_id);
-    if (iter != page_table_.end()) {
-        // 1.1    若目标页有被page_table_记录，则将其所在frame固定(pin)，并返回目标页。
-        auto page = pages_ + iter->second;
-        replacer_->pin(iter->second);
-        page->pin_count_++;
-        return page;
-    }
-    // 1.2    否则，尝试调用find_victim_page获得一个可用的frame，若失败则返回nullptr
-    frame_id_t frame_id = -1;
-    if (!find_victim_page(&frame_id)) {
+    while ((frame_id = shard.page_table_->find(page_id)) != INVALID_FRAME_ID) {
+        auto page = pages_ + frame_id;
+        if (!page->io_in_progress_) {
+            // 1.1    若目标页有被page_table_记录，则将其所在frame固定(pin)，并返回目标页。
+            page->pin_count_++;
+            note_hit(page, strategy);
+            return page;
+        }
+        // 1.2    目标页正在读入，或帧中的旧页面正在写回，等待后重新查找
+        shard.io_cv_.wait(lock);
+    }
+    // 1.3    否则，尝试调用reserve_frame获得一个可用的frame，若失败则返回nullptr
+    num_fetch_misses_++;
+    if (!reserve_frame(shard, lock, page_id, strategy, &frame_id)) {
         return nullptr;
     }
-    // 2.     若获得的可用frame存储的为dirty page，则须调用update_page将page写回到磁盘
+    lock.unlock();
+
+    // 2.     调用disk_manager_的read_page读取目标页到frame
     auto page = pages_ + frame_id;
-    update_page(page, page_id, frame_id);
-
-    // 3.     调用disk_manager_的read_page读取目标页到frame
-    disk_manager_->read_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
-    // 4.     固定目标页，更新pin_count_
-    replacer_->pin(frame_id);
-    page->pin_count_ = 1;
-    // 5.     返回目标页
+    try {
+        disk_manager_->read_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
+    } catch (...) {
+        lock.lock();
+        abort_io(shard, frame_id, page_id);
+        throw;
+    }
+    // 3.     固定目标页，更新pin_count_，之后其他线程才能固定该帧
+    finish_io(shard, frame_id, 1);
+    // 4.     返回目标页
     return page;
 }
 
+/**
+ * @description: 把若干页面批量读入缓冲池。页面号连续的缺失页面合并为一个向量读请求，
+ *              读请求批量提交给异步I/O队列，再批量收集完成结果。
+ *              已在缓冲池中的页面会被跳过；读入的页面不被固定，可以被正常淘汰。
+ * @return {int} 实际发起读取的页面个数，可用帧不足时只读取前面的一部分
+ * @param {int} fd 页面所在文件的文件句柄
+ * @param {vector<page_id_t>&} page_nos 需要预取的页面编号
+ * @param {BufferAccessStrategy*} strategy 访问策略，不为nullptr时页面读入策略的环形帧中
+ */
+int BufferPoolManager::prefetch_pages(int fd, const std::vector<page_id_t>& page_nos, BufferAccessStrategy* strategy) {
+    if (num_shards_ == 1) {
+        return prefetch_shard_pages(shards_[0], fd, page_nos, strategy);
+    }
+    // 按分区拆分，每个分区内保持原来的顺序
+    std::vector<std::vector<page_id_t>> shard_page_nos(num_shards_);
+    for (auto page_no : page_nos) {
+        shard_page_nos[&shard_of({.fd = fd, .page_no = page_no}) - shards_.get()].push_back(page_no);
+    }
+    int num_read = 0;
+    for (size_t i = 0; i < num_shards_; i++) {
+        if (!shard_page_nos[i].empty()) {
+            num_read += prefetch_shard_pages(shards_[i], fd, shard_page_nos[i], strategy);
+        }
+    }
+    return num_read;
+}
+
+/**
+ * @description: prefetch_pages在一个分区内的部分，page_nos中的页面都属于该分区。
+ *              在latch_下为页面占用帧，之后不持有latch_读取，读完的页面逐段发布
+ */
+int BufferPoolManager::prefetch_shard_pages(BufferPoolShard& shard, int fd, const std::vector<page_id_t>& page_nos,
+                                            BufferAccessStrategy* strategy) {
+    // 1. 为不在缓冲池中的页面占用帧并登记到页表，这样其他线程不会重复读取，而是等待读取完成；
+    //    同时把页面号连续的帧划分为一段，每段对应一个读请求
+    std::vector<frame_id_t> frames;
+    std::vector<size_t> run_begin;  // 第i段为frames[run_begin[i], run_begin[i+1])
+    {
+        std::unique_lock lock{shard.latch_};
+        for (auto page_no : page_nos) {
+            PageId page_id = {.fd = fd, .page_no = page_no};
+            if (shard.page_table_->find(page_id) != INVALID_FRAME_ID) {
+                continue;
+            }
+            frame_id_t frame_id = -1;
+            if (!reserve_frame(shard, lock, page_id, strategy, &frame_id)) {
+                break;
+            }
+            size_t run_len = frames.size() - (run_begin.empty() ? 0 : run_begin.back());
+            if (run_begin.empty() || pages_[frames.back()].get_page_id().page_no + 1 != page_no ||
+                run_len == static_cast<size_t>(MAX_READ_RUN_PAGES)) {
+                run_begin.push_back(frames.size());
+            }
+            frames.push_back(frame_id);
+        }
+    }
+    size_t num_runs = run_begin.size();
+    run_begin.push_back(frames.size());
+    if (num_runs == 0) {
+        return 0;
+    }
+
+    // 读完一段后在latch_下发布：读取失败时放弃这些页面，之后的fetch_page会重新读取；
+    // 短读只会发生在文件末尾，剩余部分在update_page中已经清零
+    auto publish_run = [&](size_t run, bool ok) {
+        {
+            std::scoped_lock lock{shard.latch_};
+            for (size_t i = run_begin[run]; i < run_begin[run + 1]; i++) {
+                frame_id_t frame_id = frames[i];
+                auto page = pages_ + frame_id;
+                if (!ok) {
+                    abort_io(shard, frame_id, page->get_page_id());
+                    continue;
+                }
+                shard.replacer_->unpin(frame_id);
+                page->prefetched_.store(true, std::memory_order_relaxed);
+                page->io_in_progress_ = false;
+                page->pin_count_.store(0, std::memory_order_release);
+                num_prefetched_++;
+            }
+        }
+        shard.io_cv_.notify_all();
+    };
+
+    std::vector<char*> bufs;
+    if (disk_manager_->is_compressed(fd)) {
+        // 压缩文件的页面需要解压，且相邻页面在文件中不一定连续，由disk_manager_逐页同步读取
+        for (size_t run = 0; run < num_runs; run++) {
+            bufs.clear();
+            for (size_t i = run_begin[run]; i < run_begin[run + 1]; i++) {
+                bufs.push_back(pages_[frames[i]].data_);
+            }
+            page_id_t start_page_no = pages_[frames[run_begin[run]]].get_page_id().page_no;
+            bool ok = true;
+            try {
+                disk_manager_->read_pages(fd, start_page_no, bufs.size(), bufs.data());
+            } catch (...) {
+                ok = false;
+            }
+            publish_run(run, ok);
+        }
+        return frames.size();
+    }
+
+    // 2. 队列中有空位就继续准备读请求，再用一次提交把它们交给内核，tag为段号
+    std::scoped_lock io_lock{shard.io_latch_};
+    if (shard.async_io_ == nullptr) {
+        shard.async_io_ = disk_manager_->create_async_io(IO_QUEUE_DEPTH);
+    }
+    auto& async_io = shard.async_io_;
+    std::vector<IoCompletion> completions;
+    size_t next = 0;
+    while (next < num_runs || async_io->in_flight() > 0) {
+        int num_prepared = 0;
+        while (next < num_runs && async_io->in_flight() + num_prepared < static_cast<int>(async_io->depth())) {
+            bufs.clear();
+            for (size_t i = run_begin[next]; i < run_begin[next + 1]; i++) {
+                bufs.push_back(pages_[frames[i]].data_);
+            }
+            page_id_t start_page_no = pages_[frames[run_begin[next]]].get_page_id().page_no;
+            if (bufs.size() == 1) {
+                async_io->prep_read(fd, start_page_no, bufs[0], PAGE_SIZE, next);
+            } else {
+                async_io->prep_readv(fd, start_page_no, bufs.data(), bufs.size(), next);
+            }
+            next++;
+            num_prepared++;
+        }
+        if (num_prepared > 0) {
+            async_io->submit();
+        }
+        completions.clear();
+        async_io->wait(&completions, 1);
+        for (auto& completion : completions) {
+            publish_run(completion.tag, completion.result >= 0);
+        }
+    }
+    return frames.size();
+}
+
+/**
+ * @description: 把从start_page_no开始的n个连续页面读入缓冲池，连续的缺失页面用一次向量读完成
+ * @return {int} 实际发起读取的页面个数
+ * @param {int} fd 页面所在文件的文件句柄
+ * @param {page_id_t} start_page_no 起始页面编号
+ * @param {int} n 页面个数
+ * @param {BufferAccessStrategy*} strategy 访问策略，不为nullptr时页面读入策略的环形帧中
+ */
+int BufferPoolManager::fetch_range(int fd, page_id_t start_page_no, int n, BufferAccessStrategy* strategy) {
+    std::vector<page_id_t> page_nos(n);
+    for (int i = 0; i < n; i++) {
+        page_nos[i] = start_page_no + i;
+    }
+    return prefetch_pages(fd, page_nos, strategy);
+}
+
 /**
  * @description: 取消固定pin_count>0的在缓冲池中的page
  * @return {bool} 如果目标页的pin_count<=0则返回false，否则返回true
@@ -104,32 +431,56 @@ Page* BufferPoolManager::fetch_page(PageId page_id) {
  * @param {bool} is_dirty 若目标page应该被标记为dirty则为true，否则为false
  */
 bool BufferPoolManager::unpin_page(PageId page_id, bool is_dirty) {
+    auto& shard = shard_of(page_id);
+
+    // 0. 不加锁的路径：先额外固定一次，这样帧中的页面不会改变；核对页面、确认固定之前pin_count_大于0后，
+    //    设置脏页标记，再一次减去两次固定。脏页标记在pin_count_减少之前设置，替换该帧的线程一定能看到
+    frame_id_t frame_id = shard.page_table_->find(page_id);
+    if (frame_id != INVALID_FRAME_ID) {
+        auto page = pages_ + frame_id;
+        int pin_count = page->pin_count_.load(std::memory_order_relaxed);
+        while (pin_count >= 0 &&
+               !page->pin_count_.compare_exchange_weak(pin_count, pin_count + 1, std::memory_order_acquire)) {
+        }
+        if (pin_count >= 0) {
+            bool is_target = page->get_page_id() == page_id;
+            if (is_target && pin_count > 0) {
+                if (is_dirty) {
+                    page->is_dirty_ = true;
+                }
+                page->pin_count_.fetch_sub(2, std::memory_order_release);
+                return true;
+            }
+            page->pin_count_.fetch_sub(1, std::memory_order_release);
+            if (is_target) {
+                // 目标页在缓冲池中但没有被固定
+                return false;
+            }
+        }
+    }
+
     // 0. lock latch
-    std::scoped_lock lock{latch_};
+    std::scoped_lock lock{shard.latch_};
 
     // 1. 尝试在page_table_中搜寻page_id对应的页P
-    auto iter = page_table_.find(page_id);
-    if (iter == page_table_.end()) {
+    frame_id = shard.page_table_->find(page_id);
+    if (frame_id == INVALID_FRAME_ID) {
         // 1.1 目标页P没有被page_table_记录 ，返回false
         return false;
     }
     // 1.2 P在页表中存在，获取其pin_count_
-    auto page = pages_ + iter->second;
+    auto page = pages_ + frame_id;
 
     // 2.1 若pin_count_已经等于0，则返回false
     if (page->pin_count_ <= 0) {
         return false;
     }
-    // 2.2 若pin_count_大于0，则pin_count_自减一
-    // 2.2.1 若自减后等于0，则调用replacer_的Unpin
-    if (--page->pin_count_ == 0) {
-        replacer_->unpin(iter->second);
-    }
-    // 3 根据参数is_dirty，更改P的is_dirty_
-    // 3.1 不会轻易把true变false
-    if (!page->is_dirty_) {
-        page->is_dirty_ = is_dirty;
+    // 2.2 根据参数is_dirty，更改P的is_dirty_，不会轻易把true变false
+    if (is_dirty) {
+        page->is_dirty_ = true;
     }
+    // 3 pin_count_自减一。帧一直在replacer中，替换时会跳过被固定的帧
+    page->pin_count_.fetch_sub(1, std::memory_order_release);
     return true;
 }
 
@@ -140,17 +491,22 @@ bool BufferPoolManager::unpin_page(PageId page_id, bool is_dirty) {
  */
 bool BufferPoolManager::flush_page(PageId page_id) {
     // 0. lock latch
-    std::scoped_lock lock{latch_};
-    // 1. 查找页表,尝试获取目标页P
-    auto iter = page_table_.find(page_id);
-    if (iter == page_table_.end()) {
+    auto& shard = shard_of(page_id);
+    std::unique_lock lock{shard.latch_};
+    // 1. 查找页表,尝试获取目标页P，P正在读入或帧正在写回时等待
+    frame_id_t frame_id;
+    while ((frame_id = shard.page_table_->find(page_id)) != INVALID_FRAME_ID && pages_[frame_id].io_in_progress_) {
+        shard.io_cv_.wait(lock);
+    }
+    if (frame_id == INVALID_FRAME_ID) {
         // 1.1 目标页P没有被page_table_记录 ，返回false
         return false;
     }
     // 2. 无论P是否为脏都将其写回磁盘。
-    auto page = pages_ + iter->second;
+    auto page = pages_ + frame_id;
     disk_manager_->write_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
     // 3. 更新P的is_dirty_
+    page->is_dirty_ = false;
     return true;
 }
 
@@ -158,108 +514,647 @@ bool BufferPoolManager::flush_page(PageId page_id) {
  * @description: 创建一个新的page，即从磁盘中移动一个新建的空page到缓冲池某个位置。
  * @return {Page*} 返回新创建的page，若创建失败则返回nullptr
  * @param {PageId*} page_id 当成功创建一个新的page时存储其page_id
+ * @param {BufferAccessStrategy*} strategy 访问策略，不为nullptr时新页面放在策略的环形帧中，复用时写回
  */
-Page* BufferPoolManager::new_page(PageId* page_id) {
-    std::scoped_lock lock{latch_};
+Page* BufferPoolManager::new_page(PageId* page_id, BufferAccessStrategy* strategy) {
+    // 1.   在fd对应的文件分配一个新的page_id，页面号决定了页面所在的分区
+    page_id->page_no = disk_manager_->allocate_page(page_id->fd);  //一个page_id 有fd和pageno两个属性
+    auto& shard = shard_of(*page_id);
+    std::unique_lock lock{shard.latch_};
 
-    // 1.   获得一个可用的frame，若无法获得则返回nullptr
+    // 2.   获得一个可用的frame，旧页面是脏页时在不持有latch_的情况下写回，页表中的旧页面换为新页面；
+    //      若无法获得则归还页面号并返回nullptr
     frame_id_t frame_id = -1;
-    if (!find_victim_page(&frame_id)) {
+    if (!reserve_frame(shard, lock, *page_id, strategy, &frame_id)) {
+        lock.unlock();
+        disk_manager_->deallocate_page(page_id->fd, page_id->page_no);
+        page_id->page_no = INVALID_PAGE_ID;
         return nullptr;
     }
-    // 2.   在fd对应的文件分配一个新的page_id
-    page_id->page_no = disk_manager_->allocate_page(page_id->fd);  //一个page_id 有fd和pageno两个属性
-    page_table_.emplace(*page_id, frame_id);
 
-    // 3. 处理旧page
+    // 3.   固定frame，更新pin_count_；新页面不需要读取，还没有写入过磁盘，标记为脏页
     auto page = pages_ + frame_id;
-    // 3.1 从页表里删掉
-    update_page(page, *page_id, frame_id);
-    // 4.   固定frame，更新pin_count_
-    replacer_->pin(frame_id);
-    page->pin_count_ = 1;
-    // 5.   返回获得的page
+    page->is_dirty_ = true;
+    shard.replacer_->unpin(frame_id);
+    page->io_in_progress_ = false;
+    page->pin_count_.store(1, std::memory_order_release);
+    lock.unlock();
+    shard.io_cv_.notify_all();
+    // 4.   返回获得的page
     return page;
 }
 
+/**
+ * @description: 更换所有分区的置换策略，缓冲池中的页面按当前淘汰顺序加入新的replacer。
+ *              需要在没有其他线程访问缓冲池时调用，一般在启动时调用
+ * @param {string&} replacer_type LRU、LRU-K、2Q或CLOCK
+ */
+void BufferPoolManager::set_replacer(const std::string& replacer_type) {
+    std::vector<frame_id_t> frames;
+    for (size_t i = 0; i < num_shards_; i++) {
+        auto& shard = shards_[i];
+        std::scoped_lock lock{shard.latch_};
+        size_t begin = i * pool_size_ / num_shards_;
+        size_t end = (i + 1) * pool_size_ / num_shards_;
+        auto replacer = create_replacer(replacer_type, end - begin, static_cast<frame_id_t>(begin));
+        shard.replacer_->victim_candidates(&frames, shard.replacer_->Size());
+        for (auto frame_id : frames) {
+            replacer->unpin(frame_id);
+        }
+        shard.replacer_ = std::move(replacer);
+    }
+}
+
 /**
  * @description: 从buffer_pool删除目标页
  * @return {bool} 如果目标页不存在于buffer_pool或者成功被删除则返回true，若其存在于buffer_pool但无法删除则返回false
  * @param {PageId} page_id 目标页
  */
 bool BufferPoolManager::delete_page(PageId page_id) {
-    std::scoped_lock lock{latch_};
+    auto& shard = shard_of(page_id);
+    std::unique_lock lock{shard.latch_};
 
-    // 1.   在page_table_中查找目标页，若不存在返回true
-    auto iter = page_table_.find(page_id);
-    if (iter == page_table_.end()) {
+    // 1.   在page_table_中查找目标页，若不存在返回true；目标页正在读入或写回时等待
+    frame_id_t frame_id;
+    while ((frame_id = shard.page_table_->find(page_id)) != INVALID_FRAME_ID && pages_[frame_id].io_in_progress_) {
+        shard.io_cv_.wait(lock);
+    }
+    if (frame_id == INVALID_FRAME_ID) {
         return true;
     }
-    // 2.   若目标页的pin_count不为0，则返回false
-    auto page = pages_ + iter->second;
-    if (page->pin_count_ != 0) {
+    // 2.   若目标页的pin_count不为0，则返回false；否则占用该帧，其他线程不能再固定它
+    auto page = pages_ + frame_id;
+    if (!try_claim(page)) {
         return false;
     }
     // 3.1  将目标页数据写回磁盘，
     disk_manager_->write_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
-    // 3.2 从页表中删除目标页
-    page_table_.erase(page_id);
-    // 3.3 重置元数据 最佳方法是什么？
-    // page->set_page_id({});
+    // 3.2 从页表中删除目标页，该帧不能再被replacer淘汰
+    shard.page_table_->erase(page_id);
+    shard.replacer_->pin(frame_id);
+    // 3.3 重置元数据，空闲帧的pin_count_保持为-1
+    page->set_page_id({.fd = -1, .page_no = INVALID_PAGE_ID});
     page->is_dirty_ = false;
-    page->pin_count_ = 0;
+    page->prefetched_ = false;
     page->reset_memory();
     // 3.4加入free_list_
-    free_list_.push_back(iter->second);
+    shard.free_list_.push_back(frame_id);
     return true;
 }
 
 /**
- * @description: 将buffer_pool中的所有页写回到磁盘
+ * @description: 把若干脏帧写回磁盘，调用者需持有这些帧所在分区的latch_，或者已占用这些帧并标记为I/O进行中。
+ *              写之前清除脏页标记，写回失败时恢复。
+ *              帧按(fd, page_no)排序，页面号连续的帧合并为一次向量写
+ * @param {vector<frame_id_t>&} frames 需要写回的帧，函数内会对其排序
+ */
+void BufferPoolManager::write_back_frames(std::vector<frame_id_t>& frames) {
+    std::sort(frames.begin(), frames.end(),
+              [this](frame_id_t a, frame_id_t b) { return pages_[a].get_page_id() < pages_[b].get_page_id(); });
+    // 1. WAL：页面写回之前，页面上的修改对应的日志必须已经落盘
+    if (log_manager_ != nullptr) {
+        lsn_t max_lsn = INVALID_LSN;
+        for (auto frame_id : frames) {
+            max_lsn = std::max(max_lsn, pages_[frame_id].get_page_lsn());
+        }
+        if (log_manager_->get_persist_lsn_() < max_lsn) {
+            log_manager_->flush_log_to_disk();
+        }
+    }
+    // 2. 同一文件中页面号连续的帧为一段，每段一次向量写
+    std::vector<char*> bufs;
+    size_t begin = 0;
+    while (begin < frames.size()) {
+        PageId first = pages_[frames[begin]].get_page_id();
+        size_t end = begin;
+        bufs.clear();
+        while (end < frames.size() && bufs.size() < static_cast<size_t>(MAX_WRITE_RUN_PAGES)) {
+            PageId page_id = pages_[frames[end]].get_page_id();
+            if (page_id.fd != first.fd || page_id.page_no != first.page_no + static_cast<page_id_t>(bufs.size())) {
+                break;
+            }
+            bufs.push_back(pages_[frames[end]].data_);
+            end++;
+        }
+        // 写之前清除脏页标记：写的过程中其他线程不加锁地修改并取消固定页面时会重新标记，修改不会丢失
+        for (size_t i = begin; i < end; i++) {
+            pages_[frames[i]].is_dirty_.exchange(false);
+        }
+        try {
+            disk_manager_->write_pages(first.fd, first.page_no, bufs.size(), bufs.data());
+        } catch (...) {
+            for (size_t i = begin; i < end; i++) {
+                pages_[frames[i]].is_dirty_ = true;
+            }
+            throw;
+        }
+        begin = end;
+    }
+}
+
+/**
+ * @description: 将buffer_pool中属于文件fd的所有脏页写回到磁盘，各分区依次写回，最后fsync一次
  * @param {int} fd 文件句柄
  */
 void BufferPoolManager::flush_all_pages(int fd) {
-    std::scoped_lock lock{latch_};
-    for (const auto& pair : page_table_) {
-        auto page = pair.second + pages_;
-        // 要加一个fd的判断 参考自rucbase的函数
-        if (page->get_page_id().fd == fd) {
-            disk_manager_->write_page(fd, pair.first.page_no, page->get_data(), PAGE_SIZE);
-            page->is_dirty_ = false;
+    bool written = false;
+    std::vector<frame_id_t> frames;
+    for (size_t i = 0; i < num_shards_; i++) {
+        auto& shard = shards_[i];
+        std::unique_lock lock{shard.latch_};
+        // 等待该文件的帧的I/O完成：后台写线程写回的页面已清除脏页标记，写完之后才能fsync
+        while (true) {
+            bool in_progress = false;
+            frames.clear();
+            shard.page_table_->for_each([&](PageId page_id, frame_id_t frame_id) {
+                // 要加一个fd的判断 参考自rucbase的函数。正在写回旧页面的帧在页表中还登记了新页面，只按帧中的页面统计一次
+                if (page_id.fd == fd) {
+                    in_progress |= pages_[frame_id].io_in_progress_;
+                    if (pages_[frame_id].is_dirty_ && pages_[frame_id].get_page_id() == page_id) {
+                        frames.push_back(frame_id);
+                    }
+                }
+            });
+            if (!in_progress) {
+                break;
+            }
+            shard.io_cv_.wait(lock);
         }
+        write_back_frames(frames);
+        written |= !frames.empty();
+    }
+    if (written) {
+        disk_manager_->sync_file(fd);
     }
 
     // ref：https://github.com/ruc-deke/rucbase-lab/blob/main/src/storage/buffer_pool_manager.cpp
 }
+
+/**
+ * @description: 将buffer_pool中的所有脏页写回到磁盘，每个写过的文件最后fsync一次
+ */
 void BufferPoolManager::flush_all_pages() {
-    std::scoped_lock lock{latch_};
-    for (const auto& pair : page_table_) {
-        auto page = pair.second + pages_;
-        disk_manager_->write_page(pair.first.fd, pair.first.page_no, page->get_data(), PAGE_SIZE);
-        page->is_dirty_ = false;
+    std::set<int> written_fds;
+    std::vector<frame_id_t> frames;
+    for (size_t i = 0; i < num_shards_; i++) {
+        auto& shard = shards_[i];
+        std::unique_lock lock{shard.latch_};
+        while (true) {
+            bool in_progress = false;
+            frames.clear();
+            shard.page_table_->for_each([&](PageId page_id, frame_id_t frame_id) {
+                in_progress |= pages_[frame_id].io_in_progress_;
+                if (pages_[frame_id].is_dirty_ && pages_[frame_id].get_page_id() == page_id) {
+                    frames.push_back(frame_id);
+                }
+            });
+            if (!in_progress) {
+                break;
+            }
+            shard.io_cv_.wait(lock);
+        }
+        for (auto frame_id : frames) {
+            written_fds.insert(pages_[frame_id].get_page_id().fd);
+        }
+        write_back_frames(frames);
+    }
+    for (int fd : written_fds) {
+        disk_manager_->sync_file(fd);
     }
 
     // ref：https://github.com/ruc-deke/rucbase-lab/blob/main/src/storage/buffer_pool_manager.cpp
 }
 
 void BufferPoolManager::delete_all_pages(int fd) {
-    std::scoped_lock lock{latch_};
-    for (auto iter = page_table_.begin(); iter != page_table_.end();) {
-        // LOG_DEBUG()
-        auto page = pages_ + iter->second;
-        // 要加一个fd的判断 参考自rucbase的函数
-        if (page->get_page_id().fd == fd) {
-            replacer_->unpin(iter->second);
+    std::vector<frame_id_t> frames;
+    for (size_t i = 0; i < num_shards_; i++) {
+        auto& shard = shards_[i];
+        std::unique_lock lock{shard.latch_};
+        // 等待该文件的页面的I/O完成，之后不会再有该文件的帧处于I/O中
+        while (true) {
+            bool in_progress = false;
+            frames.clear();
+            shard.page_table_->for_each([&](PageId page_id, frame_id_t frame_id) {
+                // 要加一个fd的判断 参考自rucbase的函数
+                if (page_id.fd == fd) {
+                    frames.push_back(frame_id);
+                    in_progress |= pages_[frame_id].io_in_progress_;
+                }
+            });
+            if (!in_progress) {
+                break;
+            }
+            shard.io_cv_.wait(lock);
+        }
+        for (auto frame_id : frames) {
+            auto page = pages_ + frame_id;
+            // 3.1 占用该帧，从replacer中移除
+            page->pin_count_ = -1;
+            shard.replacer_->pin(frame_id);
             // 3.2 从页表中删除目标页
-            iter = page_table_.erase(iter);
+            shard.page_table_->erase(page->get_page_id());
             // 3.3 重置元数据 最佳方法是什么？
+            page->set_page_id({.fd = -1, .page_no = INVALID_PAGE_ID});
             page->is_dirty_ = false;
-            page->pin_count_ = 0;
+            page->prefetched_ = false;
             page->reset_memory();
             // 3.4加入free_list_
-            free_list_.push_back(iter->second);
-        } else {
-            iter++;
+            shard.free_list_.push_back(frame_id);
+        }
+    }
+}
+
+/**
+ * @description: 后台写线程的一轮清理：按replacer的淘汰顺序检查接下来会被淘汰的帧，把未被固定的脏页写回磁盘。
+ *              为遵守WAL，页面LSN大于已持久化日志LSN的脏页留到日志落盘后的下一轮再写。
+ *              要写回的帧先被占用并标记为I/O进行中，写回时不持有分区的latch_
+ * @return {size_t} 本轮写回的页面个数
+ * @param {BgWriterConfig&} config 后台写线程的参数
+ * @param {double*} dirty_ratio 不为nullptr时存放检查的帧中脏页的比例
+ */
+size_t BufferPoolManager::clean_victim_pages(const BgWriterConfig& config, double* dirty_ratio) {
+    // 检查的帧数和写回的配额平均分给各个分区
+    size_t scan_depth = (config.scan_depth + num_shards_ - 1) / num_shards_;
+    size_t max_pages = (config.max_pages + num_shards_ - 1) / num_shards_;
+    std::vector<frame_id_t> candidates;
+    std::vector<frame_id_t> frames;
+    size_t num_candidates = 0;
+    size_t num_dirty = 0;
+    size_t num_written = 0;
+    for (size_t i = 0; i < num_shards_; i++) {
+        auto& shard = shards_[i];
+        std::unique_lock lock{shard.latch_};
+        shard.replacer_->victim_candidates(&candidates, scan_depth);
+        if (candidates.empty()) {
+            continue;
+        }
+        lsn_t persist_lsn = log_manager_ != nullptr ? log_manager_->get_persist_lsn_() : INVALID_LSN;
+        frames.clear();
+        size_t shard_dirty = 0;
+        for (auto frame_id : candidates) {
+            auto page = pages_ + frame_id;
+            if (!page->is_dirty_ || page->pin_count_ != 0) {
+                continue;
+            }
+            shard_dirty++;
+            if (log_manager_ != nullptr && page->get_page_lsn() > persist_lsn) {
+                continue;
+            }
+            if (frames.size() < max_pages) {
+                frames.push_back(frame_id);
+            }
+        }
+        num_candidates += candidates.size();
+        num_dirty += shard_dirty;
+        if (shard_dirty < config.min_dirty_ratio * candidates.size()) {
+            continue;
+        }
+        // 占用要写回的帧并标记为I/O进行中，释放latch_后写回，这期间请求这些页面的线程在帧上等待，
+        // 其他线程不受影响。帧留在replacer中原来的位置，写回后按淘汰顺序被替换
+        size_t num_claimed = 0;
+        for (auto frame_id : frames) {
+            auto page = pages_ + frame_id;
+            if (try_claim(page)) {
+                page->io_in_progress_ = true;
+                frames[num_claimed++] = frame_id;
+            }
+        }
+        frames.resize(num_claimed);
+        if (frames.empty()) {
+            continue;
+        }
+        lock.unlock();
+        auto release_frames = [&]() {
+            lock.lock();
+            for (auto frame_id : frames) {
+                auto page = pages_ + frame_id;
+                page->io_in_progress_ = false;
+                page->pin_count_.store(0, std::memory_order_release);
+            }
+            lock.unlock();
+            shard.io_cv_.notify_all();
+        };
+        try {
+            write_back_frames(frames);
+        } catch (...) {
+            release_frames();
+            throw;
+        }
+        release_frames();
+        num_written += frames.size();
+    }
+    if (dirty_ratio != nullptr) {
+        *dirty_ratio = num_candidates == 0 ? 0 : static_cast<double>(num_dirty) / num_candidates;
+    }
+    num_bg_written_ += num_written;
+    return num_written;
+}
+
+/**
+ * @description: 启动后台写线程，每隔config.interval进行一轮clean_victim_pages
+ * @param {BgWriterConfig&} config 后台写线程的参数
+ */
+void BufferPoolManager::start_bg_writer(const BgWriterConfig& config) {
+    stop_bg_writer();
+    bg_writer_stop_ = false;
+    bg_writer_ = std::thread([this, config]() {
+        std::unique_lock lock{bg_writer_latch_};
+        while (!bg_writer_stop_) {
+            lock.unlock();
+            double dirty_ratio = 0;
+            size_t num_written = 0;
+            try {
+                num_written = clean_victim_pages(config, &dirty_ratio);
+            } catch (const std::exception& e) {
+                // 写回失败的帧已被释放并恢复脏页标记，等待一个间隔后重试
+                LOG_WARN("background writer failed: %s", e.what());
+            }
+            lock.lock();
+            // 脏页比例超过上限时不等待，立即开始下一轮
+            if (num_written > 0 && dirty_ratio > config.max_dirty_ratio) {
+                continue;
+            }
+            bg_writer_cv_.wait_for(lock, config.interval, [this]() { return bg_writer_stop_; });
+        }
+    });
+}
+
+/**
+ * @description: 停止后台写线程并等待其退出
+ */
+void BufferPoolManager::stop_bg_writer() {
+    if (!bg_writer_.joinable()) {
+        return;
+    }
+    {
+        std::scoped_lock lock{bg_writer_latch_};
+        bg_writer_stop_ = true;
+    }
+    bg_writer_cv_.notify_all();
+    bg_writer_.join();
+}
+
+/**
+ * @description: 提交一个预读请求，由预读线程异步执行，预读线程在首次提交时启动
+ * @param {ReadaheadRequest&} request 预读请求
+ */
+void BufferPoolManager::submit_readahead(const ReadaheadRequest& request) {
+    if (request.n <= 0) {
+        return;
+    }
+    std::scoped_lock lock{readahead_latch_};
+    if (readahead_stop_) {
+        return;
+    }
+    if (!readahead_thread_.joinable()) {
+        readahead_thread_ = std::thread([this]() {
+            std::unique_lock lock{readahead_latch_};
+            while (true) {
+                readahead_cv_.wait(lock, [this]() { return readahead_stop_ || !readahead_queue_.empty(); });
+                if (readahead_stop_) {
+                    break;
+                }
+                ReadaheadRequest request = readahead_queue_.front();
+                readahead_queue_.pop_front();
+                readahead_running_ = request.stream;
+                readahead_running_fd_ = request.fd;
+                lock.unlock();
+                try {
+                    fetch_range(request.fd, request.start_page_no, request.n, request.strategy);
+                } catch (const std::exception& e) {
+                    // 预读只是优化，读入或写回脏页失败时放弃这个窗口，之后访问这些页面的查询会自己读取并报告错误
+                    LOG_WARN("readahead of fd %d failed: %s", request.fd, e.what());
+                }
+                lock.lock();
+                readahead_running_ = nullptr;
+                readahead_running_fd_ = -1;
+                readahead_done_cv_.notify_all();
+            }
+        });
+    }
+    readahead_queue_.push_back(request);
+    readahead_cv_.notify_one();
+}
+
+/**
+ * @description: 取消一个流还未执行的预读请求，并等待它正在执行的请求结束，之后流和它的访问策略可以被释放
+ * @param {ReadaheadStream*} stream 预读流
+ */
+void BufferPoolManager::cancel_readahead(ReadaheadStream* stream) {
+    std::unique_lock lock{readahead_latch_};
+    readahead_queue_.erase(std::remove_if(readahead_queue_.begin(), readahead_queue_.end(),
+                                          [stream](const ReadaheadRequest& request) { return request.stream == stream; }),
+                           readahead_queue_.end());
+    readahead_done_cv_.wait(lock, [this, stream]() { return readahead_running_ != stream; });
+}
+
+/**
+ * @description: 取消一个文件的所有预读请求，并等待正在读取该文件的请求结束，在关闭文件之前调用
+ * @param {int} fd 文件句柄
+ */
+void BufferPoolManager::cancel_readahead(int fd) {
+    std::unique_lock lock{readahead_latch_};
+    readahead_queue_.erase(std::remove_if(readahead_queue_.begin(), readahead_queue_.end(),
+                                          [fd](const ReadaheadRequest& request) { return request.fd == fd; }),
+                           readahead_queue_.end());
+    readahead_done_cv_.wait(lock, [this, fd]() { return readahead_running_fd_ != fd; });
+}
+
+/**
+ * @description: 停止预读线程并等待其退出，未执行的请求被丢弃
+ */
+void BufferPoolManager::stop_readahead() {
+    {
+        std::scoped_lock lock{readahead_latch_};
+        readahead_stop_ = true;
+        readahead_queue_.clear();
+    }
+    readahead_cv_.notify_all();
+    if (readahead_thread_.joinable()) {
+        readahead_thread_.join();
+    }
+}
+
+namespace {
+constexpr char HOT_PAGE_FILE_MAGIC[8] = {'R', 'M', 'D', 'B', 'H', 'O', 'T', '1'};
+}  // namespace
+
+/**
+ * @description: 把缓冲池中的页面按最近访问的顺序保存到文件中，用于重启后预热缓冲池。
+ *              各分区按replacer的淘汰顺序从后向前依次轮流取页面，越靠前的页面越热；页面用文件名而不是文件句柄标识。
+ *              文件格式：8字节的魔数，文件名个数及各文件名（长度+内容），页面个数及各页面（文件名编号+页面号）。
+ *              先写临时文件再重命名，保存过程中崩溃不会留下不完整的文件
+ * @return {size_t} 保存的页面个数
+ * @param {string&} path 保存的文件路径
+ */
+size_t BufferPoolManager::save_hot_pages(const std::string& path) {
+    // 1. 每个分区中从热到冷的页面
+    std::vector<std::vector<PageId>> shard_pages(num_shards_);
+    std::vector<frame_id_t> frames;
+    size_t num_pages = 0;
+    for (size_t i = 0; i < num_shards_; i++) {
+        auto& shard = shards_[i];
+        std::scoped_lock lock{shard.latch_};
+        shard.replacer_->victim_candidates(&frames, shard.replacer_->Size());
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            shard_pages[i].push_back(pages_[*it].get_page_id());
+        }
+        num_pages += shard_pages[i].size();
+    }
+    // 2. 各分区轮流取页面，文件名按首次出现的顺序编号；已关闭的文件的页面跳过
+    std::unordered_map<int, int32_t> fd2index;
+    std::vector<std::string> file_names;
+    std::vector<std::pair<int32_t, page_id_t>> entries;
+    entries.reserve(num_pages);
+    for (size_t rank = 0; entries.size() < num_pages; rank++) {
+        for (auto& pages : shard_pages) {
+            if (rank >= pages.size()) {
+                continue;
+            }
+            PageId page_id = pages[rank];
+            auto it = fd2index.find(page_id.fd);
+            if (it == fd2index.end()) {
+                int32_t index = -1;
+                try {
+                    file_names.push_back(disk_manager_->get_file_name(page_id.fd));
+                    index = static_cast<int32_t>(file_names.size()) - 1;
+                } catch (FileNotOpenError&) {
+                }
+                it = fd2index.emplace(page_id.fd, index).first;
+            }
+            entries.emplace_back(it->second, page_id.page_no);
+        }
+    }
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](auto& entry) { return entry.first < 0; }),
+                  entries.end());
+
+    // 3. 写临时文件再重命名
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!ofs) {
+            return 0;
+        }
+        auto write_u32 = [&ofs](uint32_t value) { ofs.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        ofs.write(HOT_PAGE_FILE_MAGIC, sizeof(HOT_PAGE_FILE_MAGIC));
+        write_u32(file_names.size());
+        for (auto& file_name : file_names) {
+            write_u32(file_name.size());
+            ofs.write(file_name.data(), file_name.size());
         }
+        write_u32(entries.size());
+        for (auto& entry : entries) {
+            write_u32(entry.first);
+            write_u32(entry.second);
+        }
+        if (!ofs.flush()) {
+            return 0;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        return 0;
+    }
+    return entries.size();
+}
+
+/**
+ * @description: 按save_hot_pages保存的列表预热缓冲池。取最热的不超过pool_size_个页面，按(文件, 页面号)排序，
+ *              间隔不超过WARM_RESTART_MAX_GAP的页面在帧数允许时合并为一次顺序读，交给预读线程异步读入，函数立即返回。
+ *              文件不存在或格式不对时不做任何事；列表中未打开的文件和超出文件末尾的页面被跳过
+ * @return {size_t} 提交读取的页面个数，包括合并时一并读入的中间页面
+ * @param {string&} path 列表文件路径
+ */
+size_t BufferPoolManager::load_hot_pages(const std::string& path) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) {
+        return 0;
+    }
+    auto read_u32 = [&ifs]() {
+        uint32_t value = 0;
+        ifs.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    };
+    char magic[sizeof(HOT_PAGE_FILE_MAGIC)] = {};
+    ifs.read(magic, sizeof(magic));
+    if (!ifs || memcmp(magic, HOT_PAGE_FILE_MAGIC, sizeof(magic)) != 0) {
+        return 0;
+    }
+    // 1. 文件名换为当前的文件句柄
+    uint32_t num_files = read_u32();
+    std::vector<int> fds;
+    for (uint32_t i = 0; i < num_files && ifs; i++) {
+        std::string file_name(read_u32(), '\0');
+        ifs.read(file_name.data(), file_name.size());
+        fds.push_back(disk_manager_->find_open_fd(file_name));
+    }
+    uint32_t num_entries = read_u32();
+    std::vector<PageId> page_ids;
+    for (uint32_t i = 0; i < num_entries && page_ids.size() < pool_size_; i++) {
+        uint32_t file_index = read_u32();
+        auto page_no = static_cast<page_id_t>(read_u32());
+        if (!ifs) {
+            return 0;
+        }
+        if (file_index >= fds.size() || fds[file_index] < 0 || page_no < 0 ||
+            page_no >= disk_manager_->get_fd2pageno(fds[file_index])) {
+            continue;
+        }
+        page_ids.push_back({.fd = fds[file_index], .page_no = page_no});
+    }
+    // 2. 排序后合并为顺序读。一并读入的中间页面占用的帧数不超过缓冲池中剩余的帧数，不会挤掉列表中的页面
+    std::sort(page_ids.begin(), page_ids.end());
+    size_t gap_budget = pool_size_ - page_ids.size();
+    size_t num_requested = 0;
+    size_t begin = 0;
+    while (begin < page_ids.size()) {
+        size_t end = begin + 1;
+        while (end < page_ids.size() && page_ids[end].fd == page_ids[begin].fd) {
+            size_t gap = page_ids[end].page_no - page_ids[end - 1].page_no - 1;
+            if (gap > static_cast<size_t>(WARM_RESTART_MAX_GAP) || gap > gap_budget) {
+                break;
+            }
+            gap_budget -= gap;
+            end++;
+        }
+        int n = page_ids[end - 1].page_no - page_ids[begin].page_no + 1;
+        submit_readahead({.fd = page_ids[begin].fd, .start_page_no = page_ids[begin].page_no, .n = n,
+                          .strategy = nullptr, .stream = nullptr});
+        num_requested += n;
+        begin = end;
+    }
+    return num_requested;
+}
+
+/**
+ * @description: 启动定期保存热页面列表的线程，每隔interval保存一次
+ * @param {string&} path 保存的文件路径
+ * @param {seconds} interval 两次保存之间的间隔
+ */
+void BufferPoolManager::start_hot_page_saver(const std::string& path, std::chrono::seconds interval) {
+    stop_hot_page_saver();
+    hot_page_saver_stop_ = false;
+    hot_page_saver_ = std::thread([this, path, interval]() {
+        std::unique_lock lock{hot_page_saver_latch_};
+        while (!hot_page_saver_cv_.wait_for(lock, interval, [this]() { return hot_page_saver_stop_; })) {
+            lock.unlock();
+            save_hot_pages(path);
+            lock.lock();
+        }
+    });
+}
+
+/**
+ * @description: 停止定期保存热页面列表的线程并等待其退出
+ */
+void BufferPoolManager::stop_hot_page_saver() {
+    if (!hot_page_saver_.joinable()) {
+        return;
+    }
+    {
+        std::scoped_lock lock{hot_page_saver_latch_};
+        hot_page_saver_stop_ = true;
     }
+    hot_page_saver_cv_.notify_all();
+    hot_page_saver_.join();
 }
@@ -12,54 +12,228 @@ See the Mulan PSL v2 for more details. */
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <list>
+#include <memory>
+#include <new>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "disk_manager.h"
 #include "errors.h"
+#include "frame_arena.h"
 #include "page.h"
+#include "page_table.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
 #include "replacer/lru_replacer.h"
 #include "replacer/replacer.h"
+#include "replacer/two_q_replacer.h"
 #include "recovery/log_manager.h"
 class LogManager;
+
+/**
+ * @description: 后台写线程的参数。每一轮检查replacer中最先被淘汰的scan_depth个帧，把其中未被固定的脏页写回，
+ * 使前台线程淘汰页面时尽量拿到干净的帧
+ */
+struct BgWriterConfig {
+    std::chrono::milliseconds interval{BG_WRITER_INTERVAL_MS};  // 两轮之间的间隔
+    size_t scan_depth = BG_WRITER_SCAN_DEPTH;                   // 每轮检查的帧数
+    size_t max_pages = BG_WRITER_MAX_PAGES;                     // 每轮最多写回的页面个数
+    double min_dirty_ratio = 0.05;  // 检查的帧中脏页比例低于该值时本轮不写，避免零散的小写入
+    double max_dirty_ratio = 0.5;   // 脏页比例高于该值时不等待间隔，立即开始下一轮
+};
+
+/**
+ * @description: 缓冲池的一个分区。页面按PageId的哈希值分配到各个分区，每个分区管理一段连续的帧，
+ * 有自己的页表、空闲帧链表、replacer和latch，访问不同分区的线程互不阻塞。
+ * 页表的修改、帧的分配和回收在latch下进行，磁盘读写不持有latch，见reserve_frame；命中缓冲池时不加latch，见fetch_page
+ */
+struct alignas(64) BufferPoolShard {
+    std::unique_ptr<PageTable> page_table_;  // 帧号和页面号的映射哈希表，用于根据页面的PageId定位该页面的帧编号
+    std::vector<frame_id_t> free_list_;  // 用过之后被释放的空闲帧，按栈的方式使用，优先复用最近释放的帧
+    frame_id_t next_unused_frame_;       // 帧[next_unused_frame_, end_frame_)从未被使用过，其Page对象还没有构造
+    frame_id_t end_frame_;               // 分区管理的帧之后的第一个帧
+    std::unique_ptr<Replacer> replacer_;  // 分区的置换策略，包含分区中所有已装入页面的帧，被固定的帧在替换时跳过
+    std::mutex latch_;                    // 用于分区内共享数据结构的并发控制
+    std::condition_variable io_cv_;       // 与latch_配合，帧的I/O完成时唤醒等待该帧的线程
+    std::mutex io_latch_;                 // 保护async_io_，不持有latch_时使用
+    std::unique_ptr<AsyncIo> async_io_;   // 批量预取使用的异步I/O队列，首次预取时创建
+};
+
+/**
+ * @description: 缓冲池访问策略。大范围的顺序扫描和批量导入只在一个私有的环形帧集合中循环使用帧，
+ * 而不是从整个缓冲池淘汰页面，避免冲掉其他查询反复访问的页面。每个分区有一个环，环中的帧仍登记在页表和replacer中；
+ * 其他查询命中环中的页面后该帧不再被环复用，按普通页面管理。一个策略对象只能由一个扫描使用，
+ * 该扫描的预读线程可以同时使用它
+ */
+class BufferAccessStrategy {
+    friend class BufferPoolManager;
+
+   public:
+    /**
+     * @param {size_t} num_shards 缓冲池的分区个数
+     * @param {size_t} ring_pages 每个分区中循环使用的帧数
+     */
+    BufferAccessStrategy(size_t num_shards, size_t ring_pages) : rings_(num_shards) {
+        for (auto& ring : rings_) {
+            ring.slots.assign(std::max<size_t>(1, ring_pages), RingSlot{INVALID_FRAME_ID, {.fd = -1}});
+        }
+    }
+
+    size_t get_num_reused() const { return num_reused_; }
+
+    /** @return 所有分区的环中的帧数之和 */
+    size_t capacity() const { return rings_.size() * rings_[0].slots.size(); }
+
+   private:
+    struct RingSlot {
+        frame_id_t frame_id;  // 环中的帧，INVALID_FRAME_ID表示该位置还没有帧
+        PageId page_id;       // 通过该策略装入帧的页面，帧中已是其他页面时不能复用
+    };
+    struct Ring {
+        std::vector<RingSlot> slots;
+        size_t next = 0;  // 下一次复用的位置
+    };
+
+    std::vector<Ring> rings_;              // 每个分区一个环，在分区的latch下访问
+    std::atomic<size_t> num_reused_{0};    // 复用环中的帧的次数
+};
+
+class ReadaheadStream;
+
+/**
+ * @description: 一个预读请求，由缓冲池的预读线程把[start_page_no, start_page_no + n)读入缓冲池
+ */
+struct ReadaheadRequest {
+    int fd;
+    page_id_t start_page_no;
+    int n;
+    BufferAccessStrategy* strategy;  // 预读使用的访问策略，可以为nullptr
+    ReadaheadStream* stream;         // 发起请求的流，流析构时取消它的请求
+};
+
 class BufferPoolManager {
    private:
     size_t pool_size_;  // buffer_pool中可容纳页面的个数，即帧的个数
-    Page* pages_;  // buffer_pool中的Page对象数组，在构造空间中申请内存空间，在析构函数中释放，大小为BUFFER_POOL_SIZE
-    std::unordered_map<PageId, frame_id_t, PageIdHash>
-        page_table_;  // 帧号和页面号的映射哈希表，用于根据页面的PageId定位该页面的帧编号
-    std::list<frame_id_t> free_list_;  // 空闲帧编号的链表
+    std::unique_ptr<FrameArena> frame_arena_;  // 帧数据和帧元数据所在的内存，物理内存在首次访问时才分配
+    Page* pages_;  // buffer_pool中的Page对象数组，位于frame_arena_的元数据区，帧第一次被使用时才构造其Page对象
+    char* frames_;  // 所有帧的页面数据，位于frame_arena_的帧数据区，第i个帧位于frames_+i*PAGE_SIZE
+    int num_numa_nodes_;  // 帧内存分布的NUMA节点个数，没有设置NUMA策略时为0
+    size_t num_shards_;  // 分区个数
+    std::unique_ptr<BufferPoolShard[]> shards_;  // 第i个分区管理帧[i*pool_size_/num_shards_, (i+1)*pool_size_/num_shards_)
     DiskManager* disk_manager_;
     LogManager* log_manager_;
-    Replacer* replacer_;  // buffer_pool的置换策略，当前赛题中为LRU置换策略
-    std::mutex latch_;    // 用于共享数据结构的并发控制
+
+    // 后台写线程
+    std::thread bg_writer_;
+    std::mutex bg_writer_latch_;         // 与bg_writer_cv_配合，用于唤醒后台写线程退出
+    std::condition_variable bg_writer_cv_;
+    bool bg_writer_stop_ = false;
+    std::atomic<size_t> num_bg_written_{0};      // 后台写线程写回的页面个数
+    std::atomic<size_t> num_dirty_evictions_{0};  // 前台淘汰页面时遇到脏页、需要同步写回的次数
+    std::atomic<size_t> num_fetch_misses_{0};     // fetch_page未命中缓冲池、需要从磁盘读取的次数
+    std::atomic<size_t> num_prefetched_{0};       // 预取读入的页面个数
+    std::atomic<size_t> num_prefetch_hits_{0};    // 预取读入后被fetch_page访问到的页面个数
+    std::atomic<size_t> num_prefetch_wasted_{0};  // 预取读入后没有被访问就被替换的页面个数
+
+    // 预读线程，首次提交预读请求时启动
+    std::thread readahead_thread_;
+    std::mutex readahead_latch_;                     // 保护以下成员
+    std::condition_variable readahead_cv_;           // 有新的请求或需要退出
+    std::condition_variable readahead_done_cv_;      // 一个请求执行完
+    std::deque<ReadaheadRequest> readahead_queue_;   // 等待执行的请求
+    ReadaheadStream* readahead_running_ = nullptr;   // 正在执行的请求所属的流
+    int readahead_running_fd_ = -1;                  // 正在执行的请求读取的文件
+    bool readahead_stop_ = false;
+
+    // 定期保存热页面列表的线程
+    std::thread hot_page_saver_;
+    std::mutex hot_page_saver_latch_;  // 与hot_page_saver_cv_配合，用于唤醒线程退出
+    std::condition_variable hot_page_saver_cv_;
+    bool hot_page_saver_stop_ = false;
 
    public:
-    BufferPoolManager(size_t pool_size, DiskManager* disk_manager, LogManager* log_manager)
+    /**
+     * @param {size_t} pool_size 帧的个数
+     * @param {size_t} num_shards 分区个数，每个分区至少有MIN_SHARD_FRAMES个帧，帧数不足时自动减少分区个数
+     * @param {FrameArenaConfig&} arena_config 帧内存使用的大页和NUMA策略
+     */
+    BufferPoolManager(size_t pool_size, DiskManager* disk_manager, LogManager* log_manager = nullptr,
+                      size_t num_shards = 1, const FrameArenaConfig& arena_config = FrameArenaConfig())
         : pool_size_(pool_size), disk_manager_(disk_manager), log_manager_(log_manager) {
-        // 为buffer pool分配一块连续的内存空间
-        pages_ = new Page[pool_size_];
-        // 可以被Replacer改变
-        if (REPLACER_TYPE.compare("LRU"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else if (REPLACER_TYPE.compare("CLOCK"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else {
-            replacer_ = new LRUReplacer(pool_size_);
-        }
-        // 初始化时，所有的page都在free_list_中
-        for (size_t i = 0; i < pool_size_; ++i) {
-            free_list_.emplace_back(static_cast<frame_id_t>(i));  // static_cast转换数据类型
+        // 帧数据和Page对象分别放在两块映射中，只保留地址空间，不预先占用内存和swap，
+        // 页面在首次访问时由内核分配并清零，启动时间和常驻内存随实际用到的帧数增长，而不是随缓冲池的大小增长
+        frame_arena_ = std::make_unique<FrameArena>(pool_size_, pool_size_ * sizeof(Page), arena_config);
+        frames_ = frame_arena_->frames();
+        pages_ = static_cast<Page*>(frame_arena_->metadata());
+        num_shards_ = std::max<size_t>(1, std::min(num_shards, pool_size_ / MIN_SHARD_FRAMES));
+        shards_ = std::make_unique<BufferPoolShard[]>(num_shards_);
+        std::vector<std::pair<size_t, size_t>> partitions;
+        for (size_t i = 0; i < num_shards_; ++i) {
+            auto& shard = shards_[i];
+            size_t begin = i * pool_size_ / num_shards_;
+            size_t end = (i + 1) * pool_size_ / num_shards_;
+            shard.page_table_ = std::make_unique<PageTable>(end - begin);
+            shard.replacer_ = create_replacer(REPLACER_TYPE, end - begin, static_cast<frame_id_t>(begin));
+            // 初始化时，所有的帧都未被使用过，按帧号顺序分配
+            shard.next_unused_frame_ = static_cast<frame_id_t>(begin);
+            shard.end_frame_ = static_cast<frame_id_t>(end);
+            partitions.emplace_back(begin, end);
         }
+        num_numa_nodes_ = frame_arena_->apply_numa_policy(arena_config.numa_policy, partitions);
     }
 
     ~BufferPoolManager() {
-        delete[] pages_;
-        delete replacer_;
+        stop_hot_page_saver();
+        stop_bg_writer();
+        stop_readahead();
+        for (size_t i = 0; i < num_shards_; ++i) {
+            frame_id_t begin = static_cast<frame_id_t>(i * pool_size_ / num_shards_);
+            for (frame_id_t frame_id = begin; frame_id < shards_[i].next_unused_frame_; ++frame_id) {
+                pages_[frame_id].~Page();
+            }
+        }
+    }
+
+    size_t get_num_shards() const { return num_shards_; }
+
+    HugePageType get_huge_page_type() const { return frame_arena_->huge_page_type(); }
+
+    int get_num_numa_nodes() const { return num_numa_nodes_; }
+
+    /**
+     * @description: 按名称创建置换策略
+     * @param {string&} replacer_type LRU、LRU-K、2Q或CLOCK
+     * @param {size_t} num_pages replacer最多需要存储的page数量
+     * @param {frame_id_t} first_frame_id replacer管理的第一个帧，分区的帧号是连续的
+     */
+    static std::unique_ptr<Replacer> create_replacer(const std::string& replacer_type, size_t num_pages,
+                                                     frame_id_t first_frame_id = 0) {
+        if (replacer_type == "LRU") {
+            return std::make_unique<LRUReplacer>(num_pages);
+        }
+        if (replacer_type == "LRU-K") {
+            return std::make_unique<LRUKReplacer>(num_pages, LRU_K);
+        }
+        if (replacer_type == "2Q") {
+            return std::make_unique<TwoQReplacer>(num_pages, TWO_Q_A1_RATIO);
+        }
+        if (replacer_type == "CLOCK") {
+            return std::make_unique<ClockReplacer>(num_pages, first_frame_id);
+        }
+        throw InternalError("BufferPoolManager::create_replacer: unknown replacer type " + replacer_type);
     }
 
+    void set_replacer(const std::string& replacer_type);
+
     /**
      * @description: 将目标页面标记为脏页
      * @param {Page*} page 脏页
@@ -67,22 +241,141 @@ class BufferPoolManager {
     static void mark_dirty(Page* page) { page->is_dirty_ = true; }
 
    public:
-    Page* fetch_page(PageId page_id);
+    Page* fetch_page(PageId page_id, BufferAccessStrategy* strategy = nullptr);
 
     bool unpin_page(PageId page_id, bool is_dirty);
 
     bool flush_page(PageId page_id);
 
-    Page* new_page(PageId* page_id);
+    Page* new_page(PageId* page_id, BufferAccessStrategy* strategy = nullptr);
 
     bool delete_page(PageId page_id);
 
+    int prefetch_pages(int fd, const std::vector<page_id_t>& page_nos, BufferAccessStrategy* strategy = nullptr);
+
+    int fetch_range(int fd, page_id_t start_page_no, int n, BufferAccessStrategy* strategy = nullptr);
+
+    /**
+     * @description: 创建一个每个分区循环使用ring_pages个帧的访问策略
+     */
+    std::unique_ptr<BufferAccessStrategy> create_access_strategy(size_t ring_pages) const {
+        return std::make_unique<BufferAccessStrategy>(num_shards_, ring_pages);
+    }
+
+    /**
+     * @description: 为顺序扫描num_pages个页面的表创建访问策略，表较小时返回nullptr，即正常使用缓冲池
+     * @param {bool} repeated 是否会反复扫描（如块嵌套连接的内表），此时只要表能放进缓冲池就不使用环形帧
+     */
+    std::unique_ptr<BufferAccessStrategy> create_scan_strategy(page_id_t num_pages, bool repeated = false) const {
+        size_t max_cached_pages = repeated ? pool_size_ : pool_size_ / SCAN_RING_MIN_FRACTION;
+        if (static_cast<size_t>(num_pages) <= max_cached_pages) {
+            return nullptr;
+        }
+        return create_access_strategy(SCAN_RING_PAGES);
+    }
+
     void flush_all_pages(int fd);
     void flush_all_pages();
     void delete_all_pages(int fd);
 
+    void start_bg_writer(const BgWriterConfig& config);
+
+    void stop_bg_writer();
+
+    size_t clean_victim_pages(const BgWriterConfig& config, double* dirty_ratio = nullptr);
+
+    size_t get_num_bg_written() const { return num_bg_written_; }
+
+    size_t get_num_dirty_evictions() const { return num_dirty_evictions_; }
+
+    size_t get_num_fetch_misses() const { return num_fetch_misses_; }
+
+    size_t get_num_prefetched() const { return num_prefetched_; }
+
+    size_t get_num_prefetch_hits() const { return num_prefetch_hits_; }
+
+    size_t get_num_prefetch_wasted() const { return num_prefetch_wasted_; }
+
+    void submit_readahead(const ReadaheadRequest& request);
+
+    void cancel_readahead(ReadaheadStream* stream);
+
+    void cancel_readahead(int fd);
+
+    void stop_readahead();
+
+    size_t save_hot_pages(const std::string& path);
+
+    size_t load_hot_pages(const std::string& path);
+
+    void start_hot_page_saver(const std::string& path, std::chrono::seconds interval);
+
+    void stop_hot_page_saver();
+
    private:
-    bool find_victim_page(frame_id_t* frame_id);
+    /**
+     * @description: 页面所在的分区。连续的SHARD_RUN_PAGES个页面分到同一个分区，
+     * 使顺序扫描的批量读和刷脏页的合并写不被分区打断
+     */
+    BufferPoolShard& shard_of(PageId page_id) {
+        if (num_shards_ == 1) {
+            return shards_[0];
+        }
+        PageId group = {.fd = page_id.fd, .page_no = page_id.page_no / SHARD_RUN_PAGES};
+        uint64_t hash = static_cast<uint64_t>(group.Get()) * 0x9E3779B97F4A7C15ull;
+        return shards_[(hash >> 32) % num_shards_];
+    }
+
+    /**
+     * @description: 不加锁地固定一个帧，帧空闲或正在被替换（pin_count_为-1）时失败
+     */
+    static bool try_pin(Page* page) {
+        int pin_count = page->pin_count_.load(std::memory_order_relaxed);
+        while (pin_count >= 0) {
+            if (page->pin_count_.compare_exchange_weak(pin_count, pin_count + 1, std::memory_order_acquire)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @description: 占用一个未被固定的帧以便替换其中的页面，成功后pin_count_为-1，其他线程无法再固定该帧
+     */
+    static bool try_claim(Page* page) {
+        int pin_count = 0;
+        return page->pin_count_.compare_exchange_strong(pin_count, -1, std::memory_order_acquire);
+    }
+
+    /**
+     * @description: 命中缓冲池时记录对页面的访问。通过访问策略的访问不算作被访问过，避免扫描页面得到第二次机会
+     */
+    void note_hit(Page* page, BufferAccessStrategy* strategy) {
+        if (strategy == nullptr) {
+            page->referenced_.store(true, std::memory_order_relaxed);
+        }
+        if (page->prefetched_.load(std::memory_order_relaxed) &&
+            page->prefetched_.exchange(false, std::memory_order_relaxed)) {
+            num_prefetch_hits_++;
+        }
+    }
+
+    bool find_victim_page(BufferPoolShard& shard, frame_id_t* frame_id);
+
+    bool find_victim_page(BufferPoolShard& shard, frame_id_t* frame_id, BufferAccessStrategy* strategy,
+                          PageId new_page_id);
+
+    void update_page(BufferPoolShard& shard, Page* page, PageId new_page_id, frame_id_t new_frame_id);
+
+    bool reserve_frame(BufferPoolShard& shard, std::unique_lock<std::mutex>& lock, PageId page_id,
+                       BufferAccessStrategy* strategy, frame_id_t* frame_id);
+
+    void finish_io(BufferPoolShard& shard, frame_id_t frame_id, int pin_count);
+
+    void abort_io(BufferPoolShard& shard, frame_id_t frame_id, PageId page_id);
+
+    int prefetch_shard_pages(BufferPoolShard& shard, int fd, const std::vector<page_id_t>& page_nos,
+                             BufferAccessStrategy* strategy);
 
-    void update_page(Page* page, PageId new_page_id, frame_id_t new_frame_id);
+    void write_back_frames(std::vector<frame_id_t>& frames);
 };
\ No newline at end of file
@@ -1,14 +1,19 @@
 #include "buffer_pool_manager.h"
+#include "readahead.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <ctime>
+#include <fstream>
+#include <random>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "page_codec.h"
 
 constexpr int MAX_FILES = 32;
 constexpr int MAX_PAGES = 128;
@@ -429,3 +434,1133 @@ TEST_F(BufferPoolManagerTest, ConcurrencyTest) {
     disk_manager_->close_file(fd);
 }
 
+
+/**
+ * @brief 测试批量预取：同步和io_uring两种后端下，预取的页面内容正确且可以被正常淘汰
+ * @note 生成测试文件prefetch_test
+ */
+TEST_F(BufferPoolManagerTest, PrefetchTest) {
+    const int num_pages = 200;
+    const size_t buffer_pool_size = 64;
+    const std::string filename = "prefetch_test";
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    char buf[PAGE_SIZE];
+    for (int i = 0; i < num_pages; i++) {
+        memset(buf, 0, PAGE_SIZE);
+        memcpy(buf, &i, sizeof(int));
+        disk_manager_->write_page(fd, i, buf, PAGE_SIZE);
+    }
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    for (auto backend : {IoBackendType::SYNC, IoBackendType::URING}) {
+        disk_manager_->set_io_backend(backend);
+        auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager_.get());
+
+        // 缓冲池只有64个帧，预取100个页面时只能读入前64个
+        std::vector<page_id_t> page_nos;
+        for (int i = 0; i < 100; i++) page_nos.push_back(i);
+        EXPECT_EQ(buffer_pool_size, bpm->prefetch_pages(fd, page_nos));
+        // 已经在缓冲池中的页面不会被重复读取
+        EXPECT_EQ(0, bpm->prefetch_pages(fd, {0, 1, 2}));
+
+        // 预取的页面没有被固定，后续预取可以淘汰它们
+        page_nos.clear();
+        for (int i = 100; i < num_pages; i++) page_nos.push_back(i);
+        EXPECT_EQ(buffer_pool_size, bpm->prefetch_pages(fd, page_nos));
+        for (int i = 100; i < 100 + static_cast<int>(buffer_pool_size); i++) {
+            Page *page = bpm->fetch_page(PageId{fd, i});
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(i, *reinterpret_cast<int *>(page->get_data()));
+            EXPECT_EQ(true, bpm->unpin_page(PageId{fd, i}, false));
+        }
+
+        // 文件末尾之后的页面读到的是全0
+        EXPECT_EQ(1, bpm->prefetch_pages(fd, {num_pages + 10}));
+        Page *page = bpm->fetch_page(PageId{fd, num_pages + 10});
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0, *reinterpret_cast<int *>(page->get_data()));
+        bpm->unpin_page(PageId{fd, num_pages + 10}, false);
+    }
+
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试fetch_range：部分页面已在缓冲池中时，其余页面被分段读入且内容正确
+ * @note 生成测试文件fetch_range_test
+ */
+TEST_F(BufferPoolManagerTest, FetchRangeTest) {
+    const int num_pages = 300;
+    const std::string filename = "fetch_range_test";
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    char buf[PAGE_SIZE];
+    for (int i = 0; i < num_pages; i++) {
+        memset(buf, 0, PAGE_SIZE);
+        memcpy(buf, &i, sizeof(int));
+        memcpy(buf + PAGE_SIZE - sizeof(int), &i, sizeof(int));
+        disk_manager_->write_page(fd, i, buf, PAGE_SIZE);
+    }
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    for (auto backend : {IoBackendType::SYNC, IoBackendType::URING}) {
+        disk_manager_->set_io_backend(backend);
+        auto bpm = std::make_unique<BufferPoolManager>(num_pages, disk_manager_.get());
+        // 先读入几个零散的页面，把区间切成多段
+        for (int page_no : {3, 4, 70, 199}) {
+            ASSERT_NE(nullptr, bpm->fetch_page(PageId{fd, page_no}));
+            bpm->unpin_page(PageId{fd, page_no}, false);
+        }
+        EXPECT_EQ(num_pages - 4, bpm->fetch_range(fd, 0, num_pages));
+        EXPECT_EQ(0, bpm->fetch_range(fd, 0, num_pages));
+        for (int i = 0; i < num_pages; i++) {
+            Page *page = bpm->fetch_page(PageId{fd, i});
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(i, *reinterpret_cast<int *>(page->get_data()));
+            EXPECT_EQ(i, *reinterpret_cast<int *>(page->get_data() + PAGE_SIZE - sizeof(int)));
+            EXPECT_EQ(true, bpm->unpin_page(PageId{fd, i}, false));
+        }
+    }
+
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试空闲页面的复用：释放的页面号被new_page复用，关闭文件后空闲页面表仍然有效
+ * @note 生成测试文件free_page_test
+ */
+TEST_F(BufferPoolManagerTest, FreePageTest) {
+    const std::string filename = "free_page_test";
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, 0);
+    auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager_.get());
+
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < 10; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        ASSERT_NE(nullptr, bpm->new_page(&page_id));
+        EXPECT_EQ(i, page_id.page_no);
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+        page_ids.push_back(page_id);
+    }
+
+    // 释放3号和7号页面，之后的new_page应当复用它们而不是扩展文件
+    for (int page_no : {3, 7}) {
+        EXPECT_EQ(true, bpm->delete_page(page_ids[page_no]));
+        disk_manager_->deallocate_page(fd, page_no);
+    }
+    EXPECT_EQ(2, disk_manager_->get_num_free_pages(fd));
+    std::vector<page_id_t> reused;
+    for (int i = 0; i < 2; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        // 复用的页面内容被清空
+        EXPECT_EQ(0, page->get_data()[0]);
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+        reused.push_back(page_id.page_no);
+    }
+    std::sort(reused.begin(), reused.end());
+    EXPECT_EQ((std::vector<page_id_t>{3, 7}), reused);
+    EXPECT_EQ(10, disk_manager_->get_fd2pageno(fd));
+
+    // 空闲页面表在关闭文件时保存，打开文件时读回
+    disk_manager_->deallocate_page(fd, 5);
+    EXPECT_EQ(true, bpm->delete_page(page_ids[5]));
+    bpm->flush_all_pages(fd);
+    disk_manager_->close_file(fd);
+    EXPECT_TRUE(disk_manager_->is_file(filename + FREE_PAGE_FILE_SUFFIX));
+    fd = disk_manager_->open_file(filename);
+    EXPECT_FALSE(disk_manager_->is_file(filename + FREE_PAGE_FILE_SUFFIX));
+    disk_manager_->set_fd2pageno(fd, 10);
+    EXPECT_EQ(1, disk_manager_->get_num_free_pages(fd));
+    EXPECT_EQ(5, disk_manager_->allocate_page(fd));
+    EXPECT_EQ(10, disk_manager_->allocate_page(fd));
+
+    // 删除文件时一并删除空闲页面表
+    disk_manager_->deallocate_page(fd, 2);
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+    EXPECT_FALSE(disk_manager_->is_file(filename + FREE_PAGE_FILE_SUFFIX));
+}
+
+/**
+ * @brief 测试O_DIRECT模式：帧按PAGE_SIZE对齐，页面经缓冲池写回后能正确读回；不足一页的读写经过中转缓冲区
+ * @note 生成测试文件direct_io_test
+ */
+TEST_F(BufferPoolManagerTest, DirectIOTest) {
+    const std::string filename = "direct_io_test";
+    const int num_pages = 32;
+    disk_manager_->set_direct_io(true);
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, 0);
+    auto bpm = std::make_unique<BufferPoolManager>(8, disk_manager_.get());
+
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(page->get_data()) % PAGE_SIZE);
+        memset(page->get_data(), 'a' + i % 26, PAGE_SIZE);
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    }
+    bpm->flush_all_pages(fd);
+    bpm->delete_all_pages(fd);
+
+    // 单页读取与批量预取读回的内容一致
+    EXPECT_EQ(8, bpm->fetch_range(fd, 0, 8));
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = i};
+        Page *page = bpm->fetch_page(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ('a' + i % 26, page->get_data()[0]);
+        EXPECT_EQ('a' + i % 26, page->get_data()[PAGE_SIZE - 1]);
+        EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+    }
+
+    // 未对齐的部分写入只修改页面开头，页面其余部分保持不变
+    char hdr[16];
+    memset(hdr, 'z', sizeof(hdr));
+    disk_manager_->write_page(fd, 1, hdr, sizeof(hdr));
+    char buf[PAGE_SIZE + 1];
+    disk_manager_->read_page(fd, 1, buf + 1, PAGE_SIZE);
+    EXPECT_EQ('z', buf[1 + sizeof(hdr) - 1]);
+    EXPECT_EQ('b', buf[1 + sizeof(hdr)]);
+
+    disk_manager_->close_file(fd);
+    disk_manager_->set_direct_io(false);
+}
+
+/**
+ * @brief 测试页面压缩：游程编码可以还原任意数据；压缩文件经缓冲池读写、重新打开后内容不变，且占用的空间变小
+ * @note 生成测试文件compressed_test
+ */
+TEST_F(BufferPoolManagerTest, CompressedFileTest) {
+    std::mt19937 rng(0);
+    // 定长记录的页面：每条记录只有开头几个字节有数据，其余为填充的0
+    auto fill_page = [&](char *data, int seed) {
+        memset(data, 0, PAGE_SIZE);
+        for (int offset = 0; offset + 64 <= PAGE_SIZE; offset += 64) {
+            snprintf(data + offset, 16, "rec%d_%d", seed, offset);
+        }
+    };
+
+    char page[PAGE_SIZE], compressed[PAGE_SIZE], restored[PAGE_SIZE];
+    for (int i = 0; i < 3; i++) {
+        if (i == 0) {
+            fill_page(page, 0);
+        } else if (i == 1) {
+            memset(page, 'x', PAGE_SIZE);
+        } else {
+            for (auto &c : page) c = static_cast<char>(rng());  // 随机数据无法压缩
+        }
+        int len = page_compress(page, PAGE_SIZE, compressed, PAGE_SIZE - 1);
+        if (i < 2) {
+            ASSERT_GT(len, 0);
+            EXPECT_LT(len, PAGE_SIZE / 2);
+            EXPECT_EQ(PAGE_SIZE, page_decompress(compressed, len, restored, PAGE_SIZE));
+            EXPECT_EQ(0, memcmp(page, restored, PAGE_SIZE));
+        } else {
+            EXPECT_EQ(-1, len);
+        }
+    }
+
+    const std::string filename = "compressed_test";
+    const int num_pages = 64;
+    disk_manager_->create_file(filename, true);
+    int fd = disk_manager_->open_file(filename);
+    EXPECT_TRUE(disk_manager_->is_compressed(fd));
+    disk_manager_->write_page(fd, 0, "header", 7);  // 第0页按原样存放
+    disk_manager_->set_fd2pageno(fd, 1);
+    auto bpm = std::make_unique<BufferPoolManager>(8, disk_manager_.get());
+
+    std::mt19937 page_rng(1);
+    for (int i = 1; i <= num_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *new_page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, new_page);
+        ASSERT_EQ(i, page_id.page_no);
+        if (i % 8 == 0) {
+            for (int j = 0; j < PAGE_SIZE; j++) new_page->get_data()[j] = static_cast<char>(page_rng());
+        } else {
+            fill_page(new_page->get_data(), i);
+        }
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    }
+    // 旧的存放位置要等页面映射落盘后才被复用：sync_file之前改写页面追加到文件末尾，之后改写复用旧的位置
+    // 映射文件中的映射项也在sync_file中数据落盘之后才写入
+    auto read_map_entry = [&](page_id_t page_no) {
+        uint64_t entry = 0;
+        std::ifstream ifs(filename + COMPRESSED_MAP_SUFFIX, std::ios::binary);
+        ifs.seekg(page_no * sizeof(entry));
+        ifs.read(reinterpret_cast<char *>(&entry), sizeof(entry));
+        return entry;
+    };
+    fill_page(page, 1);
+    int file_size = disk_manager_->get_file_size(filename);
+    uint64_t map_entry = read_map_entry(1);
+    disk_manager_->write_page(fd, 1, page, PAGE_SIZE);
+    EXPECT_GT(disk_manager_->get_file_size(filename), file_size);
+    EXPECT_EQ(map_entry, read_map_entry(1));
+    disk_manager_->sync_file(fd);
+    EXPECT_NE(map_entry, read_map_entry(1));
+    file_size = disk_manager_->get_file_size(filename);
+    disk_manager_->write_page(fd, 1, page, PAGE_SIZE);
+    EXPECT_EQ(file_size, disk_manager_->get_file_size(filename));
+    // 反复改写同一个页面，旧的存放位置被释放后复用，文件不会无限增长
+    for (int round = 0; round < 100; round++) {
+        PageId page_id = {.fd = fd, .page_no = 1};
+        Page *p = bpm->fetch_page(page_id);
+        ASSERT_NE(nullptr, p);
+        fill_page(p->get_data(), round % 2 == 0 ? 1 : 100000 + round);
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+        EXPECT_EQ(true, bpm->flush_page(page_id));
+        disk_manager_->sync_file(fd);
+    }
+    {
+        PageId page_id = {.fd = fd, .page_no = 1};
+        Page *p = bpm->fetch_page(page_id);
+        fill_page(p->get_data(), 1);
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    }
+    bpm->flush_all_pages(fd);
+    bpm->delete_all_pages(fd);
+    disk_manager_->close_file(fd);
+    EXPECT_LT(disk_manager_->get_file_size(filename), num_pages * PAGE_SIZE / 2);
+
+    // 重新打开后，逐页读取和批量预取都能读回原来的内容
+    fd = disk_manager_->open_file(filename);
+    char hdr[7];
+    disk_manager_->read_page(fd, 0, hdr, sizeof(hdr));
+    EXPECT_STREQ("header", hdr);
+    EXPECT_EQ(8, bpm->fetch_range(fd, 1, 8));
+    std::mt19937 expected_rng(1);
+    for (int i = 1; i <= num_pages; i++) {
+        if (i % 8 == 0) {
+            for (int j = 0; j < PAGE_SIZE; j++) page[j] = static_cast<char>(expected_rng());
+        } else {
+            fill_page(page, i);
+        }
+        PageId page_id = {.fd = fd, .page_no = i};
+        Page *p = bpm->fetch_page(page_id);
+        ASSERT_NE(nullptr, p);
+        EXPECT_EQ(0, memcmp(page, p->get_data(), PAGE_SIZE)) << "page " << i;
+        EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+    }
+    disk_manager_->close_file(fd);
+    disk_manager_->destroy_file(filename);
+    EXPECT_FALSE(disk_manager_->is_file(filename + COMPRESSED_MAP_SUFFIX));
+}
+
+/**
+ * @brief 测试flush_all_pages：只写回脏页，写回后脏页标记被清除；多个文件、不连续的页面都能正确写回
+ * @note 生成测试文件flush_test0和flush_test1
+ */
+TEST_F(BufferPoolManagerTest, FlushDirtyPagesTest) {
+    const int num_pages = 100;
+    std::vector<int> fds;
+    auto bpm = std::make_unique<BufferPoolManager>(2 * num_pages, disk_manager_.get());
+    for (int f = 0; f < 2; f++) {
+        std::string filename = "flush_test" + std::to_string(f);
+        disk_manager_->create_file(filename);
+        int fd = disk_manager_->open_file(filename);
+        disk_manager_->set_fd2pageno(fd, 0);
+        fds.push_back(fd);
+        for (int i = 0; i < num_pages; i++) {
+            PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            Page *page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_TRUE(page->is_dirty());  // 新页面还没有写入过磁盘
+            memset(page->get_data(), 'a' + f, PAGE_SIZE);
+            EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+        }
+    }
+    bpm->flush_all_pages();
+
+    // 只改写第0个文件中页面号为3的倍数的页面，另有一个页面被修改但没有标记为脏页
+    for (int i = 0; i < num_pages; i += 3) {
+        PageId page_id = {.fd = fds[0], .page_no = i};
+        Page *page = bpm->fetch_page(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_FALSE(page->is_dirty());
+        memset(page->get_data(), 'x', PAGE_SIZE);
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    }
+    PageId clean_id = {.fd = fds[1], .page_no = 1};
+    Page *clean_page = bpm->fetch_page(clean_id);
+    memset(clean_page->get_data(), 'y', PAGE_SIZE);
+    EXPECT_EQ(true, bpm->unpin_page(clean_id, false));
+    bpm->flush_all_pages(fds[1]);
+    bpm->flush_all_pages(fds[0]);
+
+    char buf[PAGE_SIZE];
+    for (int f = 0; f < 2; f++) {
+        for (int i = 0; i < num_pages; i++) {
+            PageId page_id = {.fd = fds[f], .page_no = i};
+            Page *page = bpm->fetch_page(page_id);
+            EXPECT_FALSE(page->is_dirty());
+            EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+            disk_manager_->read_page(fds[f], i, buf, PAGE_SIZE);
+            char expected = f == 0 ? (i % 3 == 0 ? 'x' : 'a') : 'b';
+            EXPECT_EQ(expected, buf[0]) << "file " << f << " page " << i;
+            EXPECT_EQ(expected, buf[PAGE_SIZE - 1]) << "file " << f << " page " << i;
+        }
+    }
+    for (int fd : fds) {
+        bpm->delete_all_pages(fd);
+        disk_manager_->close_file(fd);
+    }
+}
+
+/**
+ * @brief 测试后台写线程：按淘汰顺序提前写回未固定的脏页，之后前台淘汰页面时不再需要同步写回
+ * @note 生成测试文件bg_writer_test
+ */
+TEST_F(BufferPoolManagerTest, BgWriterTest) {
+    const std::string filename = "bg_writer_test";
+    const int pool_size = 16;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, 0);
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+
+    BgWriterConfig config;
+    config.scan_depth = pool_size;
+    config.max_pages = pool_size / 2;
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < pool_size; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 'a' + i, PAGE_SIZE);
+        page_ids.push_back(page_id);
+    }
+    // 被固定的页面不会被写回
+    EXPECT_EQ(0u, bpm->clean_victim_pages(config));
+    for (auto &page_id : page_ids) {
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    }
+
+    // 每轮最多写回max_pages个页面，且按淘汰顺序先写回最早被淘汰的页面
+    double dirty_ratio = 0;
+    EXPECT_EQ(config.max_pages, bpm->clean_victim_pages(config, &dirty_ratio));
+    EXPECT_DOUBLE_EQ(1.0, dirty_ratio);
+    for (int i = 0; i < pool_size; i++) {
+        Page *page = bpm->fetch_page(page_ids[i]);
+        EXPECT_EQ(i >= static_cast<int>(config.max_pages), page->is_dirty());
+        EXPECT_EQ(true, bpm->unpin_page(page_ids[i], false));
+    }
+
+    // 后台线程把剩余的脏页写回
+    bpm->start_bg_writer(config);
+    for (int retry = 0; retry < 100 && bpm->get_num_bg_written() < static_cast<size_t>(pool_size); retry++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    bpm->stop_bg_writer();
+    EXPECT_EQ(static_cast<size_t>(pool_size), bpm->get_num_bg_written());
+
+    // 淘汰全部页面都不需要同步写回，且写回的内容能读回
+    for (int i = 0; i < pool_size; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        ASSERT_NE(nullptr, bpm->new_page(&page_id));
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    }
+    EXPECT_EQ(0u, bpm->get_num_dirty_evictions());
+    char buf[PAGE_SIZE];
+    for (int i = 0; i < pool_size; i++) {
+        disk_manager_->read_page(fd, page_ids[i].page_no, buf, PAGE_SIZE);
+        EXPECT_EQ('a' + i, buf[PAGE_SIZE - 1]);
+    }
+
+    // 写回失败时后台写线程不退出，脏页标记保留，文件恢复可写后在之后的轮次中写回
+    for (int i = 0; i < pool_size; i++) {
+        Page *page = bpm->fetch_page(page_ids[i]);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 'A' + i, PAGE_SIZE);
+        EXPECT_EQ(true, bpm->unpin_page(page_ids[i], true));
+    }
+    int saved_fd = dup(fd);
+    int null_fd = open("/dev/null", O_RDONLY);
+    ASSERT_EQ(fd, dup2(null_fd, fd));
+    size_t bg_written = bpm->get_num_bg_written();
+    config.interval = std::chrono::milliseconds(10);
+    bpm->start_bg_writer(config);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(bg_written, bpm->get_num_bg_written());
+    ASSERT_EQ(fd, dup2(saved_fd, fd));
+    close(null_fd);
+    close(saved_fd);
+    for (int retry = 0; retry < 100 && bpm->get_num_bg_written() < bg_written + pool_size; retry++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    bpm->stop_bg_writer();
+    for (int i = 0; i < pool_size; i++) {
+        disk_manager_->read_page(fd, page_ids[i].page_no, buf, PAGE_SIZE);
+        EXPECT_EQ('A' + i, buf[PAGE_SIZE - 1]);
+    }
+    bpm->flush_all_pages(fd);
+    bpm->delete_all_pages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试后台写回与页面修改并发：写回某个页面的同时其他线程修改并取消固定该页面，脏页标记不能被写回清除。
+ * 每轮修改后刷脏页，磁盘上必须是本轮修改后的内容
+ * @note 生成测试文件bg_writer_race_test
+ */
+TEST_F(BufferPoolManagerTest, BgWriterRaceTest) {
+    const std::string filename = "bg_writer_race_test";
+    const int num_pages = 32;
+    const int num_threads = 4;
+    const int num_rounds = 500;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, 0);
+    auto bpm = std::make_unique<BufferPoolManager>(num_pages * 2, disk_manager_.get());
+
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 0, PAGE_SIZE);
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+        page_ids.push_back(page_id);
+    }
+
+    // 后台不断写回；每个线程反复修改自己的一组页面，每轮把页面中的计数加一，刷脏页后检查磁盘上的计数。
+    // 脏页标记丢失的页面不会被刷脏页写回，磁盘上停留在旧的计数
+    BgWriterConfig config;
+    config.scan_depth = num_pages * 2;
+    config.max_pages = num_pages;
+    config.min_dirty_ratio = 0;
+    std::atomic<bool> stop{false};
+    std::thread cleaner([&]() {
+        while (!stop) {
+            bpm->clean_victim_pages(config);
+        }
+    });
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            char buf[PAGE_SIZE];
+            for (int round = 1; round <= num_rounds; round++) {
+                for (int i = tid; i < num_pages; i += num_threads) {
+                    Page *page = bpm->fetch_page(page_ids[i]);
+                    if (page == nullptr) {
+                        errors++;
+                        return;
+                    }
+                    for (int j = 0; j < PAGE_SIZE / static_cast<int>(sizeof(int)); j++) {
+                        reinterpret_cast<int *>(page->get_data())[j] = round;
+                    }
+                    bpm->unpin_page(page_ids[i], true);
+                }
+                bpm->flush_all_pages(fd);
+                for (int i = tid; i < num_pages; i += num_threads) {
+                    disk_manager_->read_page(fd, page_ids[i].page_no, buf, PAGE_SIZE);
+                    if (*reinterpret_cast<int *>(buf + PAGE_SIZE - sizeof(int)) != round) {
+                        errors++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+    stop = true;
+    cleaner.join();
+    EXPECT_EQ(0, errors.load());
+
+    bpm->delete_all_pages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试分区的缓冲池：多线程并发创建、读写页面，批量预取和刷脏页跨越多个分区
+ * @note 生成测试文件sharded_test
+ */
+TEST_F(BufferPoolManagerTest, ShardedPoolTest) {
+    const std::string filename = "sharded_test";
+    const int num_shards = 4;
+    const int num_pages = num_shards * MIN_SHARD_FRAMES;
+    const int num_threads = 4;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, 0);
+    auto bpm = std::make_unique<BufferPoolManager>(num_pages, disk_manager_.get(), nullptr, num_shards);
+    EXPECT_EQ(static_cast<size_t>(num_shards), bpm->get_num_shards());
+    EXPECT_EQ(1u, std::make_unique<BufferPoolManager>(MIN_SHARD_FRAMES, disk_manager_.get(), nullptr, num_shards)
+                      ->get_num_shards());
+
+    // 每个线程创建一部分页面，页面内容为页面号；分区的帧数有富余，不会因为某个分区已满而失败
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < num_pages / num_threads / 2; i++) {
+                PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+                Page *page = bpm->new_page(&page_id);
+                ASSERT_NE(nullptr, page);
+                memcpy(page->get_data(), &page_id.page_no, sizeof(page_id_t));
+                EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+    threads.clear();
+    const int num_created = num_pages / 2;
+    EXPECT_EQ(num_created, disk_manager_->get_fd2pageno(fd));
+
+    // 并发随机读取
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            std::mt19937 rng(tid);
+            for (int i = 0; i < 10000; i++) {
+                PageId page_id = {.fd = fd, .page_no = static_cast<page_id_t>(rng() % num_created)};
+                Page *page = bpm->fetch_page(page_id);
+                ASSERT_NE(nullptr, page);
+                EXPECT_EQ(page_id.page_no, *reinterpret_cast<page_id_t *>(page->get_data()));
+                EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    // 写回全部分区后丢弃缓冲池中的页面，再用跨分区的批量预取读回
+    bpm->flush_all_pages(fd);
+    bpm->delete_all_pages(fd);
+    EXPECT_EQ(num_created, bpm->fetch_range(fd, 0, num_created));
+    for (page_id_t page_no = 0; page_no < num_created; page_no++) {
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        Page *page = bpm->fetch_page(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_FALSE(page->is_dirty());
+        EXPECT_EQ(page_no, *reinterpret_cast<page_id_t *>(page->get_data()));
+        EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+    }
+    bpm->delete_all_pages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试不加锁的命中路径：多个线程反复读取页面，同时缓冲池容量不足、不断有页面被替换，
+ * 读到的页面内容必须与页面号一致，且被固定的页面不会被替换
+ * @note 生成测试文件lock_free_test
+ */
+TEST_F(BufferPoolManagerTest, LockFreeHitTest) {
+    const std::string filename = "lock_free_test";
+    const int num_pages = 256;
+    const int pool_size = 64;
+    const int num_threads = 4;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    char buf[PAGE_SIZE];
+    for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+        memset(buf, 0, PAGE_SIZE);
+        memcpy(buf, &page_no, sizeof(page_id_t));
+        disk_manager_->write_page(fd, page_no, buf, PAGE_SIZE);
+    }
+    disk_manager_->set_fd2pageno(fd, num_pages);
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+
+    // 前8个页面是热点页面，其余页面的访问造成替换
+    std::atomic<long> errors{0};
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            std::mt19937 rng(tid);
+            for (int i = 0; i < 20000; i++) {
+                page_id_t page_no = rng() % 2 == 0 ? rng() % 8 : rng() % num_pages;
+                PageId page_id = {.fd = fd, .page_no = page_no};
+                Page *page = bpm->fetch_page(page_id);
+                if (page == nullptr) {
+                    continue;  // 所有帧都被其他线程固定
+                }
+                if (!(page->get_page_id() == page_id) || *reinterpret_cast<page_id_t *>(page->get_data()) != page_no) {
+                    errors++;
+                }
+                if (!bpm->unpin_page(page_id, false)) {
+                    errors++;
+                }
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+    EXPECT_EQ(0, errors.load());
+
+    // 固定次数正确：同一个页面固定两次，需要取消固定两次，第三次失败
+    PageId page_id = {.fd = fd, .page_no = 0};
+    ASSERT_NE(nullptr, bpm->fetch_page(page_id));
+    ASSERT_NE(nullptr, bpm->fetch_page(page_id));
+    EXPECT_FALSE(bpm->delete_page(page_id));
+    EXPECT_TRUE(bpm->unpin_page(page_id, true));
+    EXPECT_TRUE(bpm->unpin_page(page_id, false));
+    EXPECT_FALSE(bpm->unpin_page(page_id, false));
+    EXPECT_TRUE(bpm->delete_page(page_id));
+    EXPECT_FALSE(bpm->unpin_page(page_id, false));
+
+    bpm->delete_all_pages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试各置换策略接入缓冲池后的正确性：被固定的页面不会被替换，替换后重新读入的页面内容正确
+ * @note 生成测试文件replacer_types_test
+ */
+TEST_F(BufferPoolManagerTest, ReplacerTypesTest) {
+    const std::string filename = "replacer_types_test";
+    const int num_pages = 128;
+    const int pool_size = 16;
+    const int num_pinned = 4;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    char buf[PAGE_SIZE];
+    for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+        memset(buf, 0, PAGE_SIZE);
+        memcpy(buf, &page_no, sizeof(page_id_t));
+        disk_manager_->write_page(fd, page_no, buf, PAGE_SIZE);
+    }
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    for (const std::string replacer_type : {"LRU", "LRU-K", "2Q", "CLOCK"}) {
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+        bpm->set_replacer(replacer_type);
+        std::vector<Page *> pinned_pages;
+        for (page_id_t page_no = 0; page_no < num_pinned; page_no++) {
+            pinned_pages.push_back(bpm->fetch_page({.fd = fd, .page_no = page_no}));
+            ASSERT_NE(nullptr, pinned_pages.back()) << replacer_type;
+        }
+        std::mt19937 rng(0);
+        for (int i = 0; i < 5000; i++) {
+            page_id_t page_no = num_pinned + rng() % (num_pages - num_pinned);
+            PageId page_id = {.fd = fd, .page_no = page_no};
+            Page *page = bpm->fetch_page(page_id);
+            ASSERT_NE(nullptr, page) << replacer_type;
+            ASSERT_EQ(page_no, *reinterpret_cast<page_id_t *>(page->get_data())) << replacer_type;
+            ASSERT_TRUE(bpm->unpin_page(page_id, false)) << replacer_type;
+        }
+        for (page_id_t page_no = 0; page_no < num_pinned; page_no++) {
+            PageId page_id = {.fd = fd, .page_no = page_no};
+            EXPECT_TRUE(pinned_pages[page_no]->get_page_id() == page_id) << replacer_type;
+            EXPECT_EQ(page_no, *reinterpret_cast<page_id_t *>(pinned_pages[page_no]->get_data())) << replacer_type;
+            EXPECT_TRUE(bpm->unpin_page(page_id, false)) << replacer_type;
+        }
+        bpm->delete_all_pages(fd);
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试缓冲池访问策略：使用环形帧的大范围扫描和批量写入不会淘汰缓冲池中的其他页面，
+ * 环中的帧被复用时脏页先写回磁盘
+ * @note 生成测试文件access_strategy_test
+ */
+TEST_F(BufferPoolManagerTest, AccessStrategyTest) {
+    const std::string filename = "access_strategy_test";
+    const int num_pages = 2048;
+    const int num_hot_pages = 64;
+    const int pool_size = 256;
+    const int ring_pages = 64;  // 不小于预取批次，否则每批都有页面要从环外取帧
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    char buf[PAGE_SIZE];
+    for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+        memset(buf, 0, PAGE_SIZE);
+        memcpy(buf, &page_no, sizeof(page_id_t));
+        disk_manager_->write_page(fd, page_no, buf, PAGE_SIZE);
+    }
+    disk_manager_->set_fd2pageno(fd, num_pages);
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+    for (page_id_t page_no = 0; page_no < num_hot_pages; page_no++) {
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        ASSERT_NE(nullptr, bpm->fetch_page(page_id));
+        bpm->unpin_page(page_id, false);
+    }
+
+    // 1. 预取加逐页读取的扫描
+    auto strategy = bpm->create_access_strategy(ring_pages);
+    for (page_id_t page_no = num_hot_pages; page_no < num_pages; page_no++) {
+        if (page_no % 32 == 0) {
+            bpm->fetch_range(fd, page_no, 32, strategy.get());
+        }
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        Page *page = bpm->fetch_page(page_id, strategy.get());
+        ASSERT_NE(nullptr, page);
+        ASSERT_EQ(page_no, *reinterpret_cast<page_id_t *>(page->get_data()));
+        bpm->unpin_page(page_id, false);
+    }
+    EXPECT_GT(strategy->get_num_reused(), 0);
+
+    // 2. 批量写入新页面
+    auto bulk_strategy = bpm->create_access_strategy(ring_pages);
+    std::vector<page_id_t> new_page_nos;
+    for (int i = 0; i < 512; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id, bulk_strategy.get());
+        ASSERT_NE(nullptr, page);
+        memcpy(page->get_data(), &page_id.page_no, sizeof(page_id_t));
+        bpm->unpin_page(page_id, true);
+        new_page_nos.push_back(page_id.page_no);
+    }
+    EXPECT_GT(bulk_strategy->get_num_reused(), 0);
+
+    // 3. 热点页面仍在缓冲池中
+    size_t misses_before = bpm->get_num_fetch_misses();
+    for (page_id_t page_no = 0; page_no < num_hot_pages; page_no++) {
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        ASSERT_NE(nullptr, bpm->fetch_page(page_id));
+        bpm->unpin_page(page_id, false);
+    }
+    EXPECT_EQ(misses_before, bpm->get_num_fetch_misses());
+
+    // 4. 被复用的帧中的新页面已经写回
+    bpm->flush_all_pages(fd);
+    for (auto page_no : new_page_nos) {
+        disk_manager_->read_page(fd, page_no, buf, PAGE_SIZE);
+        ASSERT_EQ(page_no, *reinterpret_cast<page_id_t *>(buf));
+    }
+    bpm->delete_all_pages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试顺序预读：顺序访问时窗口逐次翻倍，预读的页面被访问时计入命中，没被访问就被替换时计入浪费；
+ * 流析构时取消未执行的预读
+ * @note 生成测试文件readahead_test
+ */
+TEST_F(BufferPoolManagerTest, ReadaheadTest) {
+    const std::string filename = "readahead_test";
+    const int num_pages = 1024;
+    const int pool_size = 512;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    char buf[PAGE_SIZE];
+    for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+        memset(buf, 0, PAGE_SIZE);
+        memcpy(buf, &page_no, sizeof(page_id_t));
+        disk_manager_->write_page(fd, page_no, buf, PAGE_SIZE);
+    }
+    disk_manager_->set_fd2pageno(fd, num_pages);
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+
+    // 1. 顺序扫描，每个页面访问多次
+    {
+        ReadaheadStream stream(bpm.get(), fd, nullptr, 128);
+        for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+            for (int i = 0; i < 3; i++) {
+                stream.access(page_no, num_pages);
+                PageId page_id = {.fd = fd, .page_no = page_no};
+                Page *page = bpm->fetch_page(page_id);
+                ASSERT_NE(nullptr, page);
+                ASSERT_EQ(page_no, *reinterpret_cast<page_id_t *>(page->get_data()));
+                bpm->unpin_page(page_id, false);
+            }
+        }
+        EXPECT_EQ(128, stream.get_window());
+        EXPECT_EQ(num_pages, stream.get_num_pages_requested());
+        // 窗口依次为16, 32, 64, 128, 128, ...，最后一个窗口截断到文件末尾
+        EXPECT_EQ(4 + (num_pages - 16 - 32 - 64 - 128 + 127) / 128, stream.get_num_windows());
+    }
+    EXPECT_GT(bpm->get_num_prefetch_hits(), 0);
+    EXPECT_LE(bpm->get_num_prefetch_hits(), bpm->get_num_prefetched());
+    EXPECT_LE(bpm->get_num_prefetched(), num_pages);
+
+    // 2. 不连续的访问使窗口恢复为最小值
+    {
+        ReadaheadStream stream(bpm.get(), fd);
+        stream.access(0, num_pages);
+        stream.access(1, num_pages);
+        EXPECT_GT(stream.get_window(), READAHEAD_MIN_PAGES);
+        stream.access(100, num_pages);
+        EXPECT_EQ(READAHEAD_MIN_PAGES * 2, stream.get_window());
+    }
+
+    // 3. 预取而没有被访问的页面被替换后计入浪费
+    bpm->delete_all_pages(fd);
+    size_t wasted_before = bpm->get_num_prefetch_wasted();
+    ASSERT_EQ(pool_size, bpm->fetch_range(fd, 0, pool_size));
+    for (page_id_t page_no = pool_size; page_no < num_pages; page_no++) {
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        ASSERT_NE(nullptr, bpm->fetch_page(page_id));
+        bpm->unpin_page(page_id, false);
+    }
+    EXPECT_EQ(wasted_before + pool_size, bpm->get_num_prefetch_wasted());
+
+    // 4. 预读时写回脏页失败只放弃这个窗口，预读线程继续工作。把另一个文件的句柄换成只读的，缓冲池中都是它的脏页
+    bpm->delete_all_pages(fd);
+    const std::string dirty_filename = "readahead_dirty_test";
+    disk_manager_->create_file(dirty_filename);
+    int dirty_fd = disk_manager_->open_file(dirty_filename);
+    disk_manager_->set_fd2pageno(dirty_fd, 0);
+    for (int i = 0; i < pool_size; i++) {
+        PageId page_id = {.fd = dirty_fd, .page_no = INVALID_PAGE_ID};
+        ASSERT_NE(nullptr, bpm->new_page(&page_id));
+        bpm->unpin_page(page_id, true);
+    }
+    int saved_fd = dup(dirty_fd);
+    int null_fd = open("/dev/null", O_RDONLY);
+    ASSERT_EQ(dirty_fd, dup2(null_fd, dirty_fd));
+    bpm->submit_readahead({.fd = fd, .start_page_no = 0, .n = 16, .strategy = nullptr, .stream = nullptr});
+    bpm->cancel_readahead(fd);
+    ASSERT_EQ(dirty_fd, dup2(saved_fd, dirty_fd));
+    close(null_fd);
+    close(saved_fd);
+    bpm->submit_readahead({.fd = fd, .start_page_no = 0, .n = 16, .strategy = nullptr, .stream = nullptr});
+    bpm->cancel_readahead(fd);
+    PageId page_id = {.fd = fd, .page_no = 0};
+    ASSERT_NE(nullptr, bpm->fetch_page(page_id));
+    bpm->unpin_page(page_id, false);
+
+    bpm->flush_all_pages(dirty_fd);
+    bpm->delete_all_pages(dirty_fd);
+    disk_manager_->close_file(dirty_fd);
+    bpm->delete_all_pages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试缓冲池的延迟分配：创建很大的缓冲池时常驻内存几乎不增加，之后随用到的帧数增长；
+ * 被删除的帧优先复用，页面内容正确
+ * @note 生成测试文件lazy_alloc_test
+ */
+TEST_F(BufferPoolManagerTest, LazyAllocationTest) {
+    auto resident_bytes = []() {
+        long size = 0;
+        long resident = 0;
+        FILE *statm = fopen("/proc/self/statm", "r");
+        if (statm == nullptr) {
+            return 0l;
+        }
+        if (fscanf(statm, "%ld %ld", &size, &resident) != 2) {
+            resident = 0;
+        }
+        fclose(statm);
+        return resident * sysconf(_SC_PAGESIZE);
+    };
+    const size_t pool_size = (1ul << 30) / PAGE_SIZE;  // 1GB
+    const int num_pages = 1000;
+    const std::string filename = "lazy_alloc_test";
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, 0);
+
+    long resident_before = resident_bytes();
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get(), nullptr, BUFFER_POOL_SHARDS);
+    long resident_created = resident_bytes();
+    EXPECT_LT(resident_created - resident_before, 64l << 20);
+
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0, page->get_data()[PAGE_SIZE - 1]);
+        memcpy(page->get_data(), &i, sizeof(int));
+        bpm->unpin_page(page_id, true);
+        page_ids.push_back(page_id);
+    }
+    // 用到的帧的数据和元数据都已经分配，但远小于整个缓冲池
+    long resident_used = resident_bytes();
+    EXPECT_GE(resident_used - resident_before, static_cast<long>(num_pages) * PAGE_SIZE);
+    EXPECT_LT(resident_used - resident_before, (64l << 20) + static_cast<long>(num_pages) * PAGE_SIZE * 2);
+
+    // 删除一半页面再重新读入，复用释放的帧
+    for (int i = 0; i < num_pages; i += 2) {
+        EXPECT_TRUE(bpm->delete_page(page_ids[i]));
+    }
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->fetch_page(page_ids[i]);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(i, *reinterpret_cast<int *>(page->get_data()));
+        bpm->unpin_page(page_ids[i], false);
+    }
+    EXPECT_LT(resident_bytes() - resident_used, 16l << 20);
+
+    bpm->flush_all_pages(fd);
+    bpm.reset();
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试帧内存的各种分配方式：是否使用大页、各种NUMA策略下缓冲池都能正确读写页面，帧数据按PAGE_SIZE对齐
+ * @note 生成测试文件frame_arena_test
+ */
+TEST_F(BufferPoolManagerTest, FrameArenaTest) {
+    const std::string filename = "frame_arena_test";
+    const int num_pages = 4 * MIN_SHARD_FRAMES;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    disk_manager_->set_fd2pageno(fd, 0);
+    int num_nodes = static_cast<int>(FrameArena::numa_nodes().size());
+
+    page_id_t next_page_no = 0;
+    for (bool huge_pages : {false, true}) {
+        for (auto numa_policy : {NumaPolicy::NONE, NumaPolicy::INTERLEAVE, NumaPolicy::SHARD_LOCAL}) {
+            FrameArenaConfig config{.huge_pages = huge_pages, .numa_policy = numa_policy};
+            auto bpm = std::make_unique<BufferPoolManager>(num_pages / 2, disk_manager_.get(), nullptr, 2, config);
+            if (!huge_pages) {
+                EXPECT_EQ(HugePageType::NONE, bpm->get_huge_page_type());
+            }
+            if (numa_policy == NumaPolicy::NONE || num_nodes <= 1) {
+                EXPECT_EQ(0, bpm->get_num_numa_nodes());
+            }
+            EXPECT_LE(bpm->get_num_numa_nodes(), num_nodes);
+
+            // 新建的页面数是帧数的两倍，一半页面被换出后再读回
+            std::vector<PageId> page_ids;
+            for (int i = 0; i < num_pages; i++) {
+                PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+                Page *page = bpm->new_page(&page_id);
+                ASSERT_NE(nullptr, page);
+                EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(page->get_data()) % PAGE_SIZE);
+                int value = page_id.page_no + next_page_no;
+                memcpy(page->get_data(), &value, sizeof(int));
+                bpm->unpin_page(page_id, true);
+                page_ids.push_back(page_id);
+            }
+            for (auto &page_id : page_ids) {
+                Page *page = bpm->fetch_page(page_id);
+                ASSERT_NE(nullptr, page);
+                EXPECT_EQ(page_id.page_no + next_page_no, *reinterpret_cast<int *>(page->get_data()));
+                bpm->unpin_page(page_id, false);
+            }
+            bpm->flush_all_pages(fd);
+            next_page_no++;
+        }
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试不持有latch的页面换入换出：多个线程在很小的缓冲池上随机读改写页面，脏页频繁被替换，
+ * 写回期间和读入期间请求同一页面的线程等待I/O完成；最后从磁盘读回的计数之和等于修改的次数
+ * @note 生成测试文件in_flight_io_test
+ */
+TEST_F(BufferPoolManagerTest, InFlightIoTest) {
+    const std::string filename = "in_flight_io_test";
+    const int num_pages = 128;
+    const int num_threads = 8;
+    const int ops_per_thread = 2000;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    char buf[PAGE_SIZE] = {0};
+    for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+        memcpy(buf + sizeof(int), &page_no, sizeof(page_id_t));
+        disk_manager_->write_page(fd, page_no, buf, PAGE_SIZE);
+    }
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    auto bpm = std::make_unique<BufferPoolManager>(32, disk_manager_.get());
+    std::atomic<int> errors = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(t);
+            // 一半线程集中访问前几个页面，使多个线程同时请求同一个缺失的页面
+            std::uniform_int_distribution<page_id_t> dist(0, t % 2 == 0 ? num_pages - 1 : 7);
+            for (int i = 0; i < ops_per_thread; i++) {
+                PageId page_id = {.fd = fd, .page_no = dist(rng)};
+                Page *page = bpm->fetch_page(page_id);
+                if (page == nullptr) {
+                    errors++;
+                    continue;
+                }
+                page->WLatch();
+                int *counter = reinterpret_cast<int *>(page->get_data());
+                if (*reinterpret_cast<page_id_t *>(page->get_data() + sizeof(int)) != page_id.page_no) {
+                    errors++;
+                }
+                (*counter)++;
+                page->WUnlatch();
+                bpm->unpin_page(page_id, true);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, errors.load());
+    EXPECT_GT(bpm->get_num_dirty_evictions(), 0);
+    bpm->flush_all_pages(fd);
+    bpm.reset();
+
+    long total = 0;
+    for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+        disk_manager_->read_page(fd, page_no, buf, PAGE_SIZE);
+        total += *reinterpret_cast<int *>(buf);
+    }
+    EXPECT_EQ(static_cast<long>(num_threads) * ops_per_thread, total);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 测试热页面列表：保存缓冲池中的页面后，新的缓冲池按列表在后台预读，之后访问这些页面全部命中；
+ * 列表只保留缓冲池能容纳的最热的页面；列表文件不存在或损坏时不预读
+ * @note 生成测试文件warm_restart_test
+ */
+TEST_F(BufferPoolManagerTest, WarmRestartTest) {
+    const std::string filename = "warm_restart_test";
+    const std::string hot_file = "warm_restart_test.hot";
+    const int num_pages = 1024;
+    const int pool_size = 256;
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+    char buf[PAGE_SIZE] = {0};
+    for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+        memcpy(buf, &page_no, sizeof(page_id_t));
+        disk_manager_->write_page(fd, page_no, buf, PAGE_SIZE);
+    }
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    // 1. 先访问所有页面，再访问热页面（页面号为3的倍数）
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+    std::vector<page_id_t> hot_pages;
+    for (page_id_t page_no = 0; page_no < num_pages; page_no++) {
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        ASSERT_NE(nullptr, bpm->fetch_page(page_id));
+        bpm->unpin_page(page_id, false);
+    }
+    for (page_id_t page_no = 0; page_no < num_pages && hot_pages.size() < pool_size / 2; page_no += 3) {
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        ASSERT_NE(nullptr, bpm->fetch_page(page_id));
+        bpm->unpin_page(page_id, false);
+        hot_pages.push_back(page_no);
+    }
+    EXPECT_EQ(static_cast<size_t>(pool_size), bpm->save_hot_pages(hot_file));
+    bpm.reset();
+
+    // 2. 新的缓冲池按列表预读，等待预读完成后热页面全部命中
+    bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+    size_t num_requested = bpm->load_hot_pages(hot_file);
+    EXPECT_GE(num_requested, hot_pages.size());
+    EXPECT_LE(num_requested, static_cast<size_t>(pool_size));
+    for (int i = 0; i < 1000 && bpm->get_num_prefetched() < num_requested; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(num_requested, bpm->get_num_prefetched());
+    for (auto page_no : hot_pages) {
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        Page *page = bpm->fetch_page(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(page_no, *reinterpret_cast<page_id_t *>(page->get_data()));
+        bpm->unpin_page(page_id, false);
+    }
+    EXPECT_EQ(0u, bpm->get_num_fetch_misses());
+
+    // 3. 列表文件不存在或损坏时不预读
+    EXPECT_EQ(0u, bpm->load_hot_pages("no_such_file.hot"));
+    {
+        std::ofstream ofs(hot_file, std::ios::binary | std::ios::trunc);
+        ofs << "garbage";
+    }
+    EXPECT_EQ(0u, bpm->load_hot_pages(hot_file));
+
+    // 4. 关闭文件之后保存的列表中不包括它的页面
+    bpm->cancel_readahead(fd);
+    bpm->flush_all_pages(fd);
+    disk_manager_->close_file(fd);
+    EXPECT_EQ(0u, bpm->save_hot_pages(hot_file));
+}
@@ -13,16 +13,55 @@ See the Mulan PSL v2 for more details. */
 #include <assert.h>    // for assert
 #include <fcntl.h>     // for open
 #include <string.h>    // for memset
+#include <limits.h>    // for IOV_MAX
 #include <sys/stat.h>  // for stat
-#include <unistd.h>    // for lseek
+#include <sys/uio.h>   // for preadv, pwritev
+#include <unistd.h>    // for pread, pwrite
 #include <cerrno>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "defs.h"
+#include "storage/page_codec.h"
+
+namespace {
+
+// O_DIRECT要求内存地址、文件偏移和读写长度都按块大小对齐；文件偏移总是PAGE_SIZE的整数倍，只需检查内存和长度
+bool is_aligned(const void *buf, size_t num_bytes) {
+    return reinterpret_cast<uintptr_t>(buf) % PAGE_SIZE == 0 && num_bytes % PAGE_SIZE == 0;
+}
+
+// 不满足对齐要求的读写经过这个按PAGE_SIZE对齐的中转缓冲区，每个线程一个
+char *bounce_buffer() {
+    static thread_local std::unique_ptr<char, decltype(&std::free)> buf(
+        static_cast<char *>(std::aligned_alloc(PAGE_SIZE, PAGE_SIZE)), &std::free);
+    return buf.get();
+}
+
+// 压缩页面的中转缓冲区，每个线程一个
+char *codec_buffer() {
+    static thread_local std::unique_ptr<char[]> buf(new char[PAGE_SIZE]);
+    return buf.get();
+}
+
+// 压缩后的num_bytes个字节占用的单元个数
+uint32_t units_of(uint32_t num_bytes) { return (num_bytes + COMPRESS_UNIT_SIZE - 1) / COMPRESS_UNIT_SIZE; }
+
+}  // namespace
 
 DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<page_id_t>) / sizeof(char))); }
 
+DiskManager::~DiskManager() {
+    for (auto &file : fd2compressed_) {
+        delete file.load();
+    }
+}
+
 /**
  * @description: 将数据写入文件的指定磁盘页面中
  * @param {int} fd 磁盘文件的文件句柄
@@ -31,14 +70,32 @@ DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<
  * @param {int} num_bytes 要写入磁盘的数据大小
  */
 void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int num_bytes) {
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
+    // 压缩文件的第0页为文件头，按原样存放；其余页面压缩后写入
+    CompressedFile *file = fd2compressed_[fd];
+    if (file != nullptr && page_no != 0) {
+        write_compressed_page(fd, file, page_no, offset, num_bytes);
+        return;
+    }
+    // 使用pwrite按(fd,page_no)定位写入，不修改fd共享的文件偏移量，多线程可以并发写同一个文件
     off_t offset_in_file = static_cast<off_t>(page_no) * PAGE_SIZE;
-    off_t result = lseek(fd, offset_in_file, SEEK_SET);
-    if (result == -1) {
-        throw InternalError("DiskManager::lseek Error");
+    if (direct_io_ && !is_aligned(offset, num_bytes)) {
+        // 文件头等不足一页的写入：先读出整个页面，修改前num_bytes个字节后整页写回，页面其余部分保持不变
+        assert(num_bytes <= PAGE_SIZE);
+        char *buf = bounce_buffer();
+        if (num_bytes < PAGE_SIZE) {
+            ssize_t bytes_read = pread(fd, buf, PAGE_SIZE, offset_in_file);
+            if (bytes_read == -1) {
+                throw InternalError("DiskManager::write_page Error");
+            }
+            memset(buf + bytes_read, 0, PAGE_SIZE - bytes_read);
+        }
+        memcpy(buf, offset, num_bytes);
+        if (pwrite(fd, buf, PAGE_SIZE, offset_in_file) != PAGE_SIZE) {
+            throw InternalError("DiskManager::write_page Error");
+        }
+        return;
     }
-    // 2.调用write()函数
-    ssize_t bytes_written = write(fd, offset, num_bytes);
+    ssize_t bytes_written = pwrite(fd, offset, num_bytes, offset_in_file);
     // 注意write返回值与num_bytes不等时 throw
     // InternalError("DiskManager::write_page Error");
     if (bytes_written == -1 || bytes_written != num_bytes) {
@@ -54,16 +111,28 @@ void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int
  * @param {int} num_bytes 读取的数据量大小
  */
 void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_bytes) {
-    // Todo:
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
+    CompressedFile *file = fd2compressed_[fd];
+    if (file != nullptr && page_no != 0) {
+        // 与读取文件末尾之后的页面一致，读取从未写入过的页面视为错误
+        if (!read_compressed_page(fd, file, page_no, offset, num_bytes)) {
+            throw InternalError("DiskManager::read_page Error");
+        }
+        return;
+    }
+    // 使用pread按(fd,page_no)定位读取，一次系统调用，且不依赖fd共享的文件偏移量
     off_t offset_in_file = static_cast<off_t>(page_no) * PAGE_SIZE;
-    off_t result = lseek(fd, offset_in_file, SEEK_SET);
-    if (result == -1) {
-        throw InternalError("DiskManager::lseek Error");
+    if (direct_io_ && !is_aligned(offset, num_bytes)) {
+        // 读出整个页面，再复制需要的部分
+        assert(num_bytes <= PAGE_SIZE);
+        char *buf = bounce_buffer();
+        ssize_t bytes_read = pread(fd, buf, PAGE_SIZE, offset_in_file);
+        if (bytes_read == -1 || bytes_read < num_bytes) {
+            throw InternalError("DiskManager::read_page Error");
+        }
+        memcpy(offset, buf, num_bytes);
+        return;
     }
-
-    // 2.调用read()函数
-    ssize_t bytes_read = read(fd, offset, num_bytes);
+    ssize_t bytes_read = pread(fd, offset, num_bytes, offset_in_file);
     // 注意read返回值与num_bytes不等时，throw
     // InternalError("DiskManager::read_page Error");
     if (bytes_read == -1 || bytes_read != num_bytes) {
@@ -72,17 +141,460 @@ void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_byt
 }
 
 /**
- * @description: 分配一个新的页号
+ * @description: 读取文件中从start_page_no开始的n个连续页面，bufs[i]存放第start_page_no+i个页面
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} start_page_no 起始页面编号
+ * @param {int} n 页面个数
+ * @param {char**} bufs 每个页面对应的内存地址，每个大小为PAGE_SIZE
+ * @note 使用preadv，一次系统调用读取一段连续的页面；超出文件末尾的部分填0
+ */
+void DiskManager::read_pages(int fd, page_id_t start_page_no, int n, char **bufs) {
+    CompressedFile *file = fd2compressed_[fd];
+    if (file != nullptr) {
+        // 压缩文件中相邻页面不一定连续存放，逐页读取并解压；从未写入过的页面填0
+        for (int i = 0; i < n; i++) {
+            if (start_page_no + i == 0) {
+                read_page(fd, 0, bufs[i], PAGE_SIZE);
+            } else if (!read_compressed_page(fd, file, start_page_no + i, bufs[i], PAGE_SIZE)) {
+                memset(bufs[i], 0, PAGE_SIZE);
+            }
+        }
+        return;
+    }
+    if (direct_io_ && std::any_of(bufs, bufs + n, [](char *buf) { return !is_aligned(buf, PAGE_SIZE); })) {
+        // 存在未对齐的缓冲区，逐页经过中转缓冲区读取
+        char *buf = bounce_buffer();
+        for (int i = 0; i < n; i++) {
+            off_t offset_in_file = static_cast<off_t>(start_page_no + i) * PAGE_SIZE;
+            ssize_t bytes_read = pread(fd, buf, PAGE_SIZE, offset_in_file);
+            if (bytes_read == -1) {
+                throw InternalError("DiskManager::read_pages Error");
+            }
+            memset(buf + bytes_read, 0, PAGE_SIZE - bytes_read);
+            memcpy(bufs[i], buf, PAGE_SIZE);
+        }
+        return;
+    }
+    std::vector<struct iovec> iov(std::min(n, IOV_MAX));
+    int done = 0;
+    while (done < n) {
+        int batch = std::min(n - done, IOV_MAX);
+        for (int i = 0; i < batch; i++) {
+            iov[i].iov_base = bufs[done + i];
+            iov[i].iov_len = PAGE_SIZE;
+        }
+        off_t offset_in_file = static_cast<off_t>(start_page_no + done) * PAGE_SIZE;
+        ssize_t bytes_read = preadv(fd, iov.data(), batch, offset_in_file);
+        if (bytes_read == -1) {
+            throw InternalError("DiskManager::read_pages Error");
+        }
+        // 短读只会发生在文件末尾，末尾之后的页面视为全0
+        if (bytes_read < static_cast<ssize_t>(batch) * PAGE_SIZE) {
+            for (int i = 0; i < batch; i++) {
+                ssize_t page_start = static_cast<ssize_t>(i) * PAGE_SIZE;
+                if (bytes_read <= page_start) {
+                    memset(bufs[done + i], 0, PAGE_SIZE);
+                } else if (bytes_read < page_start + PAGE_SIZE) {
+                    memset(bufs[done + i] + (bytes_read - page_start), 0, page_start + PAGE_SIZE - bytes_read);
+                }
+            }
+        }
+        done += batch;
+    }
+}
+
+/**
+ * @description: 将n个页面写入文件中从start_page_no开始的连续位置
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} start_page_no 起始页面编号
+ * @param {int} n 页面个数
+ * @param {char**} bufs 每个页面对应的内存地址，每个大小为PAGE_SIZE
+ * @note 使用pwritev，一次系统调用写入一段连续的页面
+ */
+void DiskManager::write_pages(int fd, page_id_t start_page_no, int n, char **bufs) {
+    if (fd2compressed_[fd] != nullptr) {
+        for (int i = 0; i < n; i++) {
+            write_page(fd, start_page_no + i, bufs[i], PAGE_SIZE);
+        }
+        return;
+    }
+    if (direct_io_ && std::any_of(bufs, bufs + n, [](char *buf) { return !is_aligned(buf, PAGE_SIZE); })) {
+        // 存在未对齐的缓冲区，逐页写入
+        for (int i = 0; i < n; i++) {
+            write_page(fd, start_page_no + i, bufs[i], PAGE_SIZE);
+        }
+        return;
+    }
+    std::vector<struct iovec> iov(std::min(n, IOV_MAX));
+    int done = 0;
+    while (done < n) {
+        int batch = std::min(n - done, IOV_MAX);
+        for (int i = 0; i < batch; i++) {
+            iov[i].iov_base = bufs[done + i];
+            iov[i].iov_len = PAGE_SIZE;
+        }
+        off_t offset_in_file = static_cast<off_t>(start_page_no + done) * PAGE_SIZE;
+        ssize_t bytes_written = pwritev(fd, iov.data(), batch, offset_in_file);
+        if (bytes_written != static_cast<ssize_t>(batch) * PAGE_SIZE) {
+            throw InternalError("DiskManager::write_pages Error");
+        }
+        done += batch;
+    }
+}
+
+/**
+ * @description: 把文件已经写入的页面持久化到磁盘，压缩文件同时持久化其页面映射
+ * @param {int} fd 磁盘文件的文件句柄
+ */
+void DiskManager::sync_file(int fd) {
+    CompressedFile *file = fd2compressed_[fd];
+    if (file != nullptr) {
+        sync_compressed(fd, file);
+        return;
+    }
+    if (fsync(fd) == -1) {
+        throw UnixError();
+    }
+}
+
+void DiskManager::set_io_backend(IoBackendType type) {
+    io_backend_ = type;
+    if (type == IoBackendType::URING && create_async_io(1)->type() != IoBackendType::URING) {
+        // 内核不支持io_uring或被seccomp禁止
+        std::cerr << "io_uring is not available, fall back to synchronous page I/O" << std::endl;
+        io_backend_ = IoBackendType::SYNC;
+    }
+}
+
+/**
+ * @description: 分配一个新的页号，优先复用已释放的页面
  * @return {page_id_t} 分配的新页号
  * @param {int} fd 指定文件的文件句柄
  */
 page_id_t DiskManager::allocate_page(int fd) {
-    // 简单的自增分配策略，指定文件的页面编号加1
     assert(fd >= 0 && fd < MAX_FD);
+    {
+        std::scoped_lock lock{free_pages_latch_};
+        auto iter = fd2free_pages_.find(fd);
+        if (iter != fd2free_pages_.end() && !iter->second.empty()) {
+            page_id_t page_no = iter->second.back();
+            iter->second.pop_back();
+            return page_no;
+        }
+    }
+    // 没有可复用的页面时使用简单的自增分配策略，指定文件的页面编号加1
     return fd2pageno_[fd]++;
 }
 
-void DiskManager::deallocate_page(__attribute__((unused)) page_id_t page_id) {}
+/**
+ * @description: 保证文件中page_no号页面所在的磁盘空间已经分配。不足时以extent为单位调用fallocate扩展文件，
+ * 这样顺序追加页面时，文件系统只需为每个extent分配一次空间、更新一次元数据，而不是每写回一个新页面都扩展一次文件
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} page_no 即将使用的页面号
+ * @param {page_id_t} num_allocated_pages 文件中已经预分配的页面个数，由调用者记录在文件头中
+ * @return {page_id_t} 扩展后文件中已经预分配的页面个数
+ */
+page_id_t DiskManager::preallocate_pages(int fd, page_id_t page_no, page_id_t num_allocated_pages) {
+    // 压缩文件中页面的位置与页面号无关，不做预分配
+    if (page_no < num_allocated_pages || extent_pages_ == 0 || !fallocate_supported_ || is_compressed(fd)) {
+        return num_allocated_pages;
+    }
+    // 扩展到包含page_no的extent的末尾，extent按文件偏移对齐
+    page_id_t new_num_pages = (page_no / extent_pages_ + 1) * extent_pages_;
+    off_t offset = static_cast<off_t>(num_allocated_pages) * PAGE_SIZE;
+    off_t len = static_cast<off_t>(new_num_pages - num_allocated_pages) * PAGE_SIZE;
+    if (fallocate(fd, 0, offset, len) == -1) {
+        if (errno == EOPNOTSUPP || errno == ENOSYS) {
+            // 文件系统不支持fallocate，退化为写回时逐页扩展
+            fallocate_supported_ = false;
+            return num_allocated_pages;
+        }
+        throw UnixError();
+    }
+    return new_num_pages;
+}
+
+/**
+ * @description: 释放文件中的一个页面，之后allocate_page可以重新分配该页面号
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} page_no 要释放的页面号，调用者需保证该页面已不再被引用，且已从缓冲池中删除
+ */
+void DiskManager::deallocate_page(int fd, page_id_t page_no) {
+    assert(fd >= 0 && fd < MAX_FD);
+    std::scoped_lock lock{free_pages_latch_};
+    fd2free_pages_[fd].push_back(page_no);
+}
+
+/**
+ * @description: 获得文件中可以重新分配的页面个数
+ */
+int DiskManager::get_num_free_pages(int fd) {
+    std::scoped_lock lock{free_pages_latch_};
+    auto iter = fd2free_pages_.find(fd);
+    return iter == fd2free_pages_.end() ? 0 : iter->second.size();
+}
+
+/**
+ * @description: 打开文件时读入该文件的空闲页面表，并删除空闲页面表文件。
+ * 这样在文件被正常关闭之前崩溃，只会丢失空闲页面（空间泄露），而不会把仍在使用的页面分配出去
+ */
+void DiskManager::load_free_pages(int fd, const std::string &path) {
+    std::vector<page_id_t> free_pages;
+    std::string free_path = path + FREE_PAGE_FILE_SUFFIX;
+    if (is_file(free_path)) {
+        int size = get_file_size(free_path);
+        free_pages.resize(size / sizeof(page_id_t));
+        int free_fd = open(free_path.c_str(), O_RDONLY);
+        if (free_fd == -1) {
+            throw UnixError();
+        }
+        ssize_t bytes_read = pread(free_fd, free_pages.data(), free_pages.size() * sizeof(page_id_t), 0);
+        close(free_fd);
+        if (bytes_read != static_cast<ssize_t>(free_pages.size() * sizeof(page_id_t))) {
+            throw InternalError("DiskManager::load_free_pages Error");
+        }
+        if (unlink(free_path.c_str()) == -1) {
+            throw UnixError();
+        }
+    }
+    std::scoped_lock lock{free_pages_latch_};
+    fd2free_pages_[fd] = std::move(free_pages);
+}
+
+/**
+ * @description: 关闭文件时把该文件的空闲页面表写入空闲页面表文件，先写临时文件再rename
+ */
+void DiskManager::save_free_pages(int fd, const std::string &path) {
+    std::vector<page_id_t> free_pages;
+    {
+        std::scoped_lock lock{free_pages_latch_};
+        auto iter = fd2free_pages_.find(fd);
+        if (iter != fd2free_pages_.end()) {
+            free_pages = std::move(iter->second);
+            fd2free_pages_.erase(iter);
+        }
+    }
+    if (free_pages.empty()) {
+        return;
+    }
+    std::string free_path = path + FREE_PAGE_FILE_SUFFIX;
+    std::string tmp_path = free_path + ".tmp";
+    int free_fd = open(tmp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (free_fd == -1) {
+        throw UnixError();
+    }
+    ssize_t num_bytes = free_pages.size() * sizeof(page_id_t);
+    ssize_t bytes_written = pwrite(free_fd, free_pages.data(), num_bytes, 0);
+    close(free_fd);
+    if (bytes_written != num_bytes || rename(tmp_path.c_str(), free_path.c_str()) == -1) {
+        throw InternalError("DiskManager::save_free_pages Error");
+    }
+}
+
+/**
+ * @description: 打开压缩文件时读入页面映射，并根据映射重建空闲单元
+ */
+void DiskManager::open_compressed(int fd, const std::string &path) {
+    std::string map_path = path + COMPRESSED_MAP_SUFFIX;
+    auto file = std::make_unique<CompressedFile>();
+    file->map_fd = open(map_path.c_str(), O_RDWR);
+    if (file->map_fd == -1) {
+        throw UnixError();
+    }
+    file->extents.resize(get_file_size(map_path) / sizeof(CompressedExtent));
+    ssize_t num_bytes = file->extents.size() * sizeof(CompressedExtent);
+    if (pread(file->map_fd, file->extents.data(), num_bytes, 0) != num_bytes) {
+        throw InternalError("DiskManager::open_compressed Error");
+    }
+    // 文件头之后、没有被任何页面占用的单元都是空闲的
+    std::vector<std::pair<uint32_t, uint32_t>> used;
+    for (auto &extent : file->extents) {
+        if (extent.unit_no != 0) {
+            used.emplace_back(extent.unit_no, units_of(extent.num_bytes));
+        }
+    }
+    std::sort(used.begin(), used.end());
+    file->free_runs.resize(units_of(PAGE_SIZE) + 1);
+    uint32_t unit_no = units_of(PAGE_SIZE);
+    for (auto &[start, num_units] : used) {
+        if (start > unit_no) {
+            free_units(file.get(), unit_no, start - unit_no);
+        }
+        unit_no = std::max(unit_no, start + num_units);
+    }
+    file->end_unit = unit_no;
+    fd2compressed_[fd] = file.release();
+}
+
+/**
+ * @description: 持久化压缩文件：先fsync数据，再写入这期间改变的页面映射项并fsync映射文件，最后复用被取代的单元。
+ *              磁盘上的页面映射只会指向已经落盘的数据，崩溃后每个页面都是某次sync_file时的完整版本
+ */
+void DiskManager::sync_compressed(int fd, CompressedFile *file) {
+    std::scoped_lock sync_lock{file->sync_latch};
+    std::vector<page_id_t> dirty_pages;
+    std::vector<CompressedExtent> extents;
+    std::vector<std::pair<uint32_t, uint32_t>> pending;
+    {
+        // 取出的区间已被dirty_pages中的映射项取代，这些映射项落盘之后才能复用
+        std::scoped_lock lock{file->latch};
+        dirty_pages.swap(file->dirty_map_pages);
+        pending.swap(file->pending_free);
+        std::sort(dirty_pages.begin(), dirty_pages.end());
+        dirty_pages.erase(std::unique(dirty_pages.begin(), dirty_pages.end()), dirty_pages.end());
+        for (auto page_no : dirty_pages) {
+            extents.push_back(file->extents[page_no]);
+        }
+    }
+    auto restore = [&]() {
+        std::scoped_lock lock{file->latch};
+        file->dirty_map_pages.insert(file->dirty_map_pages.end(), dirty_pages.begin(), dirty_pages.end());
+        file->pending_free.insert(file->pending_free.end(), pending.begin(), pending.end());
+    };
+    if (fsync(fd) == -1) {
+        UnixError error;
+        restore();
+        throw error;
+    }
+    for (size_t i = 0; i < dirty_pages.size(); i++) {
+        off_t map_offset = static_cast<off_t>(dirty_pages[i]) * sizeof(CompressedExtent);
+        if (pwrite(file->map_fd, &extents[i], sizeof(CompressedExtent), map_offset) != sizeof(CompressedExtent)) {
+            restore();
+            throw InternalError("DiskManager::sync_file Error");
+        }
+    }
+    if (fsync(file->map_fd) == -1) {
+        UnixError error;
+        restore();
+        throw error;
+    }
+    if (!pending.empty()) {
+        std::scoped_lock lock{file->latch};
+        for (auto &[unit_no, num_units] : pending) {
+            free_units(file, unit_no, num_units);
+        }
+    }
+}
+
+void DiskManager::close_compressed(int fd) {
+    CompressedFile *file = fd2compressed_[fd];
+    if (file != nullptr && !file->dirty_map_pages.empty()) {
+        // 关闭前写入还没有落盘的页面映射，否则重新打开后读到的是旧版本的页面
+        sync_compressed(fd, file);
+    }
+    file = fd2compressed_[fd].exchange(nullptr);
+    if (file != nullptr) {
+        close(file->map_fd);
+        delete file;
+    }
+}
+
+/**
+ * @description: 分配num_units个连续的空闲单元，优先使用大小相同的空闲区间，其次拆分更大的空闲区间，最后追加到文件末尾
+ * @return {uint32_t} 起始单元号
+ */
+uint32_t DiskManager::allocate_units(CompressedFile *file, uint32_t num_units) {
+    for (uint32_t len = num_units; len < file->free_runs.size(); len++) {
+        auto &runs = file->free_runs[len];
+        if (!runs.empty()) {
+            uint32_t unit_no = runs.back();
+            runs.pop_back();
+            if (len > num_units) {
+                free_units(file, unit_no + num_units, len - num_units);
+            }
+            return unit_no;
+        }
+    }
+    uint32_t unit_no = file->end_unit;
+    file->end_unit += num_units;
+    return unit_no;
+}
+
+void DiskManager::free_units(CompressedFile *file, uint32_t unit_no, uint32_t num_units) {
+    uint32_t max_len = file->free_runs.size() - 1;
+    while (num_units > 0) {
+        uint32_t len = std::min(num_units, max_len);
+        file->free_runs[len].push_back(unit_no);
+        unit_no += len;
+        num_units -= len;
+    }
+}
+
+/**
+ * @description: 读取压缩文件中的一个页面并解压，读取的内容写入offset中
+ * @return {bool} 页面从未写入过时返回false
+ */
+bool DiskManager::read_compressed_page(int fd, CompressedFile *file, page_id_t page_no, char *offset, int num_bytes) {
+    char *buf = codec_buffer();
+    CompressedExtent extent;
+    {
+        // 持有共享锁直到读完，防止页面所在的单元被并发的写操作释放并复用
+        std::shared_lock lock{file->latch};
+        if (page_no >= static_cast<page_id_t>(file->extents.size()) || file->extents[page_no].unit_no == 0) {
+            return false;
+        }
+        extent = file->extents[page_no];
+        off_t offset_in_file = static_cast<off_t>(extent.unit_no) * COMPRESS_UNIT_SIZE;
+        if (pread(fd, buf, extent.num_bytes, offset_in_file) != static_cast<ssize_t>(extent.num_bytes)) {
+            throw InternalError("DiskManager::read_page Error");
+        }
+    }
+    if (extent.num_bytes == PAGE_SIZE) {
+        memcpy(offset, buf, num_bytes);
+        return true;
+    }
+    char *page = num_bytes == PAGE_SIZE ? offset : bounce_buffer();
+    if (page_decompress(buf, extent.num_bytes, page, PAGE_SIZE) != PAGE_SIZE) {
+        throw InternalError("DiskManager::read_page corrupted compressed page");
+    }
+    if (page != offset) {
+        memcpy(offset, page, num_bytes);
+    }
+    return true;
+}
+
+/**
+ * @description: 压缩一个页面并写入压缩文件。压缩后的页面总是写到新分配的单元中，内存中的页面映射随即更新，
+ * 映射文件中的映射项留到sync_file在数据落盘之后再写入；旧的单元放入pending_free，映射项落盘之后才复用。
+ * 这样崩溃后磁盘上的页面映射指向的都是已经落盘、没有被覆盖的单元，页面退回到上次sync_file时的版本
+ */
+void DiskManager::write_compressed_page(int fd, CompressedFile *file, page_id_t page_no, const char *offset,
+                                        int num_bytes) {
+    const char *page = offset;
+    if (num_bytes < PAGE_SIZE) {
+        // 只写页面开头的一部分时，页面其余部分保持不变
+        char *buf = bounce_buffer();
+        if (!read_compressed_page(fd, file, page_no, buf, PAGE_SIZE)) {
+            memset(buf, 0, PAGE_SIZE);
+        }
+        memcpy(buf, offset, num_bytes);
+        page = buf;
+    }
+    char *buf = codec_buffer();
+    int len = page_compress(page, PAGE_SIZE, buf, PAGE_SIZE - 1);
+    const char *data = buf;
+    if (len < 0) {
+        // 压缩后没有变小，保存原始数据
+        len = PAGE_SIZE;
+        data = page;
+    }
+
+    std::unique_lock lock{file->latch};
+    if (page_no >= static_cast<page_id_t>(file->extents.size())) {
+        file->extents.resize(page_no + 1, {0, 0});
+    }
+    CompressedExtent old_extent = file->extents[page_no];
+    CompressedExtent extent = {allocate_units(file, units_of(len)), static_cast<uint32_t>(len)};
+    off_t offset_in_file = static_cast<off_t>(extent.unit_no) * COMPRESS_UNIT_SIZE;
+    if (pwrite(fd, data, len, offset_in_file) != len) {
+        throw InternalError("DiskManager::write_page Error");
+    }
+    file->extents[page_no] = extent;
+    file->dirty_map_pages.push_back(page_no);
+    if (old_extent.unit_no != 0) {
+        file->pending_free.emplace_back(old_extent.unit_no, units_of(old_extent.num_bytes));
+    }
+}
 
 bool DiskManager::is_dir(const std::string &path) {
     struct stat st;
@@ -120,7 +632,7 @@ bool DiskManager::is_file(const std::string &path) {
  * @return {*}
  * @param {string} &path
  */
-void DiskManager::create_file(const std::string &path) {
+void DiskManager::create_file(const std::string &path, bool compressed) {
     // 调用open()函数，使用O_CREAT模式
     // 注意不能重复创建相同文件
     if (is_file(path)) {
@@ -134,6 +646,14 @@ void DiskManager::create_file(const std::string &path) {
     }
 
     close(fd);
+    if (compressed) {
+        // 创建空的页面映射文件，之后打开该文件时按压缩文件处理
+        fd = open((path + COMPRESSED_MAP_SUFFIX).c_str(), flags, mode);
+        if (fd == -1) {
+            throw UnixError();
+        }
+        close(fd);
+    }
 }
 
 /**
@@ -146,7 +666,7 @@ void DiskManager::destroy_file(const std::string &path) {
     if (!is_file(path)) {
         throw FileNotFoundError(path);
     }
-    if (path2fd_.count(path) > 0) {
+    if (find_open_fd(path) != -1) {
         throw FileNotClosedError(path);
     }
     int result = unlink(path.c_str());
@@ -154,6 +674,13 @@ void DiskManager::destroy_file(const std::string &path) {
         // 删除文件失败
         throw std::runtime_error("Failed to destroy file.");
     }
+    // 同时删除该文件的空闲页面表和页面映射文件
+    for (auto &suffix : {FREE_PAGE_FILE_SUFFIX, COMPRESSED_MAP_SUFFIX}) {
+        std::string sidecar_path = path + suffix;
+        if (is_file(sidecar_path)) {
+            unlink(sidecar_path.c_str());
+        }
+    }
 }
 
 /**
@@ -171,17 +698,34 @@ int DiskManager::open_file(const std::string &path) {
         throw FileNotFoundError(path);
     }
     int flags = O_RDWR;
+    bool compressed = is_file(path + COMPRESSED_MAP_SUFFIX);
+    if (direct_io_ && path != LOG_FILE_NAME && !compressed) {
+        // 表和索引文件的页面已经缓存在缓冲池中，绕过page cache避免同一页面在内存中缓存两份
+        flags |= O_DIRECT;
+    }
     int fd = open(path.c_str(), flags);
+    if (fd == -1 && (flags & O_DIRECT) && errno == EINVAL) {
+        // 文件系统不支持O_DIRECT，退化为普通方式打开，读写仍然正确
+        std::cerr << "O_DIRECT is not supported for " << path << ", open it with page cache" << std::endl;
+        fd = open(path.c_str(), O_RDWR);
+    }
     if (fd == -1) {
         std::cout << "Open File Error: " << strerror(errno) << std::endl;
         return fd;
     }
-    if (fd2path_.count(fd)) {
-        // ToDo:不能重复打开相同文件什么意思
-        return -1;
+    {
+        std::scoped_lock lock{files_latch_};
+        if (fd2path_.count(fd)) {
+            // ToDo:不能重复打开相同文件什么意思
+            return -1;
+        }
+        fd2path_.emplace(fd, path);
+        path2fd_.emplace(path, fd);
+    }
+    load_free_pages(fd, path);
+    if (compressed) {
+        open_compressed(fd, path);
     }
-    fd2path_.emplace(fd, path);
-    path2fd_.emplace(path, fd);
     return fd;
 }
 
@@ -191,16 +735,17 @@ int DiskManager::open_file(const std::string &path) {
  */
 void DiskManager::close_file(int fd) {
     // 不能关闭未打开的文件
-    if (fd2path_.count(fd) == 0) {
-        throw FileNotOpenError(fd);
-    }
+    std::string path = get_file_name(fd);
+    save_free_pages(fd, path);
+    close_compressed(fd);
     int result = close(fd);
     if (result == -1) {
         std::cout << "Open File Error: " << strerror(errno) << std::endl;
         throw std::runtime_error("Failed to close file");
     }
     // 更新文件打开列表
-    path2fd_.erase(fd2path_[fd]);
+    std::scoped_lock lock{files_latch_};
+    path2fd_.erase(path);
     fd2path_.erase(fd);
 }
 
@@ -221,6 +766,7 @@ int DiskManager::get_file_size(const std::string &file_name) {
  * @param {int} fd 文件句柄
  */
 std::string DiskManager::get_file_name(int fd) {
+    std::scoped_lock lock{files_latch_};
     if (!fd2path_.count(fd)) {
         throw FileNotOpenError(fd);
     }
@@ -233,10 +779,19 @@ std::string DiskManager::get_file_name(int fd) {
  * @param {string} &file_name 文件名
  */
 int DiskManager::get_file_fd(const std::string &file_name) {
-    if (!path2fd_.count(file_name)) {
-        return open_file(file_name);
-    }
-    return path2fd_[file_name];
+    int fd = find_open_fd(file_name);
+    return fd == -1 ? open_file(file_name) : fd;
+}
+
+/**
+ * @description:  获得已打开的文件的文件句柄，不会打开文件
+ * @return {int} 文件句柄，文件未打开时返回-1
+ * @param {string} &file_name 文件名
+ */
+int DiskManager::find_open_fd(const std::string &file_name) {
+    std::scoped_lock lock{files_latch_};
+    auto it = path2fd_.find(file_name);
+    return it == path2fd_.end() ? -1 : it->second;
 }
 
 /**
@@ -258,8 +813,7 @@ int DiskManager::read_log(char *log_data, int size, int offset) {
 
     size = std::min(size, file_size - offset);
     if (size == 0) return 0;
-    lseek(log_fd_, offset, SEEK_SET);
-    ssize_t bytes_read = read(log_fd_, log_data, size);
+    ssize_t bytes_read = pread(log_fd_, log_data, size, offset);
     assert(bytes_read == size);
     return bytes_read;
 }
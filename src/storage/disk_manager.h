@@ -17,11 +17,15 @@ See the Mulan PSL v2 for more details. */
 #include <atomic>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "common/config.h"
 #include "errors.h"
+#include "storage/async_io.h"
 
 /**
  * @description: DiskManager的作用主要是根据上层的需要对磁盘文件进行操作
@@ -30,15 +34,56 @@ class DiskManager {
    public:
     explicit DiskManager();
 
-    ~DiskManager() = default;
+    ~DiskManager();
 
     void write_page(int fd, page_id_t page_no, const char *offset, int num_bytes);
 
     void read_page(int fd, page_id_t page_no, char *offset, int num_bytes);
 
+    void read_pages(int fd, page_id_t start_page_no, int n, char **bufs);
+
+    void write_pages(int fd, page_id_t start_page_no, int n, char **bufs);
+
+    void sync_file(int fd);
+
+    /**
+     * @description: 设置页面异步I/O使用的后端，需在打开数据库之前调用；io_uring不可用时自动退化为同步实现
+     * @param {IoBackendType} type 期望的后端类型
+     */
+    void set_io_backend(IoBackendType type);
+
+    IoBackendType get_io_backend() const { return io_backend_; }
+
+    /**
+     * @description: 创建一个当前后端的异步I/O队列，用于批量提交页面读写
+     * @param {unsigned} depth 队列深度
+     */
+    std::unique_ptr<AsyncIo> create_async_io(unsigned depth) const { return AsyncIo::create(io_backend_, depth); }
+
+    /**
+     * @description: 设置表和索引文件是否以O_DIRECT方式打开，需在打开数据库之前调用。
+     * 开启后页面不再经过操作系统的page cache，只缓存在缓冲池中；日志文件不受影响
+     * @param {bool} direct_io 是否开启
+     */
+    void set_direct_io(bool direct_io) { direct_io_ = direct_io; }
+
+    bool is_direct_io() const { return direct_io_; }
+
     page_id_t allocate_page(int fd);
 
-    void deallocate_page(page_id_t page_id);
+    /**
+     * @description: 设置文件扩展的粒度，需在打开数据库之前调用
+     * @param {int} extent_size 每次扩展的字节数，会向下取整为PAGE_SIZE的整数倍，0表示不预分配
+     */
+    void set_extent_size(int extent_size) { extent_pages_ = extent_size / PAGE_SIZE; }
+
+    int get_extent_size() const { return extent_pages_ * PAGE_SIZE; }
+
+    page_id_t preallocate_pages(int fd, page_id_t page_no, page_id_t num_allocated_pages);
+
+    void deallocate_page(int fd, page_id_t page_no);
+
+    int get_num_free_pages(int fd);
 
     /*目录操作*/
     bool is_dir(const std::string &path);
@@ -50,7 +95,13 @@ class DiskManager {
     /*文件操作*/
     bool is_file(const std::string &path);
 
-    void create_file(const std::string &path);
+    void create_file(const std::string &path, bool compressed = false);
+
+    /**
+     * @description: 判断文件是否按页压缩存储
+     * @param {int} fd 文件句柄
+     */
+    bool is_compressed(int fd) const { return fd2compressed_[fd] != nullptr; }
 
     void destroy_file(const std::string &path);
 
@@ -64,6 +115,8 @@ class DiskManager {
 
     int get_file_fd(const std::string &file_name);
 
+    int find_open_fd(const std::string &file_name);
+
     /*日志操作*/
     int read_log(char *log_data, int size, int offset);
 
@@ -90,10 +143,61 @@ class DiskManager {
     static constexpr int MAX_FD = 8192;
 
    private:
+    /* 压缩文件中一个页面的存放位置，同时也是页面映射文件中的一项，映射文件中第i项对应第i个页面 */
+    struct CompressedExtent {
+        uint32_t unit_no;    // 起始位置，以COMPRESS_UNIT_SIZE为单位；0表示该页面还未写入过
+        uint32_t num_bytes;  // 压缩后的字节数，等于PAGE_SIZE表示压缩无效、保存的是原始数据
+    };
+
+    /* 一个打开的压缩文件。第0页（文件头）仍按原样存放在文件开头，其余页面压缩后存放在之后的若干个单元中 */
+    struct CompressedFile {
+        int map_fd;                                    // 页面映射文件的句柄
+        std::vector<CompressedExtent> extents;         // 下标为页面号
+        std::vector<std::vector<uint32_t>> free_runs;  // free_runs[k]为长度为k个单元的空闲区间的起始单元号
+        // 已被新版本取代的区间(起始单元号, 单元数)，页面映射在sync_file中落盘之后才放入free_runs
+        std::vector<std::pair<uint32_t, uint32_t>> pending_free;
+        std::vector<page_id_t> dirty_map_pages;  // 映射项已改变、还没有写入映射文件的页面，在sync_file中写入
+        uint32_t end_unit;                       // 文件末尾的单元号
+        std::shared_mutex latch;                 // 读页面加共享锁，写页面加排他锁
+        std::mutex sync_latch;                   // 同一文件的sync_file依次进行，映射项按版本先后写入
+    };
+
     // 文件打开列表，用于记录文件是否被打开
     std::unordered_map<std::string, int> path2fd_;  //<Page文件磁盘路径,Page fd>哈希表
     std::unordered_map<int, std::string> fd2path_;  //<Page fd,Page文件磁盘路径>哈希表
+    std::mutex files_latch_;                        // 保护path2fd_和fd2path_
+
+    IoBackendType io_backend_ = IoBackendType::SYNC;  // 异步页面I/O使用的后端
+    std::atomic<bool> direct_io_{false};              // 表和索引文件是否以O_DIRECT方式打开
+
+    int extent_pages_ = FILE_EXTENT_SIZE / PAGE_SIZE;  // 文件每次扩展的页面个数，0表示不预分配
+    std::atomic<bool> fallocate_supported_{true};     // 文件系统不支持fallocate时置为false，之后不再尝试
 
     int log_fd_ = -1;  // WAL日志文件的文件句柄，默认为-1，代表未打开日志文件
     std::atomic<page_id_t> fd2pageno_[MAX_FD]{};  // 文件中已经分配的页面个数，初始值为0
+
+    // 每个文件中已被释放、可以重新分配的页面号，关闭文件时保存到空闲页面表文件中，打开文件时读回
+    std::unordered_map<int, std::vector<page_id_t>> fd2free_pages_;
+    std::mutex free_pages_latch_;  // 保护fd2free_pages_
+
+    // 压缩文件的状态，非压缩文件为nullptr
+    std::atomic<CompressedFile *> fd2compressed_[MAX_FD]{};
+
+    void load_free_pages(int fd, const std::string &path);
+
+    void open_compressed(int fd, const std::string &path);
+
+    void close_compressed(int fd);
+
+    void sync_compressed(int fd, CompressedFile *file);
+
+    bool read_compressed_page(int fd, CompressedFile *file, page_id_t page_no, char *offset, int num_bytes);
+
+    void write_compressed_page(int fd, CompressedFile *file, page_id_t page_no, const char *offset, int num_bytes);
+
+    static uint32_t allocate_units(CompressedFile *file, uint32_t num_units);
+
+    static void free_units(CompressedFile *file, uint32_t unit_no, uint32_t num_units);
+
+    void save_free_pages(int fd, const std::string &path);
 };
\ No newline at end of file
@@ -0,0 +1,155 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/frame_arena.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#include "errors.h"
+
+namespace {
+
+// <numaif.h>中的内存策略，为了不依赖libnuma直接使用mbind系统调用
+constexpr int MPOL_PREFERRED_MODE = 1;
+constexpr int MPOL_INTERLEAVE_MODE = 3;
+constexpr size_t MAX_NUMA_NODES = 64;
+
+size_t round_up(size_t n, size_t align) { return (n + align - 1) / align * align; }
+
+/* 匿名映射一块只保留地址空间的内存，失败时返回nullptr */
+void *map_anonymous(size_t bytes, int extra_flags) {
+    void *addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return addr == MAP_FAILED ? nullptr : addr;
+}
+
+bool bind_memory(void *addr, size_t bytes, int mode, uint64_t node_mask) {
+    return syscall(SYS_mbind, addr, bytes, mode, &node_mask, MAX_NUMA_NODES + 1, 0) == 0;
+}
+
+}  // namespace
+
+std::string huge_page_name(HugePageType type) {
+    switch (type) {
+        case HugePageType::TRANSPARENT:
+            return "transparent";
+        case HugePageType::EXPLICIT:
+            return "hugetlb";
+        default:
+            return "none";
+    }
+}
+
+NumaPolicy numa_policy_from_name(const std::string &name) {
+    if (name == "NONE") return NumaPolicy::NONE;
+    if (name == "INTERLEAVE") return NumaPolicy::INTERLEAVE;
+    if (name == "SHARD_LOCAL") return NumaPolicy::SHARD_LOCAL;
+    throw InternalError("Unknown numa policy: " + name);
+}
+
+FrameArena::FrameArena(size_t num_frames, size_t metadata_bytes, const FrameArenaConfig &config) {
+    frames_bytes_ = num_frames * PAGE_SIZE;
+    frames_map_ = nullptr;
+    if (config.huge_pages) {
+        // 1 预留的大页需要管理员事先配置，映射时即占用，不能与MAP_NORESERVE同用，否则大页不足时访问会收到SIGBUS
+        frames_map_bytes_ = round_up(frames_bytes_, HUGE_PAGE_SIZE);
+        frames_map_ = map_anonymous(frames_map_bytes_, MAP_HUGETLB);
+        if (frames_map_ != nullptr) {
+            frames_ = static_cast<char *>(frames_map_);
+            huge_page_type_ = HugePageType::EXPLICIT;
+        }
+    }
+    if (frames_map_ == nullptr) {
+        // 2 普通的匿名映射，起始地址对齐到HUGE_PAGE_SIZE，使透明大页能覆盖整个帧数据区
+        size_t align = config.huge_pages ? HUGE_PAGE_SIZE : PAGE_SIZE;
+        frames_map_bytes_ = frames_bytes_ + align;
+        frames_map_ = map_anonymous(frames_map_bytes_, MAP_NORESERVE);
+        if (frames_map_ == nullptr) {
+            throw std::bad_alloc();
+        }
+        frames_ = reinterpret_cast<char *>(round_up(reinterpret_cast<uintptr_t>(frames_map_), align));
+        if (config.huge_pages && madvise(frames_, frames_bytes_, MADV_HUGEPAGE) == 0) {
+            huge_page_type_ = HugePageType::TRANSPARENT;
+        }
+    }
+    metadata_bytes_ = std::max<size_t>(metadata_bytes, 1);
+    metadata_ = map_anonymous(metadata_bytes_, MAP_NORESERVE);
+    if (metadata_ == nullptr) {
+        munmap(frames_map_, frames_map_bytes_);
+        throw std::bad_alloc();
+    }
+}
+
+FrameArena::~FrameArena() {
+    munmap(metadata_, metadata_bytes_);
+    munmap(frames_map_, frames_map_bytes_);
+}
+
+int FrameArena::apply_numa_policy(NumaPolicy policy, const std::vector<std::pair<size_t, size_t>> &partitions) {
+    std::vector<int> nodes = numa_nodes();
+    if (policy == NumaPolicy::NONE || nodes.size() <= 1) {
+        return 0;
+    }
+    bool ok = true;
+    if (policy == NumaPolicy::INTERLEAVE) {
+        uint64_t mask = 0;
+        for (int node : nodes) {
+            mask |= 1ull << node;
+        }
+        ok = bind_memory(frames_, frames_bytes_, MPOL_INTERLEAVE_MODE, mask) &&
+             bind_memory(metadata_, metadata_bytes_, MPOL_INTERLEAVE_MODE, mask);
+    } else {
+        // mbind的范围需要对齐到映射使用的页面大小，分区的边界向下取整，相邻分区交界处的一个页面归后一个分区
+        size_t align = huge_page_type_ == HugePageType::NONE ? PAGE_SIZE : HUGE_PAGE_SIZE;
+        for (size_t i = 0; i < partitions.size() && ok; i++) {
+            size_t begin = partitions[i].first * PAGE_SIZE / align * align;
+            size_t end = i + 1 == partitions.size() ? round_up(frames_bytes_, align)
+                                                    : partitions[i].second * PAGE_SIZE / align * align;
+            if (begin < end) {
+                ok = bind_memory(frames_ + begin, end - begin, MPOL_PREFERRED_MODE, 1ull << nodes[i % nodes.size()]);
+            }
+        }
+    }
+    if (!ok) {
+        // 内核不支持NUMA策略或被seccomp禁止，按默认策略分配
+        std::cerr << "mbind failed, buffer pool frames use the default numa policy" << std::endl;
+        return 0;
+    }
+    return static_cast<int>(nodes.size());
+}
+
+std::vector<int> FrameArena::numa_nodes() {
+    // 格式如"0-1,3"
+    std::vector<int> nodes;
+    std::ifstream file("/sys/devices/system/node/online");
+    std::string ranges;
+    if (!(file >> ranges)) {
+        return nodes;
+    }
+    std::stringstream ss(ranges);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int node = first; node <= last && node < static_cast<int>(MAX_NUMA_NODES); node++) {
+            nodes.push_back(node);
+        }
+    }
+    return nodes;
+}
@@ -0,0 +1,87 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+
+/* 帧数据实际使用的页面类型：普通页面、透明大页（THP）或预留的大页（hugetlbfs） */
+enum class HugePageType { NONE, TRANSPARENT, EXPLICIT };
+
+/* 多路服务器上帧数据的NUMA分配策略：不设置、所有节点交错分配、各分区的帧分别优先分配在一个节点上 */
+enum class NumaPolicy { NONE, INTERLEAVE, SHARD_LOCAL };
+
+std::string huge_page_name(HugePageType type);
+
+NumaPolicy numa_policy_from_name(const std::string &name);
+
+/**
+ * @description: 缓冲池帧内存的分配参数
+ */
+struct FrameArenaConfig {
+    bool huge_pages = BUFFER_POOL_HUGE_PAGES;                                  // 是否尝试用大页存放帧数据
+    NumaPolicy numa_policy = numa_policy_from_name(BUFFER_POOL_NUMA_POLICY);  // 只有一个NUMA节点时不起作用
+};
+
+/**
+ * @description: 缓冲池的帧内存。4KB的帧数据放在一块单独的映射中，尽量使用2MB大页以减少TLB缺失：
+ * 先尝试预留的大页，不可用时使用透明大页，再退化为普通页面；帧的元数据（Page对象）放在另一块普通页面的映射中，
+ * 使固定计数、脏页标记、latch等频繁访问的字段紧密排列，不与页面数据交错。
+ * 除预留的大页外，两块映射都只保留地址空间，物理内存在首次访问时才分配
+ */
+class FrameArena {
+   public:
+    static constexpr size_t HUGE_PAGE_SIZE = 2ul << 20;
+
+    /**
+     * @param {size_t} num_frames 帧的个数
+     * @param {size_t} metadata_bytes 元数据区的大小
+     * @param {FrameArenaConfig&} config 分配参数
+     */
+    FrameArena(size_t num_frames, size_t metadata_bytes, const FrameArenaConfig &config);
+
+    ~FrameArena();
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /** @return 帧数据区，按PAGE_SIZE对齐，使用大页时按HUGE_PAGE_SIZE对齐，第i个帧位于frames()+i*PAGE_SIZE */
+    char *frames() const { return frames_; }
+
+    /** @return 元数据区，按PAGE_SIZE对齐 */
+    void *metadata() const { return metadata_; }
+
+    HugePageType huge_page_type() const { return huge_page_type_; }
+
+    /**
+     * @description: 按NUMA策略设置帧数据区的内存分配节点，需要在帧被首次访问之前调用
+     * @return {int} 使用的NUMA节点个数，没有设置时返回0
+     * @param {NumaPolicy} policy NUMA策略
+     * @param {vector<pair<size_t, size_t>>&} partitions 各分区管理的帧[begin, end)，SHARD_LOCAL时第i个分区分配在第i%n个节点上
+     */
+    int apply_numa_policy(NumaPolicy policy, const std::vector<std::pair<size_t, size_t>> &partitions);
+
+    /** @return 在线的NUMA节点编号 */
+    static std::vector<int> numa_nodes();
+
+   private:
+    void *frames_map_;  // 帧数据区所在的映射，为了对齐可能比帧数据区大
+    size_t frames_map_bytes_;
+    char *frames_;
+    size_t frames_bytes_;
+    void *metadata_;
+    size_t metadata_bytes_;
+    HugePageType huge_page_type_ = HugePageType::NONE;
+};
@@ -10,6 +10,10 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
 #include "common/config.h"
 #include "common/logger.h"
 #include "common/rwlatch.h"
@@ -23,7 +27,7 @@ struct PageId {
 
     friend bool operator==(const PageId &x, const PageId &y) { return x.fd == y.fd && x.page_no == y.page_no; }
     bool operator<(const PageId &x) const {
-        if (fd < x.fd) return true;
+        if (fd != x.fd) return fd < x.fd;
         return page_no < x.page_no;
     }
 
@@ -50,8 +54,18 @@ class Page {
     friend class BufferPoolManager;
 
    public:
-    Page() { reset_memory(); }
-    ~Page() = default;
+    /* 自己申请一块按PAGE_SIZE对齐的内存存放页面数据，用于缓冲池之外的临时页面（如join buffer） */
+    Page() : data_(static_cast<char *>(std::aligned_alloc(PAGE_SIZE, PAGE_SIZE))), owns_data_(true) { reset_memory(); }
+
+    /* 页面数据存放在外部提供的内存中（缓冲池的帧），data需按PAGE_SIZE对齐，由调用者负责释放 */
+    explicit Page(char *data) : data_(data), owns_data_(false) { reset_memory(); }
+
+    ~Page() {
+        if (owns_data_) std::free(data_);
+    }
+
+    Page(const Page &) = delete;
+    Page &operator=(const Page &) = delete;
 
     PageId get_page_id() const { return id_; }
     inline void set_page_id(PageId id) { id_ = id; }
@@ -98,15 +112,27 @@ class Page {
     PageId id_;
 
     /** The actual data that is stored within a page.
-     *  该页面在bufferPool中的偏移地址
+     *  该页面在bufferPool中的偏移地址，按PAGE_SIZE对齐，满足O_DIRECT对内存地址的要求
      */
-    char data_[PAGE_SIZE] = {};
+    char *data_;
+
+    /** data_是否由Page自己申请 */
+    bool owns_data_;
+
+    /** 脏页判断。缓冲池命中时不加锁地固定和取消固定页面，因此脏页标记和固定计数都是原子变量 */
+    std::atomic<bool> is_dirty_ = false;
+
+    /** The pin count of this page. 在缓冲池中为-1表示帧空闲或正在被替换，此时不能被固定 */
+    std::atomic<int> pin_count_ = 0;
+
+    /** 最近是否被访问过，替换时给被访问过的帧第二次机会 */
+    std::atomic<bool> referenced_ = false;
 
-    /** 脏页判断 */
-    bool is_dirty_ = false;
+    /** 由预取读入、还没有被fetch_page访问过，用于统计预取的命中和浪费 */
+    std::atomic<bool> prefetched_ = false;
 
-    /** The pin count of this page. */
-    int pin_count_ = 0;
+    /** 帧正在写回旧页面或读入新页面，此时帧已被占用（pin_count_为-1），请求其中页面的线程需要等待，在分区的latch下访问 */
+    bool io_in_progress_ = false;
 
     ReaderWriterLatch rwlatch_;
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/page_codec.h"
+
+#include <algorithm>
+#include <cstring>
+
+int page_compress(const char *src, int src_len, char *dst, int dst_cap) {
+    int out = 0;
+    int literal_start = 0;  // 当前字面量段的起始位置
+    int i = 0;
+
+    // 把[literal_start, end)作为若干字面量段输出
+    auto flush_literal = [&](int end) {
+        while (literal_start < end) {
+            int len = std::min(end - literal_start, PAGE_CODEC_MAX_LITERAL);
+            if (out + 1 + len > dst_cap) return false;
+            dst[out++] = static_cast<char>(len - 1);
+            memcpy(dst + out, src + literal_start, len);
+            out += len;
+            literal_start += len;
+        }
+        return true;
+    };
+
+    while (i < src_len) {
+        int run = 1;
+        while (i + run < src_len && run < PAGE_CODEC_MAX_RUN && src[i + run] == src[i]) {
+            run++;
+        }
+        if (run < PAGE_CODEC_MIN_RUN) {
+            i += run;
+            continue;
+        }
+        if (!flush_literal(i) || out + 2 > dst_cap) {
+            return -1;
+        }
+        dst[out++] = static_cast<char>(0x80 | (run - PAGE_CODEC_MIN_RUN));
+        dst[out++] = src[i];
+        i += run;
+        literal_start = i;
+    }
+    if (!flush_literal(src_len)) {
+        return -1;
+    }
+    return out;
+}
+
+int page_decompress(const char *src, int src_len, char *dst, int dst_cap) {
+    int out = 0;
+    int i = 0;
+    while (i < src_len) {
+        unsigned char ctrl = static_cast<unsigned char>(src[i++]);
+        if (ctrl & 0x80) {
+            int run = (ctrl & 0x7F) + PAGE_CODEC_MIN_RUN;
+            if (i >= src_len || out + run > dst_cap) return -1;
+            memset(dst + out, src[i++], run);
+            out += run;
+        } else {
+            int len = ctrl + 1;
+            if (i + len > src_len || out + len > dst_cap) return -1;
+            memcpy(dst + out, src + i, len);
+            i += len;
+            out += len;
+        }
+    }
+    return out;
+}
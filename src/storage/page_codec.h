@@ -0,0 +1,42 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+/**
+ * 页面压缩使用的游程编码。定长记录中CHAR字段的填充字节、未使用的slot都是连续的相同字节，用游程编码即可大幅压缩。
+ * 编码后的数据由若干段组成，每段以一个控制字节开头：
+ *   0x00~0x7F：字面量段，之后跟着(控制字节+1)个原样保存的字节
+ *   0x80~0xFF：重复段，之后跟着1个字节，该字节重复(控制字节-0x80+PAGE_CODEC_MIN_RUN)次
+ */
+
+static constexpr int PAGE_CODEC_MIN_RUN = 3;        // 至少连续3个相同字节才编码为重复段
+static constexpr int PAGE_CODEC_MAX_RUN = 130;      // 重复段的最大长度
+static constexpr int PAGE_CODEC_MAX_LITERAL = 128;  // 字面量段的最大长度
+
+/**
+ * @description: 压缩src中的src_len个字节
+ * @return {int} 压缩后的字节数；压缩结果超过dst_cap时返回-1，此时应保存原始数据
+ * @param {char*} src 原始数据
+ * @param {int} src_len 原始数据的长度
+ * @param {char*} dst 压缩结果
+ * @param {int} dst_cap dst的大小
+ */
+int page_compress(const char *src, int src_len, char *dst, int dst_cap);
+
+/**
+ * @description: 解压缩src中的src_len个字节
+ * @return {int} 解压后的字节数；数据损坏或解压结果超过dst_cap时返回-1
+ * @param {char*} src 压缩数据
+ * @param {int} src_len 压缩数据的长度
+ * @param {char*} dst 解压结果
+ * @param {int} dst_cap dst的大小
+ */
+int page_decompress(const char *src, int src_len, char *dst, int dst_cap);
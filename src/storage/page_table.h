@@ -0,0 +1,154 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "common/config.h"
+#include "page.h"
+
+/**
+ * @description: 缓冲池分区的页表，即PageId到帧号的开放寻址哈希表（线性探测，删除时后移补位，不留墓碑）。
+ * 插入和删除由调用者在分区的latch下串行执行；查找不加锁，可以与插入删除并发进行，
+ * 此时可能漏查，也可能查到过期的帧号，调用者需要在固定帧之后核对帧中的PageId，核对失败时加锁重新查找。
+ * 槽位中存放取反后的key，全零的槽位即为空位，槽位数组用calloc申请，大的数组由内核按需分配清零的内存，构造时不需要逐个初始化
+ */
+class PageTable {
+   public:
+    /**
+     * @param {size_t} num_frames 最多同时存放的页面个数，容量取不小于其两倍的2的幂，负载因子不超过0.5
+     */
+    explicit PageTable(size_t num_frames) {
+        capacity_ = 16;
+        while (capacity_ < num_frames * 2) {
+            capacity_ <<= 1;
+        }
+        slots_ = static_cast<Slot *>(std::calloc(capacity_, sizeof(Slot)));
+        if (slots_ == nullptr) {
+            throw std::bad_alloc();
+        }
+    }
+
+    ~PageTable() { std::free(slots_); }
+
+    PageTable(const PageTable &) = delete;
+    PageTable &operator=(const PageTable &) = delete;
+
+    /**
+     * @description: 查找页面所在的帧，不加锁
+     * @return {frame_id_t} 帧号，不存在时返回INVALID_FRAME_ID
+     */
+    frame_id_t find(PageId page_id) const {
+        uint64_t key = pack(page_id);
+        for (size_t i = home(key), n = 0; n < capacity_; i = (i + 1) & (capacity_ - 1), n++) {
+            uint64_t slot_key = slots_[i].key.load(std::memory_order_acquire);
+            if (slot_key == key) {
+                return slots_[i].frame_id.load(std::memory_order_relaxed);
+            }
+            if (slot_key == EMPTY_KEY) {
+                break;
+            }
+        }
+        return INVALID_FRAME_ID;
+    }
+
+    /**
+     * @description: 插入或更新页面所在的帧，调用者需持有分区的latch
+     */
+    void insert(PageId page_id, frame_id_t frame_id) {
+        uint64_t key = pack(page_id);
+        size_t i = home(key);
+        while (true) {
+            uint64_t slot_key = slots_[i].key.load(std::memory_order_relaxed);
+            if (slot_key == key || slot_key == EMPTY_KEY) {
+                // 先写帧号再发布key，并发的查找看到key时帧号已经写好
+                slots_[i].frame_id.store(frame_id, std::memory_order_relaxed);
+                slots_[i].key.store(key, std::memory_order_release);
+                return;
+            }
+            i = (i + 1) & (capacity_ - 1);
+        }
+    }
+
+    /**
+     * @description: 删除页面，之后探测链上的元素向前补位，调用者需持有分区的latch
+     */
+    void erase(PageId page_id) {
+        uint64_t key = pack(page_id);
+        size_t i = home(key);
+        while (true) {
+            uint64_t slot_key = slots_[i].key.load(std::memory_order_relaxed);
+            if (slot_key == EMPTY_KEY) {
+                return;
+            }
+            if (slot_key == key) {
+                break;
+            }
+            i = (i + 1) & (capacity_ - 1);
+        }
+        // i为空出的位置，把之后起始位置不在(i, j]之间的元素移到i
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & (capacity_ - 1);
+            uint64_t slot_key = slots_[j].key.load(std::memory_order_relaxed);
+            if (slot_key == EMPTY_KEY) {
+                break;
+            }
+            size_t h = home(slot_key);
+            bool stays = i < j ? (h > i && h <= j) : (h > i || h <= j);
+            if (!stays) {
+                slots_[i].frame_id.store(slots_[j].frame_id.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                slots_[i].key.store(slot_key, std::memory_order_release);
+                i = j;
+            }
+        }
+        slots_[i].key.store(EMPTY_KEY, std::memory_order_release);
+    }
+
+    /**
+     * @description: 依次对每个页面调用f(PageId, frame_id_t)，调用者需持有分区的latch，f中不能修改页表
+     */
+    template <typename F>
+    void for_each(F &&f) const {
+        for (size_t i = 0; i < capacity_; i++) {
+            uint64_t slot_key = slots_[i].key.load(std::memory_order_relaxed);
+            if (slot_key != EMPTY_KEY) {
+                f(unpack(slot_key), slots_[i].frame_id.load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+   private:
+    struct Slot {
+        std::atomic<uint64_t> key;  // ~pack(PageId)，EMPTY_KEY表示空位
+        std::atomic<frame_id_t> frame_id;
+    };
+
+    // fd和page_no都为-1的PageId不会被插入页表，它取反后的key为0，用来表示空位
+    static constexpr uint64_t EMPTY_KEY = 0;
+
+    static uint64_t pack(PageId page_id) {
+        return ~((static_cast<uint64_t>(static_cast<uint32_t>(page_id.fd)) << 32) | static_cast<uint32_t>(page_id.page_no));
+    }
+
+    static PageId unpack(uint64_t key) {
+        key = ~key;
+        return {.fd = static_cast<int>(key >> 32), .page_no = static_cast<page_id_t>(static_cast<uint32_t>(key))};
+    }
+
+    size_t home(uint64_t key) const { return (key * 0x9E3779B97F4A7C15ull) >> 32 & (capacity_ - 1); }
+
+    size_t capacity_;                // 槽位个数，为2的幂
+    Slot *slots_;
+};
@@ -0,0 +1,87 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#pragma once
+
+#include <algorithm>
+
+#include "buffer_pool_manager.h"
+#include "common/config.h"
+
+/**
+ * @description: 一个顺序访问流的预读。调用者每访问一个页面调用一次access，连续访问相邻页面时认为是顺序访问，
+ * 由缓冲池的预读线程异步读入后面的一个窗口；每开始访问上一次预读的窗口就预读下一个窗口，窗口大小逐次翻倍，
+ * 直到max_window。访问不连续时窗口恢复为最小值。一个流只能由一个线程使用，析构时取消还未执行的预读
+ */
+class ReadaheadStream {
+   public:
+    /**
+     * @param {BufferAccessStrategy*} strategy 预读使用的访问策略，可以为nullptr
+     * @param {int} max_window 窗口的最大页面数，使用环形帧时应不超过环的一半，否则预读的页面在访问前就被复用
+     */
+    ReadaheadStream(BufferPoolManager *bpm, int fd, BufferAccessStrategy *strategy = nullptr,
+                    int max_window = READAHEAD_MAX_PAGES)
+        : bpm_(bpm), fd_(fd), strategy_(strategy), max_window_(std::max(1, max_window)) {}
+
+    ~ReadaheadStream() { bpm_->cancel_readahead(this); }
+
+    ReadaheadStream(const ReadaheadStream &) = delete;
+    ReadaheadStream &operator=(const ReadaheadStream &) = delete;
+
+    /**
+     * @description: 记录对页面page_no的访问，需要时发起下一个窗口的预读
+     * @param {page_id_t} page_no 访问的页面
+     * @param {page_id_t} end_page_no 文件的页面数，不预读此后的页面
+     */
+    void access(page_id_t page_no, page_id_t end_page_no) {
+        if (page_no + 1 == next_page_no_) {
+            return;  // 同一个页面
+        }
+        if (page_no != next_page_no_) {
+            // 第一次访问或不连续的访问，从当前页面开始重新预读
+            window_ = std::min(READAHEAD_MIN_PAGES, max_window_);
+            ahead_end_ = page_no;
+            trigger_page_no_ = page_no;
+        }
+        next_page_no_ = page_no + 1;
+        if (page_no < trigger_page_no_ || ahead_end_ >= end_page_no) {
+            return;
+        }
+        page_id_t start_page_no = std::max(ahead_end_, page_no);
+        int n = std::min<int>(window_, end_page_no - start_page_no);
+        bpm_->submit_readahead({.fd = fd_, .start_page_no = start_page_no, .n = n, .strategy = strategy_, .stream = this});
+        num_windows_++;
+        num_pages_requested_ += n;
+        // 开始访问这个窗口时预读下一个窗口，始终有一个窗口在途
+        trigger_page_no_ = start_page_no;
+        ahead_end_ = start_page_no + n;
+        window_ = std::min(window_ * 2, max_window_);
+    }
+
+    int get_window() const { return window_; }
+
+    size_t get_num_windows() const { return num_windows_; }
+
+    size_t get_num_pages_requested() const { return num_pages_requested_; }
+
+   private:
+    BufferPoolManager *bpm_;
+    int fd_;
+    BufferAccessStrategy *strategy_;
+    int max_window_;
+
+    int window_ = READAHEAD_MIN_PAGES;     // 下一次预读的页面数
+    page_id_t next_page_no_ = INVALID_PAGE_ID;   // 顺序访问时下一个访问的页面
+    page_id_t ahead_end_ = 0;                    // [.., ahead_end_)内的页面已经发起过预读
+    page_id_t trigger_page_no_ = 0;              // 访问到该页面时发起下一个窗口的预读
+    size_t num_windows_ = 0;                     // 发起预读的次数
+    size_t num_pages_requested_ = 0;             // 发起预读的页面个数
+};
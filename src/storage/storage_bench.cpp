@@ -0,0 +1,692 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 存储层的性能测试，输出各场景下的吞吐量
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_fixture.h"
+#include "buffer_pool_manager.h"
+#include "disk_manager.h"
+#include "readahead.h"
+#include "gtest/gtest.h"
+
+class StorageBench : public BenchFixture {
+   public:
+    StorageBench() : BenchFixture("StorageBench_db") {}
+
+    /**
+     * @brief 创建一个包含num_pages个页面的文件，第i个页面的前4个字节为i
+     */
+    int create_bench_file(const std::string &filename, int num_pages) {
+        disk_manager_->create_file(filename);
+        int fd = disk_manager_->open_file(filename);
+        char buf[PAGE_SIZE];
+        for (int i = 0; i < num_pages; i++) {
+            memset(buf, 0, PAGE_SIZE);
+            memcpy(buf, &i, sizeof(int));
+            disk_manager_->write_page(fd, i, buf, PAGE_SIZE);
+        }
+        return fd;
+    }
+};
+
+/**
+ * @brief 多线程随机读写同一个文件：lseek+read/write（需按fd串行化）对比pread/pwrite与preadv/pwritev
+ */
+TEST_F(StorageBench, ConcurrentPageIO) {
+    const int num_pages = 4096;
+    const int ops_per_thread = 4096;
+    const int run_len = 8;  // preadv/pwritev每次处理的连续页面数
+    int fd = create_bench_file("page_io_bench", num_pages);
+
+    enum Mode { LSEEK, POSITIONAL, VECTORED };
+    const char *mode_names[] = {"lseek+read/write", "pread/pwrite", "preadv/pwritev x8"};
+
+    printf("%-20s %8s %12s %12s %10s\n", "mode", "threads", "pages/s", "syscalls", "MB/s");
+    for (int mode : {LSEEK, POSITIONAL, VECTORED}) {
+        for (int num_threads : {1, 2, 4, 8}) {
+            std::mutex fd_latch;  // 旧实现中lseek与read/write之间必须互斥，否则文件偏移量会被其他线程修改
+            std::atomic<long> syscalls{0};
+            std::atomic<long> errors{0};
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int tid = 0; tid < num_threads; tid++) {
+                threads.emplace_back([&, tid]() {
+                    std::mt19937 rng(tid);
+                    std::vector<char> mem(PAGE_SIZE * run_len);
+                    std::vector<char *> bufs(run_len);
+                    for (int i = 0; i < run_len; i++) bufs[i] = mem.data() + i * PAGE_SIZE;
+                    long local_calls = 0;
+                    for (int op = 0; op < ops_per_thread;) {
+                        bool is_write = rng() % 4 == 0;
+                        if (mode == VECTORED) {
+                            page_id_t start_page = rng() % (num_pages - run_len);
+                            if (is_write) {
+                                for (int i = 0; i < run_len; i++) {
+                                    page_id_t page_no = start_page + i;
+                                    memcpy(bufs[i], &page_no, sizeof(int));
+                                }
+                                disk_manager_->write_pages(fd, start_page, run_len, bufs.data());
+                            } else {
+                                disk_manager_->read_pages(fd, start_page, run_len, bufs.data());
+                                for (int i = 0; i < run_len; i++) {
+                                    if (*reinterpret_cast<int *>(bufs[i]) != start_page + i) errors++;
+                                }
+                            }
+                            local_calls++;
+                            op += run_len;
+                            continue;
+                        }
+                        page_id_t page_no = rng() % num_pages;
+                        off_t offset_in_file = static_cast<off_t>(page_no) * PAGE_SIZE;
+                        if (mode == LSEEK) {
+                            std::scoped_lock lock{fd_latch};
+                            lseek(fd, offset_in_file, SEEK_SET);
+                            if (is_write) {
+                                memcpy(bufs[0], &page_no, sizeof(int));
+                                EXPECT_EQ(write(fd, bufs[0], PAGE_SIZE), PAGE_SIZE);
+                            } else {
+                                EXPECT_EQ(read(fd, bufs[0], PAGE_SIZE), PAGE_SIZE);
+                            }
+                            local_calls += 2;
+                        } else {
+                            if (is_write) {
+                                memcpy(bufs[0], &page_no, sizeof(int));
+                                disk_manager_->write_page(fd, page_no, bufs[0], PAGE_SIZE);
+                            } else {
+                                disk_manager_->read_page(fd, page_no, bufs[0], PAGE_SIZE);
+                            }
+                            local_calls++;
+                        }
+                        if (!is_write && *reinterpret_cast<int *>(bufs[0]) != page_no) errors++;
+                        op++;
+                    }
+                    syscalls += local_calls;
+                });
+            }
+            for (auto &t : threads) t.join();
+            double secs = elapsed_seconds(start);
+            long pages = static_cast<long>(num_threads) * ops_per_thread;
+            printf("%-20s %8d %12.0f %12ld %10.1f\n", mode_names[mode], num_threads, pages / secs, syscalls.load(),
+                   pages * PAGE_SIZE / secs / (1 << 20));
+            EXPECT_EQ(errors.load(), 0);
+        }
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 冷缓存顺序扫描：逐页fetch_page对比按批fetch_range（连续页面合并为向量读，sync/io_uring后端）
+ * @note 每轮开始前用posix_fadvise丢弃文件的page cache，尽量模拟冷读
+ */
+TEST_F(StorageBench, BatchedPrefetchScan) {
+    const int num_pages = 16384;
+    const size_t pool_size = 4096;
+    int fd = create_bench_file("prefetch_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    enum Mode { FETCH, PREFETCH_SYNC, PREFETCH_URING };
+    const char *mode_names[] = {"fetch_page", "fetch_range sync", "fetch_range uring"};
+
+    printf("%-20s %12s %10s\n", "mode", "pages/s", "MB/s");
+    for (int mode : {FETCH, PREFETCH_SYNC, PREFETCH_URING}) {
+        disk_manager_->set_io_backend(mode == PREFETCH_URING ? IoBackendType::URING : IoBackendType::SYNC);
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+        fsync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        long errors = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            if (mode != FETCH && page_no % SCAN_PREFETCH_PAGES == 0) {
+                bpm->fetch_range(fd, page_no, std::min(SCAN_PREFETCH_PAGES, num_pages - page_no));
+            }
+            PageId page_id = {.fd = fd, .page_no = page_no};
+            Page *page = bpm->fetch_page(page_id);
+            if (*reinterpret_cast<int *>(page->get_data()) != page_no) errors++;
+            bpm->unpin_page(page_id, false);
+        }
+        double secs = elapsed_seconds(start);
+        printf("%-20s %12.0f %10.1f\n", mode_names[mode], num_pages / secs,
+               static_cast<double>(num_pages) * PAGE_SIZE / secs / (1 << 20));
+        EXPECT_EQ(errors, 0);
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 刷脏页：旧实现按页表的哈希顺序逐页pwrite，对比排序后合并为向量写、每个文件只fsync一次
+ * @note 分别测试全部、一半和十分之一的页面为脏页的情况，吞吐量按写回的脏页计算
+ */
+TEST_F(StorageBench, FlushAllPages) {
+    const int num_pages = 16384;
+    const size_t pool_size = num_pages;
+    int fd = create_bench_file("flush_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+    bpm->fetch_range(fd, 0, num_pages);
+
+    // 把每隔step个页面中的一个标记为脏页，返回脏页个数
+    auto dirty_pages = [&](int step) {
+        int num_dirty = 0;
+        for (int page_no = 0; page_no < num_pages; page_no += step) {
+            PageId page_id = {.fd = fd, .page_no = page_no};
+            bpm->fetch_page(page_id);
+            bpm->unpin_page(page_id, true);
+            num_dirty++;
+        }
+        return num_dirty;
+    };
+
+    printf("%-24s %8s %12s %10s\n", "mode", "dirty", "pages/s", "MB/s");
+    for (int step : {1, 2, 10}) {
+        // 旧实现：无论是否为脏页，按哈希顺序逐页写回所有页面
+        std::vector<page_id_t> order(num_pages);
+        for (int i = 0; i < num_pages; i++) order[i] = i;
+        std::shuffle(order.begin(), order.end(), std::mt19937(step));
+        int num_dirty = dirty_pages(step);
+        auto start = std::chrono::steady_clock::now();
+        for (auto page_no : order) {
+            PageId page_id = {.fd = fd, .page_no = page_no};
+            Page *page = bpm->fetch_page(page_id);
+            disk_manager_->write_page(fd, page_no, page->get_data(), PAGE_SIZE);
+            bpm->unpin_page(page_id, false);
+        }
+        disk_manager_->sync_file(fd);
+        double secs = elapsed_seconds(start);
+        printf("%-24s %7d%% %12.0f %10.1f\n", "per-page hash order", 100 / step, num_dirty / secs,
+               static_cast<double>(num_dirty) * PAGE_SIZE / secs / (1 << 20));
+        bpm->flush_all_pages(fd);
+
+        num_dirty = dirty_pages(step);
+        start = std::chrono::steady_clock::now();
+        bpm->flush_all_pages(fd);
+        secs = elapsed_seconds(start);
+        printf("%-24s %7d%% %12.0f %10.1f\n", "sorted+coalesced", 100 / step, num_dirty / secs,
+               static_cast<double>(num_dirty) * PAGE_SIZE / secs / (1 << 20));
+    }
+    bpm->delete_all_pages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 缓冲池命中路径的多线程扩展性：工作集全部在缓冲池中，各线程随机fetch_page/unpin_page，
+ * 对比不分区（一个全局latch）与按PageId哈希分区
+ */
+TEST_F(StorageBench, ShardedHitPath) {
+    const int num_pages = 16384;
+    const size_t pool_size = num_pages;
+    const int ops_per_thread = 200000;
+    int fd = create_bench_file("hit_path_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    printf("%-12s %8s %14s %10s\n", "shards", "threads", "ops/s", "speedup");
+    for (size_t num_shards : {static_cast<size_t>(1), static_cast<size_t>(BUFFER_POOL_SHARDS)}) {
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get(), nullptr, num_shards);
+        bpm->fetch_range(fd, 0, num_pages);
+        double base = 0;
+        for (int num_threads : {1, 2, 4, 8, 16, 32}) {
+            std::atomic<long> errors{0};
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int tid = 0; tid < num_threads; tid++) {
+                threads.emplace_back([&, tid]() {
+                    std::mt19937 rng(tid);
+                    for (int op = 0; op < ops_per_thread; op++) {
+                        PageId page_id = {.fd = fd, .page_no = static_cast<page_id_t>(rng() % num_pages)};
+                        Page *page = bpm->fetch_page(page_id);
+                        if (page == nullptr || *reinterpret_cast<int *>(page->get_data()) != page_id.page_no) {
+                            errors++;
+                        }
+                        bpm->unpin_page(page_id, false);
+                    }
+                });
+            }
+            for (auto &t : threads) t.join();
+            double ops = static_cast<double>(num_threads) * ops_per_thread / elapsed_seconds(start);
+            if (num_threads == 1) base = ops;
+            printf("%-12zu %8d %14.0f %9.2fx\n", bpm->get_num_shards(), num_threads, ops, ops / base);
+            EXPECT_EQ(errors.load(), 0);
+        }
+        bpm->delete_all_pages(fd);
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief fetch_page/unpin_page成对调用的开销，工作集全部在缓冲池中，命中时不加锁
+ */
+TEST_F(StorageBench, CachedFetchUnpin) {
+    const int num_pages = 4096;
+    const int ops_per_thread = 1000000;
+    int fd = create_bench_file("cached_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+    auto bpm = std::make_unique<BufferPoolManager>(num_pages, disk_manager_.get());
+    bpm->fetch_range(fd, 0, num_pages);
+
+    printf("%-8s %14s %12s\n", "threads", "pairs/s", "ns/pair");
+    for (int num_threads : {1, 4, 16}) {
+        std::atomic<long> errors{0};
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int tid = 0; tid < num_threads; tid++) {
+            threads.emplace_back([&, tid]() {
+                page_id_t page_no = tid;
+                for (int op = 0; op < ops_per_thread; op++) {
+                    page_no = (page_no + 7) % num_pages;
+                    PageId page_id = {.fd = fd, .page_no = page_no};
+                    Page *page = bpm->fetch_page(page_id);
+                    if (page == nullptr || !bpm->unpin_page(page_id, false)) errors++;
+                }
+            });
+        }
+        for (auto &t : threads) t.join();
+        double secs = elapsed_seconds(start);
+        double pairs = static_cast<double>(num_threads) * ops_per_thread;
+        printf("%-8d %14.0f %12.1f\n", num_threads, pairs / secs, secs * 1e9 / pairs * num_threads);
+        EXPECT_EQ(errors.load(), 0);
+    }
+    bpm->delete_all_pages(fd);
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 点查询与大范围扫描交替进行时各置换策略下点查询的命中率。点查询集中在少量热点页面上，
+ *        每轮点查询之后顺序扫描一遍远大于缓冲池的其余页面
+ */
+TEST_F(StorageBench, ScanResistantReplacer) {
+    const int pool_size = 1024;
+    const int num_hot_pages = 512;
+    const int num_pages = 16 * pool_size;
+    const int num_rounds = 10;
+    const int lookups_per_round = 2000;
+    int fd = create_bench_file("replacer_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    printf("%-8s %12s %12s\n", "replacer", "hit ratio", "secs");
+    for (const std::string replacer_type : {"LRU", "LRU-K", "2Q", "CLOCK"}) {
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+        bpm->set_replacer(replacer_type);
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<page_id_t> hot_dist(0, num_hot_pages - 1);
+        size_t lookups = 0;
+        size_t lookup_misses = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < num_rounds; round++) {
+            size_t misses_before = bpm->get_num_fetch_misses();
+            for (int i = 0; i < lookups_per_round; i++) {
+                PageId page_id = {.fd = fd, .page_no = hot_dist(rng)};
+                ASSERT_NE(bpm->fetch_page(page_id), nullptr);
+                bpm->unpin_page(page_id, false);
+            }
+            // 第一轮的未命中是热点页面的首次装入，不计入命中率
+            if (round > 0) {
+                lookups += lookups_per_round;
+                lookup_misses += bpm->get_num_fetch_misses() - misses_before;
+            }
+            for (page_id_t page_no = num_hot_pages; page_no < num_pages; page_no++) {
+                PageId page_id = {.fd = fd, .page_no = page_no};
+                ASSERT_NE(bpm->fetch_page(page_id), nullptr);
+                bpm->unpin_page(page_id, false);
+            }
+        }
+        double hit_ratio = 1 - static_cast<double>(lookup_misses) / lookups;
+        printf("%-8s %12.4f %12.3f\n", replacer_type.c_str(), hit_ratio, elapsed_seconds(start));
+        if (replacer_type == "LRU-K" || replacer_type == "2Q") {
+            EXPECT_GT(hit_ratio, 0.99);
+        }
+        bpm->delete_all_pages(fd);
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 各置换策略的维护开销：帧在固定与取消固定之间切换、记录访问，以及按淘汰顺序取出victim
+ */
+TEST_F(StorageBench, ReplacerOps) {
+    const size_t num_frames = 16384;
+    const int num_ops = 1000000;
+    std::mt19937 rng(42);
+    std::vector<frame_id_t> frames(num_ops);
+    for (auto &frame_id : frames) {
+        frame_id = static_cast<frame_id_t>(rng() % num_frames);
+    }
+
+    printf("%-8s %16s %16s %16s\n", "replacer", "ns/pin+unpin", "ns/access", "ns/victim");
+    for (const std::string replacer_type : {"LRU", "LRU-K", "2Q", "CLOCK"}) {
+        auto replacer = BufferPoolManager::create_replacer(replacer_type, num_frames);
+        for (size_t i = 0; i < num_frames; i++) {
+            replacer->unpin(static_cast<frame_id_t>(i));
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (auto frame_id : frames) {
+            replacer->pin(frame_id);
+            replacer->unpin(frame_id);
+        }
+        double pin_ns = elapsed_seconds(start) * 1e9 / num_ops;
+        start = std::chrono::steady_clock::now();
+        for (auto frame_id : frames) {
+            replacer->access(frame_id);
+        }
+        double access_ns = elapsed_seconds(start) * 1e9 / num_ops;
+        start = std::chrono::steady_clock::now();
+        frame_id_t victim_id;
+        for (int i = 0; i < num_ops; i++) {
+            ASSERT_TRUE(replacer->victim(&victim_id));
+            replacer->unpin(victim_id);
+        }
+        double victim_ns = elapsed_seconds(start) * 1e9 / num_ops;
+        printf("%-8s %16.1f %16.1f %16.1f\n", replacer_type.c_str(), pin_ns, access_ns, victim_ns);
+    }
+}
+
+/**
+ * @brief 点查询与大范围扫描交替进行时，扫描使用环形帧与否对点查询命中率的影响，置换策略为LRU
+ */
+TEST_F(StorageBench, ScanRingStrategy) {
+    const int pool_size = 1024;
+    const int num_hot_pages = 512;
+    const int num_pages = 16 * pool_size;
+    const int num_rounds = 10;
+    const int lookups_per_round = 2000;
+    int fd = create_bench_file("ring_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    printf("%-8s %12s %12s\n", "ring", "hit ratio", "secs");
+    for (bool use_ring : {false, true}) {
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<page_id_t> hot_dist(0, num_hot_pages - 1);
+        size_t lookups = 0;
+        size_t lookup_misses = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < num_rounds; round++) {
+            size_t misses_before = bpm->get_num_fetch_misses();
+            for (int i = 0; i < lookups_per_round; i++) {
+                PageId page_id = {.fd = fd, .page_no = hot_dist(rng)};
+                ASSERT_NE(bpm->fetch_page(page_id), nullptr);
+                bpm->unpin_page(page_id, false);
+            }
+            if (round > 0) {
+                lookups += lookups_per_round;
+                lookup_misses += bpm->get_num_fetch_misses() - misses_before;
+            }
+            auto strategy = use_ring ? bpm->create_scan_strategy(num_pages) : nullptr;
+            for (page_id_t page_no = num_hot_pages; page_no < num_pages; page_no++) {
+                if (page_no % SCAN_PREFETCH_PAGES == 0) {
+                    bpm->fetch_range(fd, page_no, SCAN_PREFETCH_PAGES, strategy.get());
+                }
+                PageId page_id = {.fd = fd, .page_no = page_no};
+                ASSERT_NE(bpm->fetch_page(page_id, strategy.get()), nullptr);
+                bpm->unpin_page(page_id, false);
+            }
+        }
+        double hit_ratio = 1 - static_cast<double>(lookup_misses) / lookups;
+        printf("%-8s %12.4f %12.3f\n", use_ring ? "on" : "off", hit_ratio, elapsed_seconds(start));
+        if (use_ring) {
+            EXPECT_GT(hit_ratio, 0.99);
+        }
+        bpm->delete_all_pages(fd);
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 冷缓存顺序扫描，每页附加少量计算模拟记录处理：逐页fetch_page、在扫描线程中同步fetch_range，
+ * 对比后台线程异步预读（窗口从READAHEAD_MIN_PAGES翻倍到READAHEAD_MAX_PAGES），同时输出预读命中和浪费的页数
+ * @note 每轮开始前用posix_fadvise丢弃文件的page cache，尽量模拟冷读
+ */
+TEST_F(StorageBench, ReadaheadScan) {
+    const int num_pages = 16384;
+    const size_t pool_size = 4096;
+    const int work_per_page = 2000;
+    int fd = create_bench_file("readahead_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    enum Mode { FETCH, PREFETCH_SYNC, READAHEAD };
+    const char *mode_names[] = {"fetch_page", "fetch_range sync", "readahead"};
+
+    printf("%-20s %12s %12s %12s %12s\n", "mode", "pages/s", "misses", "prefetch hit", "wasted");
+    for (int mode : {FETCH, PREFETCH_SYNC, READAHEAD}) {
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+        fsync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        long errors = 0;
+        volatile uint64_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        {
+            ReadaheadStream stream(bpm.get(), fd);
+            for (int page_no = 0; page_no < num_pages; page_no++) {
+                if (mode == PREFETCH_SYNC && page_no % SCAN_PREFETCH_PAGES == 0) {
+                    bpm->fetch_range(fd, page_no, std::min(SCAN_PREFETCH_PAGES, num_pages - page_no));
+                } else if (mode == READAHEAD) {
+                    stream.access(page_no, num_pages);
+                }
+                PageId page_id = {.fd = fd, .page_no = page_no};
+                Page *page = bpm->fetch_page(page_id);
+                if (*reinterpret_cast<int *>(page->get_data()) != page_no) errors++;
+                uint64_t h = 0;
+                for (int i = 0; i < work_per_page; i++) {
+                    h = h * 31 + static_cast<unsigned char>(page->get_data()[i % PAGE_SIZE]);
+                }
+                sink = sink + h;
+                bpm->unpin_page(page_id, false);
+            }
+        }
+        double secs = elapsed_seconds(start);
+        printf("%-20s %12.0f %12zu %12zu %12zu\n", mode_names[mode], num_pages / secs, bpm->get_num_fetch_misses(),
+               bpm->get_num_prefetch_hits(), bpm->get_num_prefetch_wasted());
+        EXPECT_EQ(errors, 0);
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 缓冲池的创建时间和常驻内存：帧在首次使用时才分配，两者应随用到的帧数增长，与缓冲池的大小基本无关
+ * @note 依次创建1GB、4GB（BUFFER_POOL_BYTES）的缓冲池，读入num_pages个页面前后各统计一次
+ */
+TEST_F(StorageBench, PoolStartup) {
+    auto resident_mb = []() {
+        long size = 0;
+        long resident = 0;
+        FILE *statm = fopen("/proc/self/statm", "r");
+        if (statm == nullptr) {
+            return 0.0;
+        }
+        if (fscanf(statm, "%ld %ld", &size, &resident) != 2) {
+            resident = 0;
+        }
+        fclose(statm);
+        return static_cast<double>(resident) * sysconf(_SC_PAGESIZE) / (1 << 20);
+    };
+    const int num_pages = 16384;
+    int fd = create_bench_file("startup_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    printf("%-10s %12s %14s %14s\n", "pool", "create ms", "RSS after MB", "RSS used MB");
+    for (size_t pool_bytes : {1ul << 30, BUFFER_POOL_BYTES}) {
+        double resident_before = resident_mb();
+        auto start = std::chrono::steady_clock::now();
+        auto bpm = std::make_unique<BufferPoolManager>(pool_bytes / PAGE_SIZE, disk_manager_.get(), nullptr,
+                                                       BUFFER_POOL_SHARDS);
+        double create_ms = elapsed_seconds(start) * 1000;
+        double resident_created = resident_mb() - resident_before;
+        ASSERT_EQ(num_pages, bpm->fetch_range(fd, 0, num_pages));
+        double resident_used = resident_mb() - resident_before;
+        printf("%-10s %12.2f %14.1f %14.1f\n", (std::to_string(pool_bytes >> 30) + "GB").c_str(), create_ms,
+               resident_created, resident_used);
+        bpm->delete_all_pages(fd);
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 随机访问已装入缓冲池的页面，每次读页面中随机位置的一个字节：对比帧数据使用普通页面和2MB大页，
+ * 缓冲池远大于TLB能覆盖的范围时大页可以减少TLB缺失
+ */
+TEST_F(StorageBench, HugePageFrames) {
+    const size_t pool_size = (256ul << 20) / PAGE_SIZE;
+    const int num_ops = 4000000;
+    const std::string filename = "huge_page_bench";
+    disk_manager_->create_file(filename);
+    int fd = disk_manager_->open_file(filename);
+
+    printf("%-14s %12s %12s\n", "huge pages", "ns/op", "checksum");
+    for (bool huge_pages : {false, true}) {
+        disk_manager_->set_fd2pageno(fd, 0);
+        FrameArenaConfig config{.huge_pages = huge_pages, .numa_policy = NumaPolicy::NONE};
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get(), nullptr, BUFFER_POOL_SHARDS,
+                                                       config);
+        std::vector<PageId> page_ids;
+        for (size_t i = 0; i < pool_size; i++) {
+            PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            Page *page = bpm->new_page(&page_id);
+            ASSERT_NE(page, nullptr);
+            memset(page->get_data(), static_cast<int>(i), PAGE_SIZE);
+            bpm->unpin_page(page_id, false);
+            page_ids.push_back(page_id);
+        }
+        std::mt19937 rng(42);
+        uint64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_ops; i++) {
+            uint32_t r = rng();
+            PageId page_id = page_ids[r % pool_size];
+            Page *page = bpm->fetch_page(page_id);
+            checksum += static_cast<unsigned char>(page->get_data()[(r >> 8) % PAGE_SIZE]);
+            bpm->unpin_page(page_id, false);
+        }
+        double secs = elapsed_seconds(start);
+        printf("%-14s %12.1f %12lu\n", huge_page_name(bpm->get_huge_page_type()).c_str(), secs * 1e9 / num_ops,
+               checksum);
+        bpm->delete_all_pages(fd);
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 冷缓存随机读：多个线程在同一个分区中并发地读取缺失的页面。读写磁盘时不持有分区的latch，
+ * 缺失的页面可以并行读取，吞吐量随线程数增长；脏页的写回与其他线程的读取也互不阻塞
+ * @note 每轮开始前用posix_fadvise丢弃文件的page cache，尽量模拟冷读
+ */
+TEST_F(StorageBench, ConcurrentMisses) {
+    const int num_pages = 16384;
+    const size_t pool_size = 1024;
+    const int reads_per_thread = 2000;
+    int fd = create_bench_file("miss_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    printf("%-10s %12s %12s\n", "threads", "pages/s", "misses");
+    for (int num_threads : {1, 4, 16}) {
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+        fsync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        std::atomic<long> errors = 0;
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                std::mt19937 rng(t);
+                std::uniform_int_distribution<page_id_t> dist(0, num_pages - 1);
+                for (int i = 0; i < reads_per_thread; i++) {
+                    PageId page_id = {.fd = fd, .page_no = dist(rng)};
+                    Page *page = bpm->fetch_page(page_id);
+                    if (page == nullptr || *reinterpret_cast<int *>(page->get_data()) != page_id.page_no) {
+                        errors++;
+                    }
+                    if (page != nullptr) {
+                        // 一部分页面被修改，替换时需要写回
+                        bpm->unpin_page(page_id, i % 4 == 0);
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        double secs = elapsed_seconds(start);
+        printf("%-10d %12.0f %12zu\n", num_threads, num_threads * reads_per_thread / secs,
+               bpm->get_num_fetch_misses());
+        EXPECT_EQ(errors, 0);
+        bpm->flush_all_pages(fd);
+    }
+    disk_manager_->close_file(fd);
+}
+
+/**
+ * @brief 重启后的缓冲池预热：工作集为随机分布的一批热页面，对比重启后直接开始查询（逐个缺失读入）和
+ * 先按保存的热页面列表用合并后的顺序读预热，再开始查询
+ * @note 每轮开始前用posix_fadvise丢弃文件的page cache，尽量模拟冷读
+ */
+TEST_F(StorageBench, WarmRestart) {
+    const int num_pages = 32768;
+    const size_t pool_size = 4096;
+    const int num_hot_pages = 3072;
+    const int num_lookups = 20000;
+    const std::string hot_file = "warm_restart_bench.hot";
+    int fd = create_bench_file("warm_restart_bench", num_pages);
+    disk_manager_->set_fd2pageno(fd, num_pages);
+
+    // 热页面集中在文件的前一半，页面号之间有间隔
+    std::mt19937 rng(42);
+    std::vector<page_id_t> hot_pages;
+    for (page_id_t page_no = 0; page_no < num_pages / 2; page_no++) {
+        if (static_cast<int>(rng() % (num_pages / 2)) < num_hot_pages) {
+            hot_pages.push_back(page_no);
+        }
+    }
+    {
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+        for (auto page_no : hot_pages) {
+            PageId page_id = {.fd = fd, .page_no = page_no};
+            ASSERT_NE(bpm->fetch_page(page_id), nullptr);
+            bpm->unpin_page(page_id, false);
+        }
+        bpm->save_hot_pages(hot_file);
+    }
+
+    printf("%-10s %12s %12s %12s\n", "warm up", "warm up ms", "query ms", "misses");
+    for (bool warm_up : {false, true}) {
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+        fsync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        auto start = std::chrono::steady_clock::now();
+        if (warm_up) {
+            size_t num_requested = bpm->load_hot_pages(hot_file);
+            while (bpm->get_num_prefetched() < num_requested) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        double warm_up_ms = elapsed_seconds(start) * 1000;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_lookups; i++) {
+            PageId page_id = {.fd = fd, .page_no = hot_pages[rng() % hot_pages.size()]};
+            ASSERT_NE(bpm->fetch_page(page_id), nullptr);
+            bpm->unpin_page(page_id, false);
+        }
+        printf("%-10s %12.1f %12.1f %12zu\n", warm_up ? "on" : "off", warm_up_ms,
+               elapsed_seconds(start) * 1000, bpm->get_num_fetch_misses());
+    }
+    disk_manager_->close_file(fd);
+}
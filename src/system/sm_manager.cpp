@@ -101,16 +101,23 @@ void SmManager::open_db(const std::string& db_name) {
     for (auto& entry : db_.tabs_) {
         auto& tab = entry.second;
         // fhs_[tab.name] = rm_manager_->open_file(tab.name);
-        fhs_.emplace(tab.name, rm_manager_->open_file(tab.name));
-        for (size_t i = 0; i < tab.cols.size(); i++) {
-            auto& col = tab.cols[i];
+        auto file_handle = rm_manager_->open_file(tab.name);
+        // 有VARCHAR字段的表，数据文件必须按变长记录存放，否则是在不支持VARCHAR的版本中建立的文件
+        int num_var_cols =
+            std::count_if(tab.cols.begin(), tab.cols.end(), [](const ColMeta& col) { return col.varlen; });
+        if (num_var_cols != file_handle->get_file_hdr().num_var_cols) {
+            rm_manager_->close_file(file_handle.get());
+            throw FileFormatError(tab.name);
         }
+        fhs_.emplace(tab.name, std::move(file_handle));
         for (auto& index : tab.indexes) {
             auto index_handle = ix_manager_->open_index(tab.name, index.cols);
             auto index_name = ix_manager_->get_index_name(tab.name, index.cols);
             ihs_.emplace(index_name, std::move(index_handle));
         }
     }
+    // 按上次保存的热页面列表在后台预热缓冲池
+    bpm_->load_hot_pages(HOT_PAGE_FILE_NAME);
 }
 
 /**
@@ -128,6 +135,8 @@ void SmManager::flush_meta() {
 void SmManager::close_db() {
     // 刷盘子
     flush_meta();
+    // 文件关闭之前保存缓冲池的热页面列表，下次打开数据库时预读
+    bpm_->save_hot_pages(HOT_PAGE_FILE_NAME);
     // 清理db_
     db_.name_.clear();
     db_.tabs_.clear();
@@ -187,7 +196,8 @@ void SmManager::desc_table(const std::string& tab_name, Context* context) {
     printer.print_separator(context);
     // Print fields
     for (auto& col : tab.cols) {
-        std::vector<std::string> field_info = {col.name, coltype2str(col.type), col.index ? "YES" : "NO"};
+        std::vector<std::string> field_info = {col.name, col.varlen ? "VARCHAR" : coltype2str(col.type),
+                                               col.index ? "YES" : "NO"};
         printer.print_record(field_info, context);
     }
     // Print footer
@@ -199,8 +209,10 @@ void SmManager::desc_table(const std::string& tab_name, Context* context) {
  * @param {string&} tab_name 表的名称
  * @param {vector<ColDef>&} col_defs 表的字段
  * @param {Context*} context
+ * @param {bool} compressed 表的页面是否压缩存储
  */
-void SmManager::create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context) {
+void SmManager::create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context,
+                             bool compressed) {
     if (db_.is_table(tab_name)) {
         throw TableExistsError(tab_name);
     }
@@ -208,19 +220,24 @@ void SmManager::create_table(const std::string& tab_name, const std::vector<ColD
     int curr_offset = 0;
     TabMeta tab;
     tab.name = tab_name;
+    std::vector<RmVarCol> var_cols;  // VARCHAR字段，表数据文件据此按变长记录存放
     for (auto& col_def : col_defs) {
         ColMeta col = {.tab_name = tab_name,
                        .name = col_def.name,
                        .type = col_def.type,
                        .len = col_def.len,
                        .offset = curr_offset,
-                       .index = false};
+                       .index = false,
+                       .varlen = col_def.varlen};
+        if (col_def.varlen) {
+            var_cols.push_back({.offset = curr_offset, .len = col_def.len});
+        }
         curr_offset += col_def.len;
         tab.cols.push_back(col);
     }
     // Create & open record file
     int record_size = curr_offset;  // record_size就是col meta所占的大小（表的元数据也是以记录的形式进行存储的）
-    rm_manager_->create_file(tab_name, record_size);
+    rm_manager_->create_file(tab_name, record_size, compressed, var_cols);
     db_.tabs_[tab_name] = tab;
     // fhs_[tab_name] = rm_manager_->open_file(tab_name);
     fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
@@ -289,18 +306,20 @@ void SmManager::create_index(const std::string& tab_name, const std::vector<std:
 
     auto index_handle = ix_manager_->open_index(tab_name, index_cols);
     auto file_handle = fhs_.at(tab_name).get();
-    for (RmScan scanner(file_handle); !scanner.is_end(); scanner.next()) {
-        auto rec = file_handle->get_record(scanner.rid(), context);
-        // 以下逻辑参考自
-        char* key = new char[total_len];
-        int offset = 0;
-        for (auto col : index_cols) {
-            memcpy(key + offset, rec->data + col.offset, col.len);
-            offset += col.len;
+    // 每个页面只固定一次，直接从页面中的记录构造key
+    char* key = new char[total_len];
+    for (RmBatchScan scanner(file_handle); !scanner.is_end(); scanner.next_page()) {
+        for (size_t i = 0; i < scanner.size(); i++) {
+            const char* rec = scanner.record(i);
+            int offset = 0;
+            for (auto& col : index_cols) {
+                memcpy(key + offset, rec + col.offset, col.len);
+                offset += col.len;
+            }
+            index_handle->insert_entry(key, scanner.rid(i), context->txn_);
         }
-        index_handle->insert_entry(key, scanner.rid(), context->txn_);
-        delete[] key;
     }
+    delete[] key;
 
     auto index_name = ix_manager_->get_index_name(tab_name, index_cols);
     assert(ihs_.count(index_name) == 0);
@@ -505,10 +524,14 @@ void SmManager::reset_db() {
         fhs_.erase(tab_name);
 
         int curr_offset = 0;
+        std::vector<RmVarCol> var_cols;
         for (auto& col : tab_meta.cols) {
+            if (col.varlen) {
+                var_cols.push_back({.offset = col.offset, .len = col.len});
+            }
             curr_offset += col.len;
         }
-        rm_manager_->create_file(tab_name, curr_offset);
+        rm_manager_->create_file(tab_name, curr_offset, false, var_cols);
         fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
         for (auto& index : tab_meta.indexes) {
             ix_manager_->create_index(tab_name, index.cols);
@@ -22,6 +22,7 @@ struct ColDef {
     std::string name;  // Column name
     ColType type;      // Type of column
     int len;           // Length of column
+    bool varlen = false;  // 是否为VARCHAR，与CHAR的区别只在于存储时去掉末尾的填充
 };
 
 /* 系统管理器，负责元数据管理和DDL语句的执行 */
@@ -69,7 +70,8 @@ class SmManager {
 
     void desc_table(const std::string& tab_name, Context* context);
 
-    void create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context);
+    void create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context,
+                      bool compressed = false);
 
     void drop_table(const std::string& tab_name, Context* context);
 
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -27,15 +28,21 @@ struct ColMeta {
     int len;               // 字段长度
     int offset;            // 字段位于记录中的偏移量
     bool index;            /** unused */
+    bool varlen = false;   // 是否为VARCHAR，类型仍为TYPE_STRING，只影响表数据文件中的存储格式
 
     friend std::ostream &operator<<(std::ostream &os, const ColMeta &col) {
         // ColMeta中有各个基本类型的变量，然后调用重载的这些变量的操作符<<（具体实现逻辑在defs.h）
         return os << col.tab_name << ' ' << col.name << ' ' << col.type << ' ' << col.len << ' ' << col.offset << ' '
-                  << col.index;
+                  << col.index << ' ' << col.varlen;
     }
 
     friend std::istream &operator>>(std::istream &is, ColMeta &col) {
-        return is >> col.tab_name >> col.name >> col.type >> col.len >> col.offset >> col.index;
+        is >> col.tab_name >> col.name >> col.type >> col.len >> col.offset >> col.index;
+        // varlen是后来加在行尾的，旧版本的元数据文件中没有，读作false
+        std::string rest;
+        std::getline(is, rest);
+        std::istringstream(rest) >> col.varlen;
+        return is;
     }
 };
 
@@ -0,0 +1,126 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 使用performance_test中的csv数据测试LOAD DATA的性能，输出吞吐量，不作为正确性测试的计分项
+ * csv数据量很小，测试时把order_line.csv重复SCALE次生成一个较大的csv文件
+ */
+
+#include <linux/fiemap.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "execution/execution_manager.h"
+#include "gtest/gtest.h"
+
+const std::string BENCH_DB_NAME = "LoadBench_db";
+const std::string ORDER_LINE_CSV = std::string(TABLE_DATA_DIR) + "/order_line.csv";
+constexpr int SCALE = 50;                // order_line.csv重复的次数
+constexpr size_t BENCH_POOL_SIZE = 4096;  // 16MB的缓冲池，导入过程中会不断写回新页面
+
+class LoadBench : public ::testing::Test {
+   public:
+    std::string csv_path_;
+
+    void SetUp() override {
+        ::testing::Test::SetUp();
+        // 生成放大后的csv文件
+        csv_path_ = "order_line_x" + std::to_string(SCALE) + ".csv";
+        std::ifstream in(ORDER_LINE_CSV);
+        ASSERT_TRUE(in.good()) << ORDER_LINE_CSV;
+        std::string header, line;
+        std::vector<std::string> rows;
+        getline(in, header);
+        while (getline(in, line)) {
+            if (!line.empty()) rows.push_back(line);
+        }
+        std::ofstream out(csv_path_);
+        out << header << "\n";
+        for (int i = 0; i < SCALE; i++) {
+            for (auto &row : rows) out << row << "\n";
+        }
+    }
+
+    void TearDown() override { unlink(csv_path_.c_str()); }
+
+    /**
+     * @brief 通过FIEMAP获得文件在磁盘上的extent个数，文件系统不支持时返回-1
+     */
+    static int count_extents(const std::string &path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        struct fiemap fm = {};
+        fm.fm_length = FIEMAP_MAX_OFFSET;
+        fm.fm_flags = FIEMAP_FLAG_SYNC;
+        int ret = ioctl(fd, FS_IOC_FIEMAP, &fm);
+        close(fd);
+        return ret == 0 ? static_cast<int>(fm.fm_mapped_extents) : -1;
+    }
+};
+
+/**
+ * @brief 不同文件扩展粒度下，LOAD DATA导入order_line的耗时（包括关闭数据库时刷盘）
+ */
+TEST_F(LoadBench, LoadOrderLine) {
+    std::vector<ColDef> col_defs = {
+        {"ol_o_id", TYPE_INT, sizeof(int)},         {"ol_d_id", TYPE_INT, sizeof(int)},
+        {"ol_w_id", TYPE_INT, sizeof(int)},         {"ol_number", TYPE_INT, sizeof(int)},
+        {"ol_i_id", TYPE_INT, sizeof(int)},         {"ol_supply_w_id", TYPE_INT, sizeof(int)},
+        {"ol_delivery_d", TYPE_DATETIME, sizeof(long long)}, {"ol_quantity", TYPE_INT, sizeof(int)},
+        {"ol_amount", TYPE_FLOAT, sizeof(double)},  {"ol_dist_info", TYPE_STRING, 24},
+    };
+    std::string csv_abs_path = std::string(get_current_dir_name()) + "/" + csv_path_;
+
+    printf("%-12s %12s %10s %12s %10s\n", "extent", "rows/s", "seconds", "file MB", "extents");
+    for (int extent_mb : {0, 1, 16, 64}) {
+        auto disk_manager = std::make_unique<DiskManager>();
+        disk_manager->set_extent_size(extent_mb << 20);
+        auto log_manager = std::make_unique<LogManager>(disk_manager.get());
+        auto bpm = std::make_unique<BufferPoolManager>(BENCH_POOL_SIZE, disk_manager.get(), log_manager.get());
+        auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), bpm.get());
+        auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), bpm.get());
+        auto sm_manager = std::make_unique<SmManager>(disk_manager.get(), bpm.get(), rm_manager.get(), ix_manager.get());
+        auto lock_manager = std::make_unique<LockManager>();
+        auto txn_manager = std::make_unique<TransactionManager>(lock_manager.get(), sm_manager.get());
+        auto ql_manager = std::make_unique<QlManager>(sm_manager.get(), txn_manager.get());
+
+        if (sm_manager->is_dir(BENCH_DB_NAME)) {
+            sm_manager->drop_db(BENCH_DB_NAME);
+        }
+        sm_manager->create_db(BENCH_DB_NAME);
+        sm_manager->open_db(BENCH_DB_NAME);
+        Transaction *txn = txn_manager->begin(nullptr, log_manager.get());
+        Context context(lock_manager.get(), log_manager.get(), txn);
+        sm_manager->create_table("order_line", col_defs, &context);
+
+        auto start = std::chrono::steady_clock::now();
+        auto plan = std::make_shared<LoadPlan>(T_LoadData, csv_abs_path, "order_line");
+        ql_manager->run_load_data(plan, &context);
+        size_t num_records = 0;
+        for (RmScan scan(sm_manager->fhs_.at("order_line").get()); !scan.is_end(); scan.next()) {
+            num_records++;
+        }
+        sm_manager->close_db();
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::string table_path = BENCH_DB_NAME + "/order_line";
+        printf("%-12s %12.0f %10.3f %12.1f %10d\n", (std::to_string(extent_mb) + "MB").c_str(), num_records / secs,
+               secs, disk_manager->get_file_size(table_path) / 1048576.0, count_extents(table_path));
+        EXPECT_EQ(num_records, 300u * SCALE);
+        sm_manager->drop_db(BENCH_DB_NAME);
+    }
+}
@@ -0,0 +1,108 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 页面大小的性能测试：宽记录表的插入、B+树索引的插入与点查、全表扫描
+ * PAGE_SIZE在编译期确定，不同页面大小的对比由shell/page_size_bench.sh分别编译运行本测试完成
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "index/ix.h"
+#include "record/rm.h"
+#include "storage/bench_fixture.h"
+
+constexpr int NUM_RECORDS = 100000;
+constexpr int RECORD_SIZE = 200;               // 宽记录，第一个int为主键
+constexpr int NUM_LOOKUPS = 100000;
+constexpr size_t BENCH_POOL_BYTES = 16 << 20;  // 缓冲池按字节数固定为16MB，帧数随页面大小变化
+
+class PageSizeBench : public BenchFixture {
+   public:
+    std::unique_ptr<BufferPoolManager> bpm_;
+    std::unique_ptr<RmManager> rm_manager_;
+    std::unique_ptr<IxManager> ix_manager_;
+
+    PageSizeBench() : BenchFixture("PageSizeBench_db") {}
+
+    void SetUp() override {
+        BenchFixture::SetUp();
+        bpm_ = std::make_unique<BufferPoolManager>(BENCH_POOL_BYTES / PAGE_SIZE, disk_manager_.get());
+        rm_manager_ = std::make_unique<RmManager>(disk_manager_.get(), bpm_.get());
+        ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), bpm_.get());
+    }
+};
+
+/**
+ * @brief 同一负载在当前PAGE_SIZE下的耗时与空间占用
+ */
+TEST_F(PageSizeBench, WideRowsWithIndex) {
+    const std::string table = "wide";
+    rm_manager_->create_file(table, RECORD_SIZE);
+    auto fh = rm_manager_->open_file(table);
+    std::vector<ColMeta> index_cols = {{table, "id", TYPE_INT, sizeof(int), 0, true}};
+    ix_manager_->create_index(table, index_cols);
+    auto ih = ix_manager_->open_index(table, index_cols);
+
+    // 1. 按随机顺序插入记录和索引项，索引会不断分裂
+    std::vector<int> keys(NUM_RECORDS);
+    for (int i = 0; i < NUM_RECORDS; i++) keys[i] = i;
+    std::mt19937 rng(0);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    char buf[RECORD_SIZE];
+    memset(buf, 'x', RECORD_SIZE);
+    auto start = std::chrono::steady_clock::now();
+    for (int key : keys) {
+        memcpy(buf, &key, sizeof(int));
+        Rid rid = fh->insert_record(buf, nullptr);
+        ih->insert_entry(buf, rid, nullptr);
+    }
+    double insert_secs = elapsed_seconds(start);
+
+    // 2. 随机点查
+    start = std::chrono::steady_clock::now();
+    long misses = 0;
+    std::vector<Rid> result;
+    for (int i = 0; i < NUM_LOOKUPS; i++) {
+        int key = rng() % NUM_RECORDS;
+        result.clear();
+        if (!ih->get_value(reinterpret_cast<char *>(&key), &result, nullptr)) misses++;
+    }
+    double lookup_secs = elapsed_seconds(start);
+
+    // 3. 全表扫描
+    start = std::chrono::steady_clock::now();
+    int num_scanned = 0;
+    for (RmScan scan(fh.get()); !scan.is_end(); scan.next()) {
+        num_scanned++;
+    }
+    double scan_secs = elapsed_seconds(start);
+
+    printf("%8s %10s %10s %10s %12s %12s %10s\n", "page", "recs/page", "tab pages", "idx pages", "insert/s",
+           "lookup/s", "scan ms");
+    printf("%7dK %10d %10d %10d %12.0f %12.0f %10.1f\n", PAGE_SIZE / 1024, fh->get_file_hdr().num_records_per_page,
+           fh->get_file_hdr().num_pages, disk_manager_->get_fd2pageno(ih->get_fd()), NUM_RECORDS / insert_secs,
+           NUM_LOOKUPS / lookup_secs, scan_secs * 1000);
+    EXPECT_EQ(0, misses);
+    EXPECT_EQ(NUM_RECORDS, num_scanned);
+
+    ix_manager_->close_index(ih.get());
+    rm_manager_->close_file(fh.get());
+}